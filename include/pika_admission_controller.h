@@ -0,0 +1,70 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#ifndef PIKA_ADMISSION_CONTROLLER_H_
+#define PIKA_ADMISSION_CONTROLLER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "pstd/include/noncopyable.h"
+
+/*
+ * Sheds client commands with -BUSY instead of queueing them when the command
+ * thread pools can not keep up, so that a worker thread never blocks on a
+ * full pool and the commands which are admitted keep a short queue wait.
+ *
+ * A pool is overloaded when even the shortest queue wait of its tasks in an
+ * interval of 100ms was above admission-queue-target-us. While it is, slow
+ * commands are rejected, and a connection which got more fast commands
+ * admitted in the interval than the connections do on average gets the
+ * rest rejected, so a few busy connections can not crowd out the others.
+ * Callers reject what does not fit in the queue of its pool as well, through
+ * a non-blocking enqueue. Admin commands and connections in a transaction are
+ * never rejected. A queue_target_us of 0 turns the controller off.
+ */
+class PikaAdmissionController : public pstd::noncopyable {
+ public:
+  enum Pool { kFastPool = 0, kSlowPool = 1, kPoolNum = 2 };
+
+  // the part of the state of a connection the controller uses, owned by the
+  // connection and only touched by the thread running its commands
+  struct ConnState {
+    uint64_t interval = 0;
+    uint64_t admitted_cmds = 0;
+  };
+
+  // a task waited queue_time_us in the queue of pool
+  void Observe(int pool, uint64_t queue_time_us, uint64_t queue_target_us);
+
+  // false if the cmd_num commands of the connection should get -BUSY
+  bool Admit(int pool, size_t cmd_num, uint64_t queue_target_us, ConnState* conn_state);
+  // counts cmd_num commands rejected for another reason, returns false
+  bool Reject(size_t cmd_num);
+
+  bool Overloaded(int pool) const { return pool < kPoolNum && pools_[pool].overloaded.load(); }
+  uint64_t RejectedCmds() const { return rejected_cmds_.load(); }
+
+ private:
+  static constexpr uint64_t kIntervalUs = 100000;
+
+  // judges the interval of pool and starts the next one once it is over
+  void MaybeNextInterval(int pool, uint64_t queue_target_us);
+
+  struct PoolState {
+    std::atomic<uint64_t> interval_start_us = 0;
+    std::atomic<uint64_t> min_queue_time_us = UINT64_MAX;
+    std::atomic<bool> overloaded = false;
+    std::atomic<uint64_t> interval = 0;
+    std::atomic<uint64_t> admitted_cmds = 0;
+    std::atomic<uint64_t> active_conns = 0;
+  };
+
+  PoolState pools_[kPoolNum];
+  std::atomic<uint64_t> rejected_cmds_ = 0;
+};
+
+#endif  // PIKA_ADMISSION_CONTROLLER_H_
@@ -12,10 +12,16 @@
 #include "pstd/include/pstd_mutex.h"
 #include "pstd/include/pstd_status.h"
 #include "pstd/include/noncopyable.h"
+#include "include/pika_binlog_tail.h"
+#include "include/pika_binlog_transverter.h"
 #include "include/pika_define.h"
 
 std::string NewFileName(const std::string& name, uint32_t current);
 
+// header is a physical record header of kHeaderSize bytes followed by
+// content of n bytes, false if the record has a checksum which does not match
+bool BinlogRecordChecksumMatch(const char* header, const char* content, size_t n);
+
 class Version final : public pstd::noncopyable {
  public:
   Version(const std::shared_ptr<pstd::RWFile>& save);
@@ -51,7 +57,12 @@ class Binlog : public pstd::noncopyable {
   void Lock() { mutex_.lock(); }
   void Unlock() { mutex_.unlock(); }
 
-  pstd::Status Put(const std::string& item);
+  // type tells the format of item, the content of the binlog record
+  pstd::Status Put(const std::string& item, BinlogType type = TypeFirst);
+  // Put an item replicated from the master with the type, time, term and
+  // logic id the master wrote it with: the binlog of a slave then matches
+  // the one of its master and can be served to slaves of its own
+  pstd::Status PutReplicated(const std::string& item, BinlogType type, const BinlogItem& attribute);
   pstd::Status IsOpened();
   pstd::Status GetProducerStatus(uint32_t* filenum, uint64_t* pro_offset, uint32_t* term = nullptr, uint64_t* logic_id = nullptr);
   /*
@@ -63,6 +74,9 @@ class Binlog : public pstd::noncopyable {
 
   std::string filename() { return filename_; }
 
+  // recently appended records, shared by the slaves of this binlog
+  std::shared_ptr<BinlogTail> tail() { return tail_; }
+
   // need to hold mutex_
   void SetTerm(uint32_t term) {
     std::lock_guard l(version_->rwlock_);
@@ -79,9 +93,13 @@ class Binlog : public pstd::noncopyable {
 
  private:
   pstd::Status Put(const char* item, int len);
+  // attribute is nullptr for a local write
+  pstd::Status PutItem(const std::string& item, BinlogType type, const BinlogItem* attribute);
   pstd::Status EmitPhysicalRecord(RecordType t, const char* ptr, size_t n, int* temp_pro_offset);
   static pstd::Status AppendPadding(pstd::WritableFile* file, uint64_t* len);
   void InitLogFile();
+  // cut the producer back to the end of the last intact record of profile
+  void RecoverProducer(const std::string& profile);
 
   /*
    * Produce
@@ -108,6 +126,8 @@ class Binlog : public pstd::noncopyable {
   std::string filename_;
 
   std::atomic<bool> binlog_io_error_;
+
+  std::shared_ptr<BinlogTail> tail_;
 };
 
 #endif
@@ -0,0 +1,54 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#ifndef PIKA_BINLOG_TAIL_H_
+#define PIKA_BINLOG_TAIL_H_
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+
+#include "include/pika_define.h"
+
+/*
+ * The most recent binlog records of a db, appended by Binlog::Put in binlog
+ * order and bounded by binlog-tail-cache-size bytes. Slaves whose sent offset
+ * is inside this window share these records instead of each one re-reading
+ * and decoding them from the binlog files.
+ */
+class BinlogTail {
+ public:
+  struct Item {
+    // producer offset before the record, the sent offset of a slave that
+    // needs this record next
+    BinlogOffset prev_offset;
+    // producer offset after the record, the same as PikaBinlogReader::Get
+    LogOffset offset;
+    std::shared_ptr<const std::string> binlog;
+  };
+
+  // Need to hold the lock of the binlog, so that records come in order
+  void Append(const BinlogOffset& prev_offset, const LogOffset& offset, std::shared_ptr<const std::string> binlog,
+              uint64_t capacity);
+  // the record following prev_offset, false if it is not in the window
+  bool Get(const BinlogOffset& prev_offset, Item* item);
+  void Clear();
+
+  uint64_t ItemsNum();
+  uint64_t Bytes();
+  uint64_t Hits() { return hits_; }
+  uint64_t Misses() { return misses_; }
+
+ private:
+  std::shared_mutex rwlock_;
+  std::deque<Item> items_;
+  uint64_t bytes_ = 0;
+  std::atomic_uint64_t hits_ = 0;
+  std::atomic_uint64_t misses_ = 0;
+};
+
+#endif  // PIKA_BINLOG_TAIL_H_
@@ -9,6 +9,7 @@
 #include <glog/logging.h>
 #include <cstdint>
 #include <iostream>
+#include <string>
 #include <vector>
 
 /******************* Type First Binlog Item Format ******************
@@ -22,8 +23,21 @@
  */
 #define BINLOG_ENCODE_LEN 34
 
+/******************* Type Compact Binlog Content Format ******************
+ * Same item header as Type First, the content holds the arguments of the
+ * command instead of its redis protocol
+ * +-----------------------------------------------------------------+
+ * | Version (1 byte) | Argc (varint32)                              |
+ * |-----------------------------------------------------------------|
+ * | Arg Length (varint32) | Arg (arg length bytes) | ... argc times |
+ * +-----------------------------------------------------------------+
+ * argv[0] is the command name
+ */
+#define BINLOG_COMPACT_VERSION 1
+
 enum BinlogType {
   TypeFirst = 1,
+  TypeCompact = 2,
 };
 
 const int BINLOG_ITEM_HEADER_SIZE = 34;
@@ -41,6 +55,7 @@ class BinlogItem {
   uint64_t logic_id() const;
   uint32_t filenum() const;
   uint64_t offset() const;
+  BinlogType type() const;
   std::string content() const;
   std::string ToString() const;
 
@@ -56,6 +71,7 @@ class BinlogItem {
   uint64_t logic_id_ = 0;
   uint32_t filenum_ = 0;
   uint64_t offset_ = 0;
+  BinlogType type_ = TypeFirst;
   std::string content_;
   std::vector<std::string> extends_;
 };
@@ -71,7 +87,14 @@ class PikaBinlogTransverter {
 
   static std::string ConstructPaddingBinlog(BinlogType type, uint32_t size);
 
+  // type is the expected type of the item, TypeFirst and TypeCompact items are
+  // both accepted for one another, binlog_item->type() tells which it was
   static bool BinlogItemWithoutContentDecode(BinlogType type, const std::string& binlog, BinlogItem* binlog_item);
+
+  // content of a TypeCompact item from the redis protocol of a command,
+  // false if redis_protocol is not a plain array of bulk strings
+  static bool RedisProtocolToCompactContent(const std::string& redis_protocol, std::string* content);
+  static bool CompactContentDecode(const char* content, size_t len, std::vector<std::string>* argv);
 };
 
 #endif
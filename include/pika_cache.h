@@ -8,6 +8,8 @@
 
 #include <atomic>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "include/pika_define.h"
@@ -19,6 +21,7 @@
 #include "storage/storage.h"
 
 class PikaCacheLoadThread;
+class PikaCacheInvalidateThread;
 class ZIncrbyCmd;
 class ZRangebyscoreCmd;
 class ZRevrangebyscoreCmd;
@@ -34,6 +37,17 @@ struct CacheInfo {
   int64_t misses = 0;
   uint64_t async_load_keys_num = 0;
   uint32_t waitting_load_keys_num = 0;
+  uint64_t invalidate_pending_keys_num = 0;
+  uint64_t invalidated_keys_num = 0;
+  uint64_t negative_keys_num = 0;
+  int64_t negative_hits = 0;
+  int64_t negative_misses = 0;
+  // estimated usage, indexed like PIKA_CACHE_TYPES and by shard
+  std::vector<uint64_t> type_keys_num;
+  std::vector<uint64_t> type_used_memory;
+  std::vector<uint64_t> type_rejected_keys_num;
+  std::vector<uint64_t> shard_keys_num;
+  std::vector<uint64_t> shard_used_memory;
   void clear() {
     status = PIKA_CACHE_STATUS_NONE;
     cache_num = 0;
@@ -43,9 +57,29 @@ struct CacheInfo {
     misses = 0;
     async_load_keys_num = 0;
     waitting_load_keys_num = 0;
+    invalidate_pending_keys_num = 0;
+    invalidated_keys_num = 0;
+    negative_keys_num = 0;
+    negative_hits = 0;
+    negative_misses = 0;
+    type_keys_num.clear();
+    type_used_memory.clear();
+    type_rejected_keys_num.clear();
+    shard_keys_num.clear();
+    shard_used_memory.clear();
   }
 };
 
+// estimated memory used by each data type in one cache shard: a key is
+// charged what was loaded for it, even by an NX write which turned out a
+// no-op, growth through DoUpdateCache is not followed, and evictions scale
+// the estimate down in proportion to the keys the shard lost
+struct CacheTypeUsage {
+  uint64_t keys_num[PIKA_CACHE_TYPE_NUM] = {0};
+  uint64_t used_memory[PIKA_CACHE_TYPE_NUM] = {0};
+  uint64_t rejected_keys_num[PIKA_CACHE_TYPE_NUM] = {0};
+};
+
 class PikaCache : public pstd::noncopyable, public std::enable_shared_from_this<PikaCache> {
  public:
   PikaCache(int zset_cache_start_direction, int zset_cache_field_num_per_key);
@@ -86,6 +120,8 @@ class PikaCache : public pstd::noncopyable, public std::enable_shared_from_this<
   rocksdb::Status Incrxx(std::string& key);
   rocksdb::Status Decrxx(std::string& key);
   rocksdb::Status IncrByxx(std::string& key, uint64_t incr);
+  // increment a cached counter and return its new value, used by write-behind
+  rocksdb::Status IncrByxx(std::string& key, int64_t incr, int64_t* new_value);
   rocksdb::Status DecrByxx(std::string& key, uint64_t incr);
   rocksdb::Status Incrbyfloatxx(std::string& key, long double incr);
   rocksdb::Status Appendxx(std::string& key, std::string& value);
@@ -104,11 +140,12 @@ class PikaCache : public pstd::noncopyable, public std::enable_shared_from_this<
   rocksdb::Status HMSetxx(std::string& key, std::vector<storage::FieldValue>& fvs);
   rocksdb::Status HGet(std::string& key, std::string& field, std::string* value);
   rocksdb::Status HMGet(std::string& key, std::vector<std::string>& fields, std::vector<storage::ValueStatus>* vss);
-  rocksdb::Status HGetall(std::string& key, std::vector<storage::FieldValue>* fvs);
+  rocksdb::Status HGetallResp(std::string& key, std::string* resp);
   rocksdb::Status HKeys(std::string& key, std::vector<std::string>* fields);
   rocksdb::Status HVals(std::string& key, std::vector<std::string>* values);
   rocksdb::Status HExists(std::string& key, std::string& field);
   rocksdb::Status HIncrbyxx(std::string& key, std::string& field, int64_t value);
+  rocksdb::Status HIncrbyxx(std::string& key, std::string& field, int64_t value, int64_t* new_value);
   rocksdb::Status HIncrbyfloatxx(std::string& key, std::string& field, long double value);
   rocksdb::Status HLen(std::string& key, uint64_t* len);
   rocksdb::Status HStrlen(std::string& key, std::string& field, uint64_t* len);
@@ -137,7 +174,7 @@ class PikaCache : public pstd::noncopyable, public std::enable_shared_from_this<
   rocksdb::Status SAddnxWithoutTTL(std::string& key, std::vector<std::string>& members);
   rocksdb::Status SCard(std::string& key, uint64_t* len);
   rocksdb::Status SIsmember(std::string& key, std::string& member);
-  rocksdb::Status SMembers(std::string& key, std::vector<std::string>* members);
+  rocksdb::Status SMembersResp(std::string& key, std::string* resp);
   rocksdb::Status SRem(std::string& key, std::vector<std::string>& members);
   rocksdb::Status SRandmember(std::string& key, int64_t count, std::vector<std::string>* members);
 
@@ -150,8 +187,8 @@ class PikaCache : public pstd::noncopyable, public std::enable_shared_from_this<
   rocksdb::Status ZCount(std::string& key, std::string& min, std::string& max, uint64_t* len, ZCountCmd* cmd);
   rocksdb::Status ZIncrby(std::string& key, std::string& member, double increment);
   rocksdb::Status ZIncrbyIfKeyExist(std::string& key, std::string& member, double increment, ZIncrbyCmd* cmd, const std::shared_ptr<DB>& db);
-  rocksdb::Status ZRange(std::string& key, int64_t start, int64_t stop, std::vector<storage::ScoreMember>* score_members,
-                         const std::shared_ptr<DB>& db);
+  rocksdb::Status ZRangeResp(std::string& key, int64_t start, int64_t stop, bool with_scores, std::string* resp,
+                             const std::shared_ptr<DB>& db);
   rocksdb::Status ZRangebyscore(std::string& key, std::string& min, std::string& max,
                                 std::vector<storage::ScoreMember>* score_members, ZRangebyscoreCmd* cmd);
   rocksdb::Status ZRank(std::string& key, std::string& member, int64_t* rank, const std::shared_ptr<DB>& db);
@@ -159,8 +196,8 @@ class PikaCache : public pstd::noncopyable, public std::enable_shared_from_this<
   rocksdb::Status ZRemrangebyrank(std::string& key, std::string& min, std::string& max, int32_t ele_deleted = 0,
                                   const std::shared_ptr<DB>& db = nullptr);
   rocksdb::Status ZRemrangebyscore(std::string& key, std::string& min, std::string& max, const std::shared_ptr<DB>& db);
-  rocksdb::Status ZRevrange(std::string& key, int64_t start, int64_t stop, std::vector<storage::ScoreMember>* score_members,
-                            const std::shared_ptr<DB>& db);
+  rocksdb::Status ZRevrangeResp(std::string& key, int64_t start, int64_t stop, bool with_scores, std::string* resp,
+                                const std::shared_ptr<DB>& db);
   rocksdb::Status ZRevrangebyscore(std::string& key, std::string& min, std::string& max,
                                    std::vector<storage::ScoreMember>* score_members, ZRevrangebyscoreCmd* cmd,
                                    const std::shared_ptr<DB>& db);
@@ -196,15 +233,33 @@ class PikaCache : public pstd::noncopyable, public std::enable_shared_from_this<
   void PushKeyToAsyncLoadQueue(const char key_type, std::string& key, const std::shared_ptr<DB>& db);
   rocksdb::Status CacheZCard(std::string& key, uint64_t* len);
 
+  // Invalidation queue, used by slaves when slave-cache-invalidate is on
+  void PushKeysToInvalidateQueue(const std::vector<std::string>& keys);
+  void DrainInvalidateQueue(void);
+  uint64_t InvalidatePendingKeysNum(void) { return invalidate_pending_keys_num_; }
+
+  // Negative cache, remembers for a short time that keys do not exist in db
+  bool IsNegativeKeys(const std::vector<std::string>& keys);
+  void AddNegativeKeys(const std::vector<std::string>& keys, int64_t ttl_ms);
+  void DelNegativeKeys(const std::vector<std::string>& keys);
+  void ClearNegativeKeys(void);
+
  private:
 
   rocksdb::Status InitWithoutLock(uint32_t cache_num, cache::CacheConfig* cache_cfg);
   void DestroyWithoutLock(void);
+  void PurgeExpiredNegativeKeys(void);
   int CacheIndex(const std::string& key);
+  static int CacheTypeIndex(char key_type);
+  bool AdmitToCache(const std::string& key, char key_type, uint64_t bytes);
+  void ReconcileTypeUsage(void);
   RangeStatus CheckCacheRange(int32_t cache_len, int32_t db_len, int64_t start, int64_t stop, int64_t& out_start,
                               int64_t& out_stop);
   RangeStatus CheckCacheRevRange(int32_t cache_len, int32_t db_len, int64_t start, int64_t stop, int64_t& out_start,
                                  int64_t& out_stop);
+  // the range of the zset in the cache if it holds all of it, reversed for zrevrange
+  rocksdb::Status ZRangeRespInCache(std::string& key, int64_t start, int64_t stop, bool reverse, bool with_scores,
+                                    std::string* resp, const std::shared_ptr<DB>& db);
   RangeStatus CheckCacheRangeByScore(uint64_t  cache_len, double cache_min, double cache_max, double min,
                                      double max, bool left_close, bool right_close);
   bool CacheSizeEqsDB(std::string& key, const std::shared_ptr<DB>& db);
@@ -226,6 +281,23 @@ class PikaCache : public pstd::noncopyable, public std::enable_shared_from_this<
   std::unique_ptr<PikaCacheLoadThread> cache_load_thread_;
   std::vector<cache::RedisCache*> caches_;
   std::vector<std::shared_ptr<pstd::Mutex>> cache_mutexs_;
+  // guarded by cache_mutexs_[i]
+  std::vector<CacheTypeUsage> type_usages_;
+
+  // keys waiting to be removed from caches_[i], a set per shard so that
+  // repeated writes to a hot key coalesce into one delete
+  std::unique_ptr<PikaCacheInvalidateThread> cache_invalidate_thread_;
+  std::vector<std::unordered_set<std::string>> invalidate_queues_;
+  std::vector<std::shared_ptr<pstd::Mutex>> invalidate_mutexs_;
+  std::atomic_uint64_t invalidate_pending_keys_num_ = 0;
+  std::atomic_uint64_t invalidated_keys_num_ = 0;
+
+  // key -> expire time in us, sharded like caches_
+  std::vector<std::unordered_map<std::string, uint64_t>> negative_keys_;
+  std::vector<std::shared_ptr<pstd::Mutex>> negative_mutexs_;
+  std::atomic_uint64_t negative_keys_num_ = 0;
+  std::atomic_int64_t negative_hits_ = 0;
+  std::atomic_int64_t negative_misses_ = 0;
 };
 
 #endif
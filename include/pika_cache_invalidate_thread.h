@@ -0,0 +1,40 @@
+// Copyright (c) 2023-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+
+#ifndef PIKA_CACHE_INVALIDATE_THREAD_H_
+#define PIKA_CACHE_INVALIDATE_THREAD_H_
+
+#include <atomic>
+
+#include "include/pika_define.h"
+#include "net/include/net_thread.h"
+#include "pstd/include/pstd_mutex.h"
+
+class PikaCache;
+
+/*
+ * Drains the per-shard invalidation queues of a PikaCache in batches.
+ * Replicated writes on a slave only enqueue the touched keys, the cached
+ * values are dropped here and refilled lazily by the next read.
+ */
+class PikaCacheInvalidateThread : public net::Thread {
+ public:
+  explicit PikaCacheInvalidateThread(PikaCache* cache);
+  ~PikaCacheInvalidateThread() override;
+
+  void Wakeup();
+
+ private:
+  virtual void* ThreadMain() override;
+
+ private:
+  std::atomic_bool should_exit_;
+  pstd::CondVar invalidate_cond_;
+  pstd::Mutex invalidate_mutex_;
+  PikaCache* cache_;
+};
+
+#endif  // PIKA_CACHE_INVALIDATE_THREAD_H_
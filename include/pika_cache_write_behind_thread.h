@@ -0,0 +1,74 @@
+// Copyright (c) 2023-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+
+#ifndef PIKA_CACHE_WRITE_BEHIND_THREAD_H_
+#define PIKA_CACHE_WRITE_BEHIND_THREAD_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/pika_define.h"
+#include "net/include/net_thread.h"
+#include "pstd/include/pstd_mutex.h"
+
+class DB;
+
+/*
+ * Write-behind buffer of a db for counters living in the cache.
+ * INCR/INCRBY/HINCRBY on a cached key only update the cache and add their
+ * delta here, the deltas of a key are summed and written to the db (and
+ * binlog) as one command every cache-counter-write-behind-ms.
+ */
+class PikaCacheWriteBehindThread : public net::Thread {
+ public:
+  explicit PikaCacheWriteBehindThread(std::string db_name);
+  ~PikaCacheWriteBehindThread() override;
+
+  // the caller holds the record lock of key
+  void AddDelta(const std::string& key, int64_t delta);
+  void AddFieldDelta(const std::string& key, const std::string& field, int64_t delta);
+  // write the pending deltas of keys to db now, the caller holds their
+  // record locks and the shared lock of the db
+  void Flush(const std::vector<std::string>& keys);
+  // write every pending delta to db, takes the needed locks itself
+  void FlushAll();
+  // drop every pending delta, used when the data of the db is replaced
+  void Clear();
+
+  uint64_t PendingKeysNum() { return pending_keys_num_; }
+  uint64_t CoalescedIncrsNum() { return coalesced_incrs_num_; }
+  uint64_t FlushedKeysNum() { return flushed_keys_num_; }
+
+ private:
+  struct CounterDeltas {
+    bool has_delta = false;
+    int64_t delta = 0;
+    std::unordered_map<std::string, int64_t> field_deltas;
+  };
+
+  virtual void* ThreadMain() override;
+  int StripeIndex(const std::string& key);
+  bool TakeDeltas(const std::string& key, CounterDeltas* deltas);
+  void ApplyDeltas(const std::shared_ptr<DB>& db, const std::string& key, const CounterDeltas& deltas);
+  bool ApplyCommand(const std::string& name, const std::vector<std::string>& argv);
+
+ private:
+  std::string db_name_;
+  std::atomic_bool should_exit_;
+  pstd::CondVar write_behind_cond_;
+  pstd::Mutex write_behind_mutex_;
+
+  std::vector<std::unordered_map<std::string, CounterDeltas>> pending_deltas_;
+  std::vector<std::shared_ptr<pstd::Mutex>> pending_mutexs_;
+  std::atomic_uint64_t pending_keys_num_ = 0;
+  std::atomic_uint64_t coalesced_incrs_num_ = 0;
+  std::atomic_uint64_t flushed_keys_num_ = 0;
+};
+
+#endif  // PIKA_CACHE_WRITE_BEHIND_THREAD_H_
@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "acl.h"
+#include "include/pika_admission_controller.h"
 #include "include/pika_command.h"
 #include "include/pika_define.h"
 
@@ -50,6 +51,11 @@ class PikaClientConn : public net::RedisConn {
     LogOffset offset;
     std::string db_name;
     bool cache_miss_in_rtc_;
+    // a split pipeline runs redis_cmds[segment_begin, segment_end) in this task
+    size_t segment_begin = 0;
+    size_t segment_end = 0;
+    // PikaAdmissionController::Pool the task was scheduled to, kPoolNum for admin
+    int cmd_pool = PikaAdmissionController::kPoolNum;
   };
 
   struct TxnStateBitMask {
@@ -78,6 +84,8 @@ class PikaClientConn : public net::RedisConn {
   void SetCurrentDb(const std::string& db_name) { current_db_ = db_name; }
   void SetWriteCompleteCallback(WriteCompleteCallback cb) { write_completed_cb_ = std::move(cb); }
   const std::string& GetCurrentTable() override { return current_db_; }
+  // the limit of client-output-buffer-limit for the class of the conn
+  net::OutputBufferLimit output_buffer_limit() override;
 
   void DoAuth(const std::shared_ptr<User>& user);
 
@@ -127,6 +135,8 @@ class PikaClientConn : public net::RedisConn {
   bool authenticated_ = false;
   std::shared_ptr<User> user_;
 
+  PikaAdmissionController::ConnState admission_state_;
+
   std::shared_ptr<Cmd> DoCmd(const PikaCmdArgsType& argv, const std::string& opt,
                              const std::shared_ptr<std::string>& resp_ptr, bool cache_miss_in_rtc);
 
@@ -134,6 +144,11 @@ class PikaClientConn : public net::RedisConn {
   void ProcessMonitor(const PikaCmdArgsType& argv);
 
   void ExecRedisCmd(const PikaCmdArgsType& argv, std::shared_ptr<std::string>& resp_ptr, bool cache_miss_in_rtc);
+  void ExecPipelineSegment(std::unique_ptr<BgTaskArg> bg_arg);
+  void ReplyBusy(size_t cmd_num);
+  // end of the run of commands from begin which go to the same thread pool
+  static size_t PipelineSegmentEnd(const std::vector<net::RedisCmdArgsType>& argvs, size_t begin, bool* is_slow_cmd,
+                                   bool* is_admin_cmd);
   void TryWriteResp();
 };
 
@@ -19,6 +19,7 @@ class PikaClientProcessor {
   int Start();
   void Stop();
   void SchedulePool(net::TaskFunc func, void* arg);
+  bool TrySchedulePool(net::TaskFunc func, void* arg);
   size_t ThreadPoolCurQueueSize();
   size_t ThreadPoolMaxQueueSize();
 
@@ -290,7 +290,8 @@ enum CmdFlags {
   kCmdFlagsOperateKey = (1 << 19),  // redis keySpace
   kCmdFlagsStream = (1 << 20),
   kCmdFlagsFast = (1 << 21),
-  kCmdFlagsSlow = (1 << 22)
+  kCmdFlagsSlow = (1 << 22),
+  kCmdFlagsNegativeCache = (1 << 23)  // absence of the keys can be cached
 };
 
 void inline RedisAppendContent(std::string& str, const std::string& value);
@@ -452,6 +453,8 @@ class CmdRes {
     AppendContent(value);
   }
   void AppendStringRaw(const std::string& value) { message_.append(value); }
+  // for callers that serialize RESP straight into the reply buffer
+  std::string* mutable_message() { return &message_; }
 
   void AppendStringVector(const std::vector<std::string>& strArray) {
     if (strArray.empty()) {
@@ -528,6 +531,11 @@ class Cmd : public std::enable_shared_from_this<Cmd> {
   virtual void DoThroughDB() {}
   virtual void DoUpdateCache() {}
   virtual void ReadCache() {}
+  // reply as if none of current_key() exists, used on a negative cache hit
+  virtual void ReplyKeyNotExist() {}
+  // serve a counter write from the cache only and leave the db write to the
+  // write-behind thread, return false to go through db as usual
+  virtual bool DoWriteBehind() { return false; }
   virtual Cmd* Clone() = 0;
   // used for execute multikey command into different slots
   virtual void Split(const HintKeys& hint_keys) = 0;
@@ -551,6 +559,7 @@ class Cmd : public std::enable_shared_from_this<Cmd> {
   bool IsNeedUpdateCache() const;
   bool IsNeedReadCache() const;
   bool IsNeedCacheDo() const;
+  bool IsNeedNegativeCache() const;
   bool HashtagIsConsistent(const std::string& lhs, const std::string& rhs) const;
   uint64_t GetDoDuration() const { return do_duration_; };
   std::shared_ptr<DB> GetDB() const { return db_; };
@@ -611,8 +620,12 @@ class Cmd : public std::enable_shared_from_this<Cmd> {
   uint32_t cmdId_ = 0;
   uint32_t aclCategory_ = 0;
   bool cache_missed_in_rtc_{false};
+  bool served_by_write_behind_{false};
 
  private:
+  // write the pending write-behind deltas of current_key() to db
+  void FlushWriteBehind();
+
   virtual void DoInitial() = 0;
   virtual void Clear(){};
 
@@ -6,6 +6,7 @@
 #ifndef PIKA_CONF_H_
 #define PIKA_CONF_H_
 
+#include <array>
 #include <atomic>
 #include <map>
 #include <set>
@@ -13,6 +14,7 @@
 
 #include "rocksdb/compression_type.h"
 
+#include "net/include/net_define.h"
 #include "pstd/include/base_conf.h"
 #include "pstd/include/pstd_mutex.h"
 #include "pstd/include/pstd_string.h"
@@ -58,6 +60,18 @@ class PikaConf : public pstd::BaseConf {
     std::shared_lock l(rwlock_);
     return thread_num_;
   }
+  bool reuse_port() {
+    std::shared_lock l(rwlock_);
+    return reuse_port_;
+  }
+  bool reuse_port_cpu_steering() {
+    std::shared_lock l(rwlock_);
+    return reuse_port_cpu_steering_;
+  }
+  std::string thread_placement() {
+    std::shared_lock l(rwlock_);
+    return thread_placement_;
+  }
   int thread_pool_size() {
     std::shared_lock l(rwlock_);
     return thread_pool_size_;
@@ -70,6 +84,10 @@ class PikaConf : public pstd::BaseConf {
     std::shared_lock l(rwlock_);
     return admin_thread_pool_size_;
   }
+  int pubsub_thread_num() {
+    std::shared_lock l(rwlock_);
+    return pubsub_thread_num_;
+  }
   int sync_thread_num() {
     std::shared_lock l(rwlock_);
     return sync_thread_num_;
@@ -233,6 +251,7 @@ class PikaConf : public pstd::BaseConf {
     std::shared_lock l(rwlock_);
     return slow_cmd_pool_;
   }
+  bool split_pipeline() { return split_pipeline_.load(std::memory_order_relaxed); }
   std::string server_id() {
     std::shared_lock l(rwlock_);
     return server_id_;
@@ -410,6 +429,7 @@ class PikaConf : public pstd::BaseConf {
   }
   bool slowlog_write_errorlog() { return slowlog_write_errorlog_.load(); }
   int slowlog_slower_than() { return slowlog_log_slower_than_.load(); }
+  int admission_queue_target_us() { return admission_queue_target_us_.load(std::memory_order_relaxed); }
   int slowlog_max_len() {
     std::shared_lock l(rwlock_);
     return slowlog_max_len_;
@@ -421,6 +441,28 @@ class PikaConf : public pstd::BaseConf {
   int cache_mode() { return cache_mode_; }
   int sync_window_size() { return sync_window_size_.load(); }
   int max_conn_rbuf_size() { return max_conn_rbuf_size_.load(); }
+  bool reply_direct_write() { return reply_direct_write_.load(); }
+  net::OutputBufferLimit client_output_buffer_limit(ClientOutputBufferClass client_class) {
+    std::shared_lock l(rwlock_);
+    return client_output_buffer_limits_[client_class];
+  }
+  std::string client_output_buffer_limit_string();
+  bool SetClientOutputBufferLimit(const std::string& value);
+  int64_t binlog_tail_cache_size() { return binlog_tail_cache_size_.load(); }
+  std::string binlog_format() {
+    std::shared_lock l(rwlock_);
+    return binlog_format_;
+  }
+  bool binlog_compact_format() { return binlog_compact_format_.load(); }
+  bool binlog_checksum() { return binlog_checksum_.load(); }
+  bool slave_serve_slaves() { return slave_serve_slaves_.load(); }
+  std::string replication_compression() {
+    std::shared_lock l(rwlock_);
+    return replication_compression_;
+  }
+  int replication_compression_level() { return replication_compression_level_.load(); }
+  int replication_apply_batch_cmds() { return replication_apply_batch_cmds_.load(); }
+  int64_t replication_apply_batch_bytes() { return replication_apply_batch_bytes_.load(); }
   int consensus_level() { return consensus_level_.load(); }
   int replication_num() { return replication_num_.load(); }
   int rate_limiter_mode() {
@@ -461,6 +503,25 @@ class PikaConf : public pstd::BaseConf {
   void SetCacheMaxmemorySamples(const int value) { cache_maxmemory_samples_ = value; }
   void SetCacheLFUDecayTime(const int value) { cache_lfu_decay_time_ = value; }
   void UnsetCacheDisableFlag() { tmp_cache_disable_flag_ = false; }
+  bool slave_cache_invalidate() { return slave_cache_invalidate_.load(); }
+  void SetSlaveCacheInvalidate(const bool value) {
+    TryPushDiffCommands("slave-cache-invalidate", value ? "yes" : "no");
+    slave_cache_invalidate_.store(value);
+  }
+  // percent of cache-maxmemory the data type at type_index of PIKA_CACHE_TYPES may use
+  int cache_type_maxmemory_percent(int type_index) { return cache_type_maxmemory_percent_[type_index].load(); }
+  std::string cache_type_maxmemory_percent_string();
+  bool SetCacheTypeMaxmemoryPercent(const std::string& value);
+  int64_t cache_counter_write_behind_ms() { return cache_counter_write_behind_ms_.load(); }
+  void SetCacheCounterWriteBehindMs(const int64_t value) {
+    TryPushDiffCommands("cache-counter-write-behind-ms", std::to_string(value));
+    cache_counter_write_behind_ms_.store(value);
+  }
+  int64_t cache_negative_ttl_ms() { return cache_negative_ttl_ms_.load(); }
+  void SetCacheNegativeTtlMs(const int64_t value) {
+    TryPushDiffCommands("cache-negative-ttl-ms", std::to_string(value));
+    cache_negative_ttl_ms_.store(value);
+  }
   bool enable_blob_files() { return enable_blob_files_; }
   int64_t min_blob_size() { return min_blob_size_; }
   int64_t blob_file_size() { return blob_file_size_; }
@@ -483,6 +544,8 @@ class PikaConf : public pstd::BaseConf {
   int64_t rsync_timeout_ms() {
       return rsync_timeout_ms_.load(std::memory_order::memory_order_relaxed);
   }
+  int max_rsync_window_num() { return max_rsync_window_num_.load(); }
+  bool dbsync_streaming() { return dbsync_streaming_.load(); }
 
   // Slow Commands configuration
   const std::string GetSlowCmd() {
@@ -518,6 +581,11 @@ class PikaConf : public pstd::BaseConf {
   std::vector<rocksdb::CompressionType> compression_per_level();
   std::string compression_all_levels() const { return compression_per_level_; };
   static rocksdb::CompressionType GetCompression(const std::string& value);
+  static bool ParseCacheTypeMaxmemoryPercent(const std::string& value, std::atomic_int* percents);
+  // value is a list of <class> <hard> <soft> <soft seconds>, the classes left
+  // out keep their limits
+  static bool ParseClientOutputBufferLimit(const std::string& value,
+                                           std::array<net::OutputBufferLimit, kOutputBufferClassNum>* limits);
 
   std::vector<std::string>& users() { return users_; };
   std::string acl_file() { return aclFile_; };
@@ -578,6 +646,10 @@ class PikaConf : public pstd::BaseConf {
     TryPushDiffCommands("slave-priority", std::to_string(value));
     slave_priority_ = value;
   }
+  void SetSlaveServeSlaves(const bool value) {
+    TryPushDiffCommands("slave-serve-slaves", value ? "yes" : "no");
+    slave_serve_slaves_.store(value);
+  }
   void SetWriteBinlog(const std::string& value) {
     std::lock_guard l(rwlock_);
     TryPushDiffCommands("write-binlog", value);
@@ -658,6 +730,11 @@ class PikaConf : public pstd::BaseConf {
     TryPushDiffCommands("slow-cmd-pool", value ? "yes" : "no");
     slow_cmd_pool_.store(value);
   }
+  void SetSplitPipeline(const bool value) {
+    std::lock_guard l(rwlock_);
+    TryPushDiffCommands("split-pipeline", value ? "yes" : "no");
+    split_pipeline_.store(value);
+  }
   void SetSlotMigrateThreadNum(const int value) {
     std::lock_guard l(rwlock_);
     TryPushDiffCommands("slotmigrate-thread-num", std::to_string(value));
@@ -693,6 +770,16 @@ class PikaConf : public pstd::BaseConf {
     TryPushDiffCommands("slowlog-write-errorlog", value ? "yes" : "no");
     slowlog_write_errorlog_.store(value);
   }
+  void SetThreadPlacement(const std::string& value) {
+    std::lock_guard l(rwlock_);
+    TryPushDiffCommands("thread-placement", value);
+    thread_placement_ = value;
+  }
+  void SetAdmissionQueueTargetUs(const int value) {
+    std::lock_guard l(rwlock_);
+    TryPushDiffCommands("admission-queue-target-us", std::to_string(value));
+    admission_queue_target_us_.store(value);
+  }
   void SetSlowlogSlowerThan(const int value) {
     std::lock_guard l(rwlock_);
     TryPushDiffCommands("slowlog-log-slower-than", std::to_string(value));
@@ -751,6 +838,41 @@ class PikaConf : public pstd::BaseConf {
     TryPushDiffCommands("max-conn-rbuf-size", std::to_string(value));
     max_conn_rbuf_size_.store(value);
   }
+  void SetReplyDirectWrite(const bool value) {
+    TryPushDiffCommands("reply-direct-write", value ? "yes" : "no");
+    reply_direct_write_.store(value);
+  }
+  void SetBinlogTailCacheSize(const int64_t& value) {
+    TryPushDiffCommands("binlog-tail-cache-size", std::to_string(value));
+    binlog_tail_cache_size_.store(value);
+  }
+  void SetBinlogFormat(const std::string& value) {
+    std::lock_guard l(rwlock_);
+    TryPushDiffCommands("binlog-format", value);
+    binlog_format_ = value;
+    binlog_compact_format_.store(value == "compact");
+  }
+  void SetBinlogChecksum(const bool value) {
+    TryPushDiffCommands("binlog-checksum", value ? "yes" : "no");
+    binlog_checksum_.store(value);
+  }
+  void SetReplicationCompression(const std::string& value) {
+    std::lock_guard l(rwlock_);
+    TryPushDiffCommands("replication-compression", value);
+    replication_compression_ = value;
+  }
+  void SetReplicationCompressionLevel(const int& value) {
+    TryPushDiffCommands("replication-compression-level", std::to_string(value));
+    replication_compression_level_.store(value);
+  }
+  void SetReplicationApplyBatchCmds(const int& value) {
+    TryPushDiffCommands("replication-apply-batch-cmds", std::to_string(value));
+    replication_apply_batch_cmds_.store(value);
+  }
+  void SetReplicationApplyBatchBytes(const int64_t& value) {
+    TryPushDiffCommands("replication-apply-batch-bytes", std::to_string(value));
+    replication_apply_batch_bytes_.store(value);
+  }
   void SetMaxCacheFiles(const int& value) {
     std::lock_guard l(rwlock_);
     TryPushDiffCommands("max-cache-files", std::to_string(value));
@@ -852,6 +974,18 @@ class PikaConf : public pstd::BaseConf {
     max_rsync_parallel_num_ = value;
   }
 
+  void SetMaxRsyncWindowNum(const int value) {
+    std::lock_guard l(rwlock_);
+    TryPushDiffCommands("max-rsync-window-num", std::to_string(value));
+    max_rsync_window_num_.store(value);
+  }
+
+  void SetDBSyncStreaming(const bool value) {
+    std::lock_guard l(rwlock_);
+    TryPushDiffCommands("dbsync-streaming", value ? "yes" : "no");
+    dbsync_streaming_.store(value);
+  }
+
   void SetRsyncTimeoutMs(int64_t value){
     std::lock_guard l(rwlock_);
     TryPushDiffCommands("rsync-timeout-ms", std::to_string(value));
@@ -948,9 +1082,13 @@ class PikaConf : public pstd::BaseConf {
   int port_ = 0;
   int slave_priority_ = 100;
   int thread_num_ = 0;
+  bool reuse_port_ = false;
+  bool reuse_port_cpu_steering_ = false;
+  std::string thread_placement_;
   int thread_pool_size_ = 0;
   int slow_cmd_thread_pool_size_ = 0;
   int admin_thread_pool_size_ = 0;
+  int pubsub_thread_num_ = 1;
   std::unordered_set<std::string> slow_cmd_set_;
   std::unordered_set<std::string> admin_cmd_set_ = {"info", "ping", "monitor"};
   int sync_thread_num_ = 0;
@@ -1014,6 +1152,7 @@ class PikaConf : public pstd::BaseConf {
   std::string bgsave_prefix_;
   std::string pidfile_;
   std::atomic<bool> slow_cmd_pool_;
+  std::atomic<bool> split_pipeline_ = true;
 
   std::string compression_;
   std::string compression_per_level_;
@@ -1021,6 +1160,7 @@ class PikaConf : public pstd::BaseConf {
   int root_connection_num_ = 0;
   std::atomic<bool> slowlog_write_errorlog_;
   std::atomic<int> slowlog_log_slower_than_;
+  std::atomic<int> admission_queue_target_us_ = 0;
   std::atomic<bool> slotmigrate_;
   std::atomic<int> binlog_writer_num_;
   int slowlog_max_len_ = 0;
@@ -1057,6 +1197,22 @@ class PikaConf : public pstd::BaseConf {
 
   std::atomic<int> sync_window_size_;
   std::atomic<int> max_conn_rbuf_size_;
+  std::atomic_bool reply_direct_write_ = false;
+  // the defaults of redis
+  std::array<net::OutputBufferLimit, kOutputBufferClassNum> client_output_buffer_limits_ = {{
+      {0, 0, 0},
+      {256 << 20, 64 << 20, 60},
+      {32 << 20, 8 << 20, 60},
+  }};
+  std::atomic<int64_t> binlog_tail_cache_size_;
+  std::string binlog_format_ = "resp";
+  std::atomic<bool> binlog_compact_format_ = false;
+  std::atomic_bool binlog_checksum_ = false;
+  std::atomic_bool slave_serve_slaves_ = false;
+  std::string replication_compression_;
+  std::atomic<int> replication_compression_level_;
+  std::atomic<int> replication_apply_batch_cmds_;
+  std::atomic<int64_t> replication_apply_batch_bytes_;
   std::atomic<int> consensus_level_;
   std::atomic<int> replication_num_;
 
@@ -1100,6 +1256,10 @@ class PikaConf : public pstd::BaseConf {
   std::atomic_int cache_maxmemory_policy_ = 1;
   std::atomic_int cache_maxmemory_samples_ = 5;
   std::atomic_int cache_lfu_decay_time_ = 1;
+  std::atomic_bool slave_cache_invalidate_ = false;
+  std::atomic_int64_t cache_negative_ttl_ms_ = 0;
+  std::atomic_int64_t cache_counter_write_behind_ms_ = 0;
+  std::atomic_int cache_type_maxmemory_percent_[PIKA_CACHE_TYPE_NUM] = {100, 100, 100, 100, 100};
   std::atomic<bool> log_net_activities_ = false;
 
 
@@ -1120,6 +1280,8 @@ class PikaConf : public pstd::BaseConf {
   int throttle_bytes_per_second_ = 200 << 20; // 200MB/s
   int max_rsync_parallel_num_ = kMaxRsyncParallelNum;
   std::atomic_int64_t rsync_timeout_ms_ = 1000;
+  std::atomic_int max_rsync_window_num_ = kDefaultRsyncWindowNum;
+  std::atomic_bool dbsync_streaming_ = false;
 
   //Internal used metrics Persisted by pika.conf
   std::unordered_set<std::string> internal_used_unfinished_full_sync_;
@@ -168,7 +168,9 @@ class ConsensusCoordinator {
   pstd::Status TruncateTo(const LogOffset& offset);
 
   pstd::Status InternalAppendLog(const std::shared_ptr<Cmd>& cmd_ptr);
-  pstd::Status InternalAppendBinlog(const std::shared_ptr<Cmd>& cmd_ptr);
+  // a log of the leader is written as the leader wrote it, see Binlog::PutReplicated
+  pstd::Status InternalAppendLeaderLog(const std::shared_ptr<Cmd>& cmd_ptr, const BinlogItem& attribute);
+  pstd::Status InternalAppendBinlog(const std::shared_ptr<Cmd>& cmd_ptr, const BinlogItem* attribute = nullptr);
   void InternalApply(const MemLog::LogItem& log);
   void InternalApplyFollower(const std::shared_ptr<Cmd>& cmd_ptr);
 
@@ -12,6 +12,7 @@
 #include "include/pika_command.h"
 #include "lock_mgr.h"
 #include "pika_cache.h"
+#include "pika_cache_write_behind_thread.h"
 #include "pika_define.h"
 #include "storage/backupable.h"
 
@@ -38,11 +39,14 @@ struct BgSaveInfo {
   std::string s_start_time;
   std::string path;
   LogOffset offset;
+  // the sst files are read from the db dir, see dbsync-streaming
+  bool streaming = false;
   BgSaveInfo() = default;
   void Clear() {
     bgsaving = false;
     path.clear();
     offset = LogOffset();
+    streaming = false;
   }
 };
 
@@ -61,6 +65,16 @@ struct DisplayCacheInfo {
   uint64_t last_time_us = 0;
   uint64_t last_load_keys_num = 0;
   uint32_t waitting_load_keys_num = 0;
+  uint64_t invalidate_pending_keys_num = 0;
+  uint64_t invalidated_keys_num = 0;
+  uint64_t negative_keys_num = 0;
+  uint64_t negative_hits = 0;
+  uint64_t negative_misses = 0;
+  std::vector<uint64_t> type_keys_num;
+  std::vector<uint64_t> type_used_memory;
+  std::vector<uint64_t> type_rejected_keys_num;
+  std::vector<uint64_t> shard_keys_num;
+  std::vector<uint64_t> shard_used_memory;
   DisplayCacheInfo& operator=(const DisplayCacheInfo &obj) {
     status = obj.status;
     cache_num = obj.cache_num;
@@ -76,6 +90,16 @@ struct DisplayCacheInfo {
     last_time_us = obj.last_time_us;
     last_load_keys_num = obj.last_load_keys_num;
     waitting_load_keys_num = obj.waitting_load_keys_num;
+    invalidate_pending_keys_num = obj.invalidate_pending_keys_num;
+    invalidated_keys_num = obj.invalidated_keys_num;
+    negative_keys_num = obj.negative_keys_num;
+    negative_hits = obj.negative_hits;
+    negative_misses = obj.negative_misses;
+    type_keys_num = obj.type_keys_num;
+    type_used_memory = obj.type_used_memory;
+    type_rejected_keys_num = obj.type_rejected_keys_num;
+    shard_keys_num = obj.shard_keys_num;
+    shard_used_memory = obj.shard_used_memory;
     return *this;
   }
 };
@@ -100,11 +124,17 @@ class DB : public std::enable_shared_from_this<DB>, public pstd::noncopyable {
   std::string GetDBName();
   std::shared_ptr<storage::Storage> storage() const;
   void GetBgSaveMetaData(std::vector<std::string>* fileNames, std::string* snapshot_uuid);
-  void BgSaveDB();
+  // for_sync is set for the bgsave serving a full sync, which may stream
+  void BgSaveDB(bool for_sync = false);
+  // path of a file listed by GetBgSaveMetaData
+  std::string BgSaveFilePath(const std::string& filename);
+  // drop a streaming bgsave no slave is full syncing from any more
+  void AutoReleaseStreamingBgSave();
   void SetBinlogIoError();
   void SetBinlogIoErrorrelieve();
   bool IsBinlogIoError();
   std::shared_ptr<PikaCache> cache() const;
+  PikaCacheWriteBehindThread* cache_write_behind() const { return cache_write_behind_.get(); }
   std::shared_mutex& GetDBLock() {
     return dbs_rw_;
   }
@@ -172,6 +202,7 @@ class DB : public std::enable_shared_from_this<DB>, public pstd::noncopyable {
   std::shared_ptr<pstd::lock::LockMgr> lock_mgr_;
   std::shared_ptr<storage::Storage> storage_;
   std::shared_ptr<PikaCache> cache_;
+  std::unique_ptr<PikaCacheWriteBehindThread> cache_write_behind_;
   /*
    * KeyScan use
    */
@@ -188,7 +219,8 @@ class DB : public std::enable_shared_from_this<DB>, public pstd::noncopyable {
    * BgSave use
    */
   static void DoBgSave(void* arg);
-  bool RunBgsaveEngine();
+  bool RunBgsaveEngine(bool streaming);
+  void ReleaseStreamingBgSaveWithoutLock();
 
   bool InitBgsaveEnv();
   bool InitBgsaveEngine();
@@ -197,10 +229,14 @@ class DB : public std::enable_shared_from_this<DB>, public pstd::noncopyable {
   BgSaveInfo bgsave_info_;
   pstd::Mutex bgsave_protector_;
   std::shared_ptr<storage::BackupEngine> bgsave_engine_;
+  // filename in the bgsave -> path of the sst file in the db dir
+  std::map<std::string, std::string> bgsave_stream_files_;
+  time_t bgsave_finish_time_ = 0;
 };
 
 struct BgTaskArg {
   std::shared_ptr<DB> db;
+  bool streaming = false;
 };
 
 #endif
@@ -7,6 +7,7 @@
 #define PIKA_DEFINE_H_
 
 #include <glog/logging.h>
+#include <memory>
 #include <set>
 #include <utility>
 
@@ -27,6 +28,10 @@
 #define PIKA_MAX_CONN_RBUF (1 << 28)     // 256MB
 #define PIKA_MAX_CONN_RBUF_LB (1 << 26)  // 64MB
 #define PIKA_MAX_CONN_RBUF_HB (1 << 29)  // 512MB
+#define PIKA_BINLOG_TAIL_CACHE_SIZE (1 << 26)  // 64MB
+#define PIKA_REPL_COMPRESS_MIN_SIZE 1024  // smaller binlog sync batches are sent as they are
+#define PIKA_REPL_APPLY_BATCH_CMDS 128
+#define PIKA_REPL_APPLY_BATCH_BYTES (1 << 22)  // 4MB
 #define PIKA_SERVER_ID_MAX 65535
 
 class PikaServer;
@@ -43,6 +48,9 @@ const std::string kDefaultRsyncAuth = "default";
 
 /* Rsync */
 const int kMaxRsyncParallelNum = 4;
+// outstanding kRsyncFile requests of one rsync worker
+const int kMaxRsyncWindowNum = 64;
+const int kDefaultRsyncWindowNum = 8;
 constexpr int kMaxRsyncInitReTryTimes = 64;
 
 struct DBStruct {
@@ -176,8 +184,12 @@ const std::string BinlogSyncStateMsg[] = {"NotSync", "ReadFromCache", "ReadFromF
 
 struct BinlogChip {
   LogOffset offset_;
-  std::string binlog_;
-  BinlogChip(const LogOffset& offset, std::string binlog) : offset_(offset), binlog_(std::move(binlog)) {}
+  // may be shared with the binlog tail and the other slaves
+  std::shared_ptr<const std::string> binlog_;
+  BinlogChip(const LogOffset& offset, std::string binlog)
+      : offset_(offset), binlog_(std::make_shared<const std::string>(std::move(binlog))) {}
+  BinlogChip(const LogOffset& offset, std::shared_ptr<const std::string> binlog)
+      : offset_(offset), binlog_(std::move(binlog)) {}
   BinlogChip(const BinlogChip& binlog_chip) {
     offset_ = binlog_chip.offset_;
     binlog_ = binlog_chip.binlog_;
@@ -302,6 +314,15 @@ const int PIKA_REPL_SHOULD_META_SYNC = 1;
 const int PIKA_REPL_META_SYNC_DONE = 2;
 const int PIKA_REPL_ERROR = 3;
 
+// the client classes of client-output-buffer-limit
+enum ClientOutputBufferClass {
+  kOutputBufferNormal = 0,
+  kOutputBufferReplica = 1,
+  kOutputBufferPubSub = 2,
+  kOutputBufferClassNum = 3,
+};
+const std::string ClientOutputBufferClassName[] = {"normal", "replica", "pubsub"};
+
 // role
 const int PIKA_ROLE_SINGLE = 0;
 const int PIKA_ROLE_SLAVE = 1;
@@ -327,9 +348,16 @@ enum RecordType {
   kLastType = 4,
   kEof = 5,
   kBadRecord = 6,
-  kOldRecord = 7
+  kOldRecord = 7,
+  kBadChecksum = 8
 };
 
+/*
+ * Set in the type byte of a physical record whose time bytes hold the masked
+ * crc32c of the type byte and the content instead
+ */
+static const uint8_t kRecordChecksumFlag = 0x80;
+
 /*
  * the block size that we read and write from write2file
  * the default size is 64KB
@@ -396,6 +424,14 @@ const char PIKA_KEY_TYPE_LIST = 'l';
 const char PIKA_KEY_TYPE_SET = 's';
 const char PIKA_KEY_TYPE_ZSET = 'z';
 
+/*
+ * cache data types, used for per type memory accounting
+ */
+const int PIKA_CACHE_TYPE_NUM = 5;
+const char PIKA_CACHE_TYPES[PIKA_CACHE_TYPE_NUM] = {PIKA_KEY_TYPE_KV, PIKA_KEY_TYPE_HASH, PIKA_KEY_TYPE_LIST,
+                                                    PIKA_KEY_TYPE_SET, PIKA_KEY_TYPE_ZSET};
+const char* const PIKA_CACHE_TYPE_NAMES[PIKA_CACHE_TYPE_NUM] = {"string", "hash", "list", "set", "zset"};
+
 /*
  * cache task type
  */
@@ -408,5 +444,13 @@ enum CacheBgTask {
 const int64_t CACHE_LOAD_QUEUE_MAX_SIZE = 2048;
 const int64_t CACHE_VALUE_ITEM_MAX_SIZE = 2048;
 const int64_t CACHE_LOAD_NUM_ONE_TIME = 256;
+const int64_t CACHE_INVALIDATE_NUM_ONE_TIME = 1024;
+const int64_t CACHE_INVALIDATE_INTERVAL_MS = 10;
+const size_t CACHE_NEGATIVE_MAX_KEYS_PER_SHARD = 65536;
+// rough per key and per element overhead of rediscache objects, used to estimate memory usage
+const uint64_t CACHE_KEY_OVERHEAD_BYTES = 64;
+const uint64_t CACHE_ITEM_OVERHEAD_BYTES = 16;
+const int CACHE_WRITE_BEHIND_STRIPE_NUM = 16;
+const int64_t CACHE_WRITE_BEHIND_IDLE_INTERVAL_MS = 100;
 
 #endif
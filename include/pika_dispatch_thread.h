@@ -21,6 +21,7 @@ class PikaDispatchThread {
   void ClientKillAll();
   void SetLogNetActivities(bool value);
   void SetQueueLimit(int queue_limit) { thread_rep_->SetQueueLimit(queue_limit); }
+  void EnableReusePort(bool cpu_steering) { thread_rep_->EnableReusePort(cpu_steering); }
 
   void UnAuthUserAndKillClient(const std::set<std::string> &users, const std::shared_ptr<User>& defaultUser);
   net::ServerThread* server_thread() { return thread_rep_; }
@@ -74,6 +74,7 @@ class HGetallCmd : public Cmd {
   }
   void Do() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void DoThroughDB() override;
   void DoUpdateCache() override;
   void Split(const HintKeys& hint_keys) override {};
@@ -143,6 +144,7 @@ class HIncrbyCmd : public Cmd {
   void Do() override;
   void DoThroughDB() override;
   void DoUpdateCache() override;
+  bool DoWriteBehind() override;
   void Split(const HintKeys& hint_keys) override {};
   void Merge() override {};
   Cmd* Clone() override { return new HIncrbyCmd(*this); }
@@ -210,6 +212,7 @@ class HLenCmd : public Cmd {
   }
   void Do() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void DoThroughDB() override;
   void DoUpdateCache() override;
   void Split(const HintKeys& hint_keys) override {};
@@ -63,6 +63,7 @@ class GetCmd : public Cmd {
   void DoThroughDB() override;
   void DoUpdateCache() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void Split(const HintKeys& hint_keys) override{};
   void Merge() override{};
   bool IsTooLargeKey(const int &max_sz) override { return key_.size() > static_cast<uint32_t>(max_sz); }
@@ -108,6 +109,7 @@ class IncrCmd : public Cmd {
   void Do() override;
   void DoThroughDB() override;
   void DoUpdateCache() override;
+  bool DoWriteBehind() override;
   void Split(const HintKeys& hint_keys) override{};
   void Merge() override{};
   Cmd* Clone() override { return new IncrCmd(*this); }
@@ -133,6 +135,7 @@ class IncrbyCmd : public Cmd {
   void Do() override;
   void DoThroughDB() override;
   void DoUpdateCache() override;
+  bool DoWriteBehind() override;
   void Split(const HintKeys& hint_keys) override{};
   void Merge() override{};
   Cmd* Clone() override { return new IncrbyCmd(*this); }
@@ -533,6 +536,7 @@ class StrlenCmd : public Cmd {
   }
   void Do() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void DoThroughDB() override;
   void DoUpdateCache() override;
   void Split(const HintKeys& hint_keys) override{};
@@ -553,6 +557,7 @@ class ExistsCmd : public Cmd {
       : Cmd(name, arity, flag, static_cast<uint32_t>(AclCategory::KEYSPACE)) {}
   void Do() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void DoThroughDB() override;
   std::vector<std::string> current_key() const override { return keys_; }
   void Split(const HintKeys& hint_keys) override;
@@ -74,6 +74,7 @@ class LLenCmd : public Cmd {
   }
   void Do() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void DoThroughDB() override;
   void DoUpdateCache() override;
   void Split(const HintKeys& hint_keys) override{};
@@ -0,0 +1,99 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#ifndef PIKA_REPL_APPLY_SCHEDULER_H_
+#define PIKA_REPL_APPLY_SCHEDULER_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "pstd/include/pstd_mutex.h"
+
+#include "include/pika_command.h"
+#include "include/pika_repl_bgworker.h"
+
+/*
+ * Applies the commands a slave receives on the write db workers. A command
+ * only waits for the earlier commands sharing a key with it, commands on
+ * disjoint keys run in parallel on any worker. A command without keys waits
+ * for every earlier command of its db and holds back every later one.
+ * At most window commands are in flight, Schedule blocks beyond that.
+ *
+ * When commands pile up (the slave is catching up), a worker takes several
+ * ready commands of a db at once and writes them to the db as one group,
+ * see replication-apply-batch-cmds and replication-apply-batch-bytes.
+ */
+class PikaReplApplyScheduler {
+ public:
+  PikaReplApplyScheduler(std::vector<std::unique_ptr<PikaReplBgWorker>>* workers, size_t window);
+
+  // called in binlog order, done is run after cmd_ptr was applied
+  void Schedule(const std::shared_ptr<Cmd>& cmd_ptr, const std::string& db_name, std::function<void()> done);
+
+  uint64_t InflightNum();
+  uint64_t ScheduledNum() { return scheduled_num_; }
+  // commands which had to wait for an earlier one
+  uint64_t ConflictNum() { return conflict_num_; }
+  uint64_t GroupsNum() { return groups_num_; }
+  uint64_t GroupedCmdsNum() { return grouped_cmds_num_; }
+
+ private:
+  struct ApplyTask {
+    std::shared_ptr<Cmd> cmd_ptr;
+    std::string db_name;
+    // keys prefixed by the db name
+    std::vector<std::string> keys;
+    uint64_t bytes = 0;
+    bool barrier = false;
+    // may share a db write with other commands
+    bool groupable = false;
+    int pending_deps = 0;
+    std::vector<std::shared_ptr<ApplyTask>> successors;
+    std::function<void()> done;
+  };
+  struct DBApplyState {
+    std::unordered_set<std::shared_ptr<ApplyTask>> inflight;
+    std::shared_ptr<ApplyTask> barrier;
+  };
+
+  static void DoApply(void* arg);
+  // mu_ is held, returns the number of jobs to schedule for the ready tasks
+  size_t AddReady(const std::vector<std::shared_ptr<ApplyTask>>& tasks);
+  void ScheduleJobs(size_t jobs);
+  void TakeGroup(std::vector<std::shared_ptr<ApplyTask>>* group);
+  void ApplyGroup(const std::vector<std::shared_ptr<ApplyTask>>& group);
+  void Finish(const std::shared_ptr<ApplyTask>& task);
+  static void AddDependency(const std::shared_ptr<ApplyTask>& pred, const std::shared_ptr<ApplyTask>& task);
+  static bool CanGroup(const std::shared_ptr<ApplyTask>& task);
+
+  std::vector<std::unique_ptr<PikaReplBgWorker>>* workers_;
+  size_t window_;
+  std::atomic<size_t> next_worker_ = 0;
+
+  pstd::Mutex mu_;
+  pstd::CondVar window_cv_;
+  size_t inflight_num_ = 0;
+  // tasks whose dependencies are done, in binlog order
+  std::deque<std::shared_ptr<ApplyTask>> ready_;
+  // DoApply jobs queued on the workers and not started yet, never more than
+  // ready_ holds so that the worker queues can not fill up
+  size_t pending_jobs_ = 0;
+  // key -> the last unfinished command touching it
+  std::unordered_map<std::string, std::shared_ptr<ApplyTask>> last_tasks_;
+  std::unordered_map<std::string, DBApplyState> db_states_;
+
+  std::atomic_uint64_t scheduled_num_ = 0;
+  std::atomic_uint64_t conflict_num_ = 0;
+  std::atomic_uint64_t groups_num_ = 0;
+  std::atomic_uint64_t grouped_cmds_num_ = 0;
+};
+
+#endif  // PIKA_REPL_APPLY_SCHEDULER_H_
@@ -33,8 +33,10 @@ class PikaReplBgWorker {
   void Schedule(net::TaskFunc func, void* arg);
   void Schedule(net::TaskFunc func, void* arg, std::function<void()>& call_back);
   static void HandleBGWorkerWriteBinlog(void* arg);
-  static void HandleBGWorkerWriteDB(void* arg);
-  static void WriteDBInSyncWay(const std::shared_ptr<Cmd>& c_ptr);
+  // in_group when the write goes to a storage::WriteGroup of the caller, which
+  // already holds the shared lock of the db and drops the negative cache
+  // entries of the keys once the group is committed
+  static void WriteDBInSyncWay(const std::shared_ptr<Cmd>& c_ptr, bool in_group = false);
   void SetThreadName(const std::string& thread_name) {
     bg_thread_.set_thread_name(thread_name);
   }
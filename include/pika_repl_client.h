@@ -17,8 +17,10 @@
 #include "include/pika_define.h"
 
 #include "include/pika_binlog_reader.h"
+#include "include/pika_repl_apply_scheduler.h"
 #include "include/pika_repl_bgworker.h"
 #include "include/pika_repl_client_thread.h"
+#include "include/pika_repl_compression.h"
 
 #include "net/include/thread_pool.h"
 #include "pika_inner_message.pb.h"
@@ -42,13 +44,6 @@ struct ReplClientWriteBinlogTaskArg {
       : res(_res), conn(_conn), res_private_data(_res_private_data), worker(_worker) {}
 };
 
-struct ReplClientWriteDBTaskArg {
-  const std::shared_ptr<Cmd> cmd_ptr;
-  explicit ReplClientWriteDBTaskArg(std::shared_ptr<Cmd> _cmd_ptr)
-      : cmd_ptr(std::move(_cmd_ptr)) {}
-  ~ReplClientWriteDBTaskArg() = default;
-};
-
 class PikaReplClient {
  public:
   PikaReplClient(int cron_interval, int keepalive_timeout);
@@ -94,20 +89,25 @@ class PikaReplClient {
     return async_write_db_task_counts_[db_index].load(std::memory_order_seq_cst);
   }
 
+  ReplCompressionStats* compression_stats() { return &compression_stats_; }
+  PikaReplApplyScheduler* apply_scheduler() { return apply_scheduler_.get(); }
+
  private:
   size_t GetBinlogWorkerIndexByDBName(const std::string &db_name);
-  size_t GetHashIndexByKey(const std::string& key);
   void UpdateNextAvail() { next_avail_ = (next_avail_ + 1) % static_cast<int32_t>(write_binlog_workers_.size()); }
 
   std::unique_ptr<PikaReplClientThread> client_thread_;
   int next_avail_ = 0;
-  std::hash<std::string> str_hash;
+  // binlog sync received compressed from the master
+  ReplCompressionStats compression_stats_;
 
   // async_write_db_task_counts_ is used when consuming binlog, which indicates the nums of async write-DB tasks that are
   // queued or being executing by WriteDBWorkers. If a flushdb-binlog need to apply DB, it must wait
   // util this count drop to zero. you can also check pika discussion #2807 to know more
   // it is only used in slaveNode when consuming binlog
   std::atomic<int32_t> async_write_db_task_counts_[MAX_DB_NUM];
+  // orders the write db tasks by their keys, declared before write_db_workers_ for the same reason as above
+  std::unique_ptr<PikaReplApplyScheduler> apply_scheduler_;
   // [NOTICE] write_db_workers_ must be declared after async_write_db_task_counts_ to ensure write_db_workers_ will be destroyed before async_write_db_task_counts_
   // when PikaReplClient is de-constructing, because some of the async task that exec by write_db_workers_ will manipulate async_write_db_task_counts_
   std::vector<std::unique_ptr<PikaReplBgWorker>> write_binlog_workers_;
@@ -0,0 +1,32 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#ifndef PIKA_REPL_COMPRESSION_H_
+#define PIKA_REPL_COMPRESSION_H_
+
+#include <atomic>
+#include <string>
+
+#include "pika_inner_message.pb.h"
+
+// Compression of the BinlogSync batches sent from master to slave, negotiated in MetaSync
+
+std::string ReplCompressionToString(InnerMessage::CompressionType type);
+bool StringToReplCompression(const std::string& value, InnerMessage::CompressionType* type);
+
+struct ReplCompressionStats {
+  std::atomic_uint64_t raw_bytes = 0;
+  std::atomic_uint64_t wire_bytes = 0;
+  std::atomic_uint64_t cpu_us = 0;
+};
+
+// Move the binlog_sync of response into a compressed BinlogSyncBatch, the
+// response is left untouched when it is small or does not compress
+void CompressBinlogSyncResp(InnerMessage::CompressionType type, int level, InnerMessage::InnerResponse* response,
+                            ReplCompressionStats* stats);
+// Restore the binlog_sync of a response compressed by CompressBinlogSyncResp
+bool UncompressBinlogSyncResp(InnerMessage::InnerResponse* response, size_t max_size, ReplCompressionStats* stats);
+
+#endif  // PIKA_REPL_COMPRESSION_H_
@@ -14,6 +14,7 @@
 
 #include "include/pika_command.h"
 #include "include/pika_repl_bgworker.h"
+#include "include/pika_repl_compression.h"
 #include "include/pika_repl_server_thread.h"
 
 struct ReplServerTaskArg {
@@ -38,14 +39,21 @@ class PikaReplServer {
   void BuildBinlogSyncResp(const std::vector<WriteTask>& tasks, InnerMessage::InnerResponse* resp);
   void Schedule(net::TaskFunc func, void* arg);
   void UpdateClientConnMap(const std::string& ip_port, int fd);
+  void UpdateClientCompression(const std::string& ip_port, InnerMessage::CompressionType type);
   void RemoveClientConn(int fd);
   void KillAllConns();
+  ReplCompressionStats* compression_stats() { return &compression_stats_; }
 
  private:
+  InnerMessage::CompressionType ClientCompression(const std::string& ip_port);
+
   std::unique_ptr<net::ThreadPool> server_tp_ = nullptr;
   std::unique_ptr<PikaReplServerThread> pika_repl_server_thread_ = nullptr;
   std::shared_mutex client_conn_rwlock_;
   std::map<std::string, int> client_conn_map_;
+  // negotiated in MetaSync, absent means no compression
+  std::map<std::string, InnerMessage::CompressionType> client_compression_;
+  ReplCompressionStats compression_stats_;
 };
 
 #endif
@@ -52,6 +52,7 @@ class SyncMasterDB : public SyncDB {
   pstd::Status SyncBinlogToWq(const std::string& ip, int port);
   pstd::Status GetSlaveSyncBinlogInfo(const std::string& ip, int port, BinlogOffset* sent_offset, BinlogOffset* acked_offset);
   pstd::Status GetSlaveState(const std::string& ip, int port, SlaveState* slave_state);
+  bool HasDbSyncSlave();
   pstd::Status SetLastRecvTime(const std::string& ip, int port, uint64_t time);
   pstd::Status GetSafetyPurgeBinlog(std::string* safety_purge);
   pstd::Status WakeUpSlaveBinlogSync();
@@ -188,6 +189,10 @@ class PikaReplicaManager {
   void ScheduleReplClientBGTaskByDBName(net::TaskFunc , void* arg, const std::string &db_name);
   void ReplServerRemoveClientConn(int fd);
   void ReplServerUpdateClientConnMap(const std::string& ip_port, int fd);
+  void ReplServerUpdateClientCompression(const std::string& ip_port, InnerMessage::CompressionType type);
+  ReplCompressionStats* ReplServerCompressionStats();
+  ReplCompressionStats* ReplClientCompressionStats();
+  PikaReplApplyScheduler* ReplClientApplyScheduler();
 
   std::shared_mutex& GetDBLock() { return dbs_rw_; }
 
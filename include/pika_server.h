@@ -29,6 +29,7 @@
 #include "storage/storage.h"
 
 #include "acl.h"
+#include "include/pika_admission_controller.h"
 #include "include/pika_auxiliary_thread.h"
 #include "include/pika_binlog.h"
 #include "include/pika_cache.h"
@@ -46,6 +47,7 @@
 #include "include/pika_rsync_service.h"
 #include "include/pika_slot_command.h"
 #include "include/pika_statistic.h"
+#include "include/pika_thread_placement.h"
 #include "include/pika_transaction.h"
 #include "include/rsync_server.h"
 
@@ -182,12 +184,16 @@ class PikaServer : public pstd::noncopyable {
    * PikaClientProcessor Process Task
    */
   void ScheduleClientPool(net::TaskFunc func, void* arg, bool is_slow_cmd, bool is_admin_cmd);
+  // false instead of waiting if the queue of the pool is full
+  bool TryScheduleClientPool(net::TaskFunc func, void* arg, bool is_slow_cmd, bool is_admin_cmd);
 
   // for info debug
   size_t ClientProcessorThreadPoolCurQueueSize();
   size_t ClientProcessorThreadPoolMaxQueueSize();
   size_t SlowCmdThreadPoolCurQueueSize();
   size_t SlowCmdThreadPoolMaxQueueSize();
+  PikaAdmissionController* admission_controller() { return &admission_controller_; }
+  PikaThreadPlacement* thread_placement() { return &thread_placement_; }
 
   /*
    * BGSave used
@@ -252,10 +258,13 @@ class PikaServer : public pstd::noncopyable {
   uint64_t accumulative_connections();
   long long ServerKeyspaceHits();
   long long ServerKeyspaceMisses();
+  uint64_t SplitPipelines();
+  uint64_t SplitPipelineSegments();
   void ResetStat();
   void incr_accumulative_connections();
   void incr_server_keyspace_hits();
   void incr_server_keyspace_misses();
+  void incr_split_pipelines(uint64_t segments);
   void ResetLastSecQuerynum();
   void UpdateQueryNumAndExecCountDB(const std::string& db_name, const std::string& command, bool is_write);
   std::unordered_map<std::string, uint64_t> ServerExecCountDB();
@@ -278,6 +287,8 @@ class PikaServer : public pstd::noncopyable {
   size_t NetOutputBytes();
   size_t NetReplInputBytes();
   size_t NetReplOutputBytes();
+  size_t OutputBufferLimitCloses();
+  size_t ClientReadPauses();
   float InstantaneousInputKbps();
   float InstantaneousOutputKbps();
   float InstantaneousInputReplKbps();
@@ -523,6 +534,7 @@ class PikaServer : public pstd::noncopyable {
   void AutoBinlogPurge();
   void AutoServerlogPurge();
   void AutoDeleteExpiredDump();
+  void AutoReleaseStreamingDump();
   void AutoUpdateNetworkMetric();
   void PrintThreadPoolQueueStatus();
   void StatDiskUsage();
@@ -561,6 +573,8 @@ class PikaServer : public pstd::noncopyable {
    */
   int worker_num_ = 0;
   std::unique_ptr<PikaClientProcessor> pika_client_processor_;
+  PikaAdmissionController admission_controller_;
+  PikaThreadPlacement thread_placement_;
   std::unique_ptr<net::ThreadPool> pika_slow_cmd_thread_pool_;
   std::unique_ptr<net::ThreadPool> pika_admin_cmd_thread_pool_;
   std::unique_ptr<PikaDispatchThread> pika_dispatch_thread_ = nullptr;
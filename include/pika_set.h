@@ -108,6 +108,7 @@ class SCardCmd : public Cmd {
   }
   void Do() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void DoUpdateCache() override;
   void DoThroughDB() override;
   void Split(const HintKeys& hint_keys) override{};
@@ -131,6 +132,7 @@ class SMembersCmd : public Cmd {
   }
   void Do() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void DoUpdateCache() override;
   void DoThroughDB() override;
   void Split(const HintKeys& hint_keys) override{};
@@ -39,6 +39,8 @@ struct ServerStatistic {
   std::unordered_map<std::string, std::atomic<uint64_t>> exec_count_db;
   std::atomic<long long> keyspace_hits;
   std::atomic<long long> keyspace_misses;
+  std::atomic<uint64_t> split_pipelines = 0;
+  std::atomic<uint64_t> split_pipeline_segments = 0;
   QpsStatistic qps;
 };
 
@@ -0,0 +1,80 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#ifndef PIKA_THREAD_PLACEMENT_H_
+#define PIKA_THREAD_PLACEMENT_H_
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "pstd/include/noncopyable.h"
+
+/*
+ * Pins the thread groups of pika to the cpus given by thread-placement, like
+ * "net-worker=0-3;client-pool=node0;rocksdb=8-15". A group is picked by the
+ * name of its threads:
+ *   net-worker   the dispatcher and the worker threads
+ *   client-pool  the fast command pool
+ *   slow-pool    the slow command pool
+ *   admin-pool   the admin command pool
+ *   repl-worker  the binlog and write db workers of the slave
+ *   rocksdb      the flush and compaction threads of rocksdb
+ *   cache-load   the cache load thread
+ * A thread net starts is pinned right away by PinThread. The threads of
+ * rocksdb are not started through net, Sweep pins them from the server cron.
+ * Threads of no group, and of groups left out, run on all the cpus.
+ */
+class PikaThreadPlacement : public pstd::noncopyable {
+ public:
+  struct GroupUsage {
+    std::string group;
+    int threads = 0;
+    // user and system time of the live threads of the group, in seconds
+    double used_cpu = 0;
+    // the cpus it is pinned to, "all" if not
+    std::string cpus;
+  };
+
+  PikaThreadPlacement();
+
+  // replaces the placement and re-pins all the threads to it, false with
+  // err saying what is wrong with spec if it can not be parsed
+  bool Reset(const std::string& spec, std::string* err);
+  // pins the threads of the process, the ones started since the last sweep
+  // being what it is for
+  void Sweep();
+  // pins a thread started by net, name is the one it got before truncation
+  void PinThread(pthread_t id, const std::string& name);
+
+  std::vector<GroupUsage> Usage();
+
+ private:
+  struct Placement {
+    cpu_set_t cpus;
+    std::string desc;
+  };
+
+  static bool Parse(const std::string& spec, std::map<std::string, Placement>* placement, std::string* err);
+  static bool ParseCpus(const std::string& desc, cpu_set_t* cpus);
+  // the group of a thread name, nullptr if it is in none
+  static const char* GroupOf(const std::string& name);
+
+  // false if the thread is in no group placed, mu_ is held by the caller
+  bool CpusOf(const std::string& name, cpu_set_t* cpus);
+  // reset_unplaced also gives all the cpus back to the threads of no group
+  void PinAll(bool reset_unplaced);
+
+  std::shared_mutex mu_;
+  std::map<std::string, Placement> placement_;
+  // the cpus the process was allowed to run on at the start
+  cpu_set_t all_cpus_;
+};
+
+#endif  // PIKA_THREAD_PLACEMENT_H_
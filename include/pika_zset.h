@@ -48,6 +48,7 @@ class ZCardCmd : public Cmd {
   }
   void Do() override;
   void ReadCache() override;
+  void ReplyKeyNotExist() override;
   void DoUpdateCache() override;
   void DoThroughDB() override;
   void Split(const HintKeys& hint_keys) override{};
@@ -9,8 +9,10 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <algorithm>
 #include <list>
 #include <atomic>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <condition_variable>
@@ -37,6 +39,7 @@ const size_t kInvalidOffset = 0xFFFFFFFF;
 
 namespace rsync {
 
+class RsyncWindow;
 class RsyncWriter;
 class Session;
 class WaitObject;
@@ -72,8 +75,10 @@ class RsyncClient : public net::Thread {
   void OnReceive(RsyncService::RsyncResponse* resp);
 private:
   bool ComparisonUpdate();
-  Status CopyRemoteFile(const std::string& filename, int index);
+  Status CopyRemoteFile(const std::string& filename, int index, RsyncWindow* window);
+  Status SendFileRequest(const std::string& filename, int index, size_t offset, size_t count);
   Status PullRemoteMeta(std::string* snapshot_uuid, std::set<std::string>* file_set);
+  void LinkLocalFiles();
   Status LoadLocalMeta(std::string* snapshot_uuid, std::map<std::string, std::string>* file_map);
   std::string GetLocalMetaFilePath();
   Status FlushMetaTable();
@@ -86,6 +91,8 @@ private:
   typedef std::unique_ptr<RsyncClientThread> NetThreadUPtr;
   std::map<std::string, std::string> meta_table_;
   std::set<std::string> file_set_;
+  // filename -> identity of the sst files of the remote dump
+  std::map<std::string, RsyncService::SstMeta> remote_sst_metas_;
   std::string snapshot_uuid_;
   std::string dir_;
   std::string db_name_;
@@ -108,11 +115,40 @@ private:
   int parallel_num_;
 };
 
+/*
+ * Number of kRsyncFile requests a worker keeps outstanding. A round is one
+ * window of responses: while a round is notably faster than the best one
+ * seen the window doubles, otherwise it is sized to the bandwidth delay
+ * product of the best throughput and the smallest chunk latency, plus one
+ * chunk for the time a response spends being written. Halved on timeout.
+ */
+class RsyncWindow {
+ public:
+  explicit RsyncWindow(size_t max_size) : max_size_(max_size) {}
+  size_t Size() const { return size_; }
+  void SetMaxSize(size_t max_size) {
+    max_size_ = max_size;
+    size_ = std::min(size_, max_size_);
+  }
+  void OnResponse(uint64_t latency_us, size_t bytes);
+  void OnTimeout();
+
+ private:
+  size_t max_size_;
+  size_t size_ = 1;
+  uint64_t min_latency_us_ = UINT64_MAX;
+  double best_bytes_per_us_ = 0;
+  uint64_t round_start_us_ = 0;
+  size_t round_resps_ = 0;
+  size_t round_bytes_ = 0;
+};
+
 class RsyncWriter {
  public:
   RsyncWriter(const std::string& filepath) {
     filepath_ = filepath;
-    fd_ = open(filepath.c_str(), O_RDWR | O_APPEND | O_CREAT, 0644);
+    // chunks arrive in any order, each is written at its own offset
+    fd_ = open(filepath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
   }
   ~RsyncWriter() {}
   Status Write(uint64_t offset, size_t n, const char* data) {
@@ -120,7 +156,7 @@ class RsyncWriter {
     size_t left = n;
     Status s;
     while (left != 0) {
-      ssize_t done = write(fd_, ptr, left);
+      ssize_t done = pwrite(fd_, ptr, left, static_cast<off_t>(offset));
       if (done < 0) {
         if (errno == EINTR) {
           continue;
@@ -150,47 +186,65 @@ class RsyncWriter {
 
 class WaitObject {
  public:
-  WaitObject() : filename_(""), type_(RsyncService::kRsyncMeta), offset_(0), resp_(nullptr) {}
+  WaitObject() : filename_(""), type_(RsyncService::kRsyncMeta) {}
   ~WaitObject() {}
 
   void Reset(const std::string& filename, RsyncService::Type t, size_t offset) {
     std::lock_guard<std::mutex> guard(mu_);
-    resp_.reset();
+    resps_.clear();
     filename_ = filename;
     type_ = t;
-    offset_ = offset;
+    offsets_.clear();
+    offsets_.insert(offset);
+  }
+
+  // one more outstanding kRsyncFile request of the file, the responses are
+  // taken in the order they arrive
+  void Expect(size_t offset) {
+    std::lock_guard<std::mutex> guard(mu_);
+    offsets_.insert(offset);
   }
 
   pstd::Status Wait(ResponseSPtr& resp) {
     auto timeout = g_pika_conf->rsync_timeout_ms();
     std::unique_lock<std::mutex> lock(mu_);
     auto cv_s = cond_.wait_for(lock, std::chrono::milliseconds(timeout), [this] {
-      return resp_.get() != nullptr;
+      return !resps_.empty();
     });
     if (!cv_s) {
       std::string timout_info("timeout during(in ms) is ");
       timout_info.append(std::to_string(timeout));
       return pstd::Status::Timeout("rsync timeout", timout_info);
     }
-    resp = resp_;
+    resp = resps_.front();
+    resps_.pop_front();
     return pstd::Status::OK();
   }
 
-  void WakeUp(RsyncService::RsyncResponse* resp) {
+  // takes the ownership of resp if it answers an outstanding request
+  bool WakeUp(RsyncService::RsyncResponse* resp) {
     std::unique_lock<std::mutex> lock(mu_);
-    resp_.reset(resp);
-    offset_ = kInvalidOffset;
+    if (resp->type() != type_) {
+      return false;
+    }
+    if (resp->code() == RsyncService::kOk && resp->type() == RsyncService::kRsyncFile) {
+      auto iter = offsets_.find(resp->file_resp().offset());
+      if (resp->file_resp().filename() != filename_ || iter == offsets_.end()) {
+        return false;
+      }
+      // a request sent again after a timeout is answered only once
+      offsets_.erase(iter);
+    }
+    resps_.emplace_back(resp);
     cond_.notify_all();
+    return true;
   }
 
-  std::string Filename() {return filename_;}
-  RsyncService::Type Type() {return type_;}
-  size_t Offset() {return offset_;}
  private:
   std::string filename_;
   RsyncService::Type type_;
-  size_t offset_ = kInvalidOffset;
-  ResponseSPtr resp_ = nullptr;
+  std::set<size_t> offsets_;
+  std::deque<ResponseSPtr> resps_;
   std::condition_variable cond_;
   std::mutex mu_;
 };
@@ -220,23 +274,16 @@ class WaitObjectManager {
   void WakeUp(RsyncService::RsyncResponse* resp) {
     std::lock_guard<std::mutex> guard(mu_);
     int index = resp->reader_index();
-    if (wo_vec_[index] == nullptr || resp->type() != wo_vec_[index]->Type()) {
+    if (wo_vec_[index] == nullptr) {
       delete resp;
       return;
     }
     if (resp->code() != RsyncService::kOk) {
       LOG(WARNING) << "rsync response error";
-      wo_vec_[index]->WakeUp(resp);
-      return;
     }
-
-    if (resp->type() == RsyncService::kRsyncFile &&
-        ((resp->file_resp().filename() != wo_vec_[index]->Filename()) ||
-	 (resp->file_resp().offset() != wo_vec_[index]->Offset()))) {
+    if (!wo_vec_[index]->WakeUp(resp)) {
       delete resp;
-      return;
     }
-    wo_vec_[index]->WakeUp(resp);
   }
  private:
   std::vector<WaitObject*> wo_vec_;
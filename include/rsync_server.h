@@ -33,6 +33,17 @@ struct RsyncServerTaskArg {
 class RsyncReader;
 class RsyncServerThread;
 
+/*
+ * Content identity of an sst file, the slave reuses a local sst of the same
+ * name when it matches the one of the master. The size and the crc32c of the
+ * tail, which holds the table properties (db session id, original file number,
+ * creation time ...), the meta index and the footer, tell two ssts apart
+ * without reading them whole.
+ */
+const size_t kSstIdentityTailSize = 4096;
+pstd::Status SstIdentity(const std::string& filepath, uint64_t* size, uint32_t* checksum);
+bool IsSstFile(const std::string& filename);
+
 class RsyncServer {
  public:
   RsyncServer(const std::set<std::string>& ips, const int port);
@@ -104,12 +115,18 @@ class RsyncReader {
   }
   pstd::Status Read(const std::string filepath, const size_t offset,
                     const size_t count, char* data, size_t* bytes_read,
-                    std::string* checksum, bool* is_eof) {
+                    std::string* checksum, bool* is_eof, size_t* file_size) {
     std::lock_guard<std::mutex> guard(mu_);
     pstd::Status s = readAhead(filepath, offset);
     if (!s.ok()) {
       return s;
     }
+    *file_size = total_size_;
+    if (offset >= total_size_) {
+      *bytes_read = 0;
+      *is_eof = true;
+      return pstd::Status::OK();
+    }
     size_t offset_in_block = offset % kBlockSize;
     size_t copy_count = count > (end_offset_ - offset) ? end_offset_ - offset : count;
     memcpy(data, block_data_ + offset_in_block, copy_count);
@@ -135,6 +152,9 @@ private:
       stat(filepath.c_str(), &buf);
       total_size_ = buf.st_size;
     }
+    if (offset >= total_size_) {
+      return pstd::Status::OK();
+    }
     start_offset_ = (offset / kBlockSize) * kBlockSize;
 
     size_t read_offset = start_offset_;
@@ -64,7 +64,7 @@ public:
   Status Get(const std::string& key, std::string *value);
   Status Incr(std::string& key);
   Status Decr(std::string& key);
-  Status IncrBy(std::string& key, int64_t incr);
+  Status IncrBy(std::string& key, int64_t incr, int64_t *new_value = nullptr);
   Status DecrBy(std::string& key, int64_t incr);
   Status Incrbyfloat(std::string& key, double incr);
   Status Append(std::string& key, std::string &value);
@@ -82,10 +82,12 @@ public:
                std::vector<std::string> &fields,
                std::vector<storage::ValueStatus>* vss);
   Status HGetall(std::string& key, std::vector<storage::FieldValue> *fvs);
+  // append the whole hash to resp as a RESP array, without building FieldValue
+  Status HGetallResp(std::string& key, std::string *resp);
   Status HKeys(std::string& key, std::vector<std::string> *fields);
   Status HVals(std::string& key, std::vector<std::string> *values);
   Status HExists(std::string& key, std::string &field);
-  Status HIncrby(std::string& key, std::string &field, int64_t value);
+  Status HIncrby(std::string& key, std::string &field, int64_t value, int64_t *new_value = nullptr);
   Status HIncrbyfloat(std::string& key, std::string &field, double value);
   Status HLen(const std::string& key, uint64_t *len);
   Status HStrlen(std::string& key, std::string &field, uint64_t *len);
@@ -111,6 +113,8 @@ public:
   Status SCard(const std::string& key, uint64_t *len);
   Status SIsmember(std::string& key, std::string& member);
   Status SMembers(std::string& key, std::vector<std::string> *members);
+  // append all members to resp as a RESP array
+  Status SMembersResp(std::string& key, std::string *resp);
   Status SRem(std::string& key, std::vector<std::string> &members);
   Status SRandmember(std::string& key, int64_t count, std::vector<std::string> *members);
 
@@ -122,6 +126,11 @@ public:
   Status ZRange(std::string& key,
                 int64_t start, int64_t stop,
                 std::vector<storage::ScoreMember> *score_members);
+  // append the members in [start, stop], from the highest score if rev, to
+  // resp as a RESP array, without building ScoreMember
+  Status ZRangeResp(std::string& key,
+                    int64_t start, int64_t stop,
+                    bool rev, bool with_scores, std::string *resp);
   Status ZRangebyscore(std::string& key,
                        std::string &min, std::string &max,
                        std::vector<storage::ScoreMember> *score_members,
@@ -165,6 +174,8 @@ protected:
   void FreeHitemList(hitem *items, uint32_t size);
   void FreeZitemList(zitem *items, uint32_t size);
   void ConvertObjectToString(robj *obj, std::string *value);
+  void AppendRespLen(std::string *resp, char prefix, uint64_t len);
+  void AppendRespBulk(std::string *resp, sds str);
 
 private:
   RedisCache(const RedisCache&);
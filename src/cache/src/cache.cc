@@ -257,6 +257,21 @@ void RedisCache::FreeZitemList(zitem *items, uint32_t size) {
   zfree(items);
 }
 
+void RedisCache::AppendRespLen(std::string *resp, char prefix, uint64_t len) {
+  char buf[32];
+  buf[0] = prefix;
+  int n = pstd::ll2string(buf + 1, sizeof(buf) - 1, static_cast<long long>(len));
+  resp->append(buf, n + 1);
+  resp->append("\r\n", 2);
+}
+
+void RedisCache::AppendRespBulk(std::string *resp, sds str) {
+  size_t len = sdslen(str);
+  AppendRespLen(resp, '$', len);
+  resp->append(str, len);
+  resp->append("\r\n", 2);
+}
+
 void RedisCache::ConvertObjectToString(robj *obj, std::string *value) {
   if (sdsEncodedObject(obj)) {
     value->assign((char *)obj->ptr, sdslen((sds)obj->ptr));
@@ -174,6 +174,37 @@ Status RedisCache::HGetall(std::string& key, std::vector<storage::FieldValue> *f
   return Status::OK();
 }
 
+Status RedisCache::HGetallResp(std::string& key, std::string *resp) {
+  hitem *items = nullptr;
+  unsigned long items_size = 0;
+  robj *kobj = createObject(OBJ_STRING, sdsnewlen(key.data(), key.size()));
+  DEFER {
+    DecrObjectsRefCount(kobj);
+  };
+  int ret = RcHGetAll(cache_, kobj, &items, &items_size);
+  if (C_OK != ret) {
+    if (REDIS_KEY_NOT_EXIST == ret) {
+      return Status::NotFound("key not in cache");
+    }
+    return Status::Corruption("RcHGet failed");
+  }
+
+  // reserve once, each bulk string adds at most 16 bytes of "$<len>\r\n...\r\n" framing
+  size_t reserve_size = 16;
+  for (uint64_t i = 0; i < items_size; ++i) {
+    reserve_size += sdslen(items[i].field) + sdslen(items[i].value) + 32;
+  }
+  resp->reserve(resp->size() + reserve_size);
+  AppendRespLen(resp, '*', items_size * 2);
+  for (uint64_t i = 0; i < items_size; ++i) {
+    AppendRespBulk(resp, items[i].field);
+    AppendRespBulk(resp, items[i].value);
+  }
+
+  FreeHitemList(items, items_size);
+  return Status::OK();
+}
+
 Status RedisCache::HKeys(std::string& key, std::vector<std::string> *fields) {
   hitem *items = nullptr;
   unsigned long items_size = 0;
@@ -238,7 +269,7 @@ Status RedisCache::HExists(std::string& key, std::string &field) {
   return is_exist ? Status::OK() : Status::NotFound("field not exist");
 }
 
-Status RedisCache::HIncrby(std::string& key, std::string &field, int64_t value) {
+Status RedisCache::HIncrby(std::string& key, std::string &field, int64_t value, int64_t *new_value) {
   int64_t result = 0;
   robj *kobj = createObject(OBJ_STRING, sdsnewlen(key.data(), key.size()));
   robj *fobj = createObject(OBJ_STRING, sdsnewlen(field.data(), field.size()));
@@ -252,6 +283,9 @@ Status RedisCache::HIncrby(std::string& key, std::string &field, int64_t value)
     }
     return Status::Corruption("RcHGet failed");
   }
+  if (new_value) {
+    *new_value = result;
+  }
 
   return Status::OK();
 }
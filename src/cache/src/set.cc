@@ -88,6 +88,35 @@ Status RedisCache::SMembers(std::string& key, std::vector<std::string> *members)
   return Status::OK();
 }
 
+Status RedisCache::SMembersResp(std::string& key, std::string *resp) {
+  sds *vals = nullptr;
+  unsigned long vals_size = 0;
+  robj *kobj = createObject(OBJ_STRING, sdsnewlen(key.data(), key.size()));
+  DEFER {
+    DecrObjectsRefCount(kobj);
+  };
+  int ret = RcSMembers(cache_, kobj, &vals, &vals_size);
+  if (C_OK != ret) {
+    if (REDIS_KEY_NOT_EXIST == ret) {
+      return Status::NotFound("key not in cache");
+    }
+    return Status::Corruption("RcSMembers failed");
+  }
+
+  size_t reserve_size = 16;
+  for (unsigned long i = 0; i < vals_size; ++i) {
+    reserve_size += sdslen(vals[i]) + 16;
+  }
+  resp->reserve(resp->size() + reserve_size);
+  AppendRespLen(resp, '*', vals_size);
+  for (unsigned long i = 0; i < vals_size; ++i) {
+    AppendRespBulk(resp, vals[i]);
+  }
+
+  FreeSdsList(vals, vals_size);
+  return Status::OK();
+}
+
 Status RedisCache::SRem(std::string& key, std::vector<std::string> &members) {
   robj *kobj = createObject(OBJ_STRING, sdsnewlen(key.data(), key.size()));
   robj **vals = (robj **)zcallocate(sizeof(robj *) * members.size());
@@ -176,7 +176,7 @@ Status RedisCache::Decr(std::string& key) {
   return Status::OK();
 }
 
-Status RedisCache::IncrBy(std::string& key, int64_t incr) {
+Status RedisCache::IncrBy(std::string& key, int64_t incr, int64_t *new_value) {
   robj *kobj = createObject(OBJ_STRING, sdsnewlen(key.data(), key.size()));
   DEFER {
     DecrObjectsRefCount(kobj);
@@ -186,6 +186,9 @@ Status RedisCache::IncrBy(std::string& key, int64_t incr) {
   if (C_OK != res) {
     return Status::Corruption("RcIncrBy failed!");
   }
+  if (new_value) {
+    *new_value = ret;
+  }
 
   return Status::OK();
 }
@@ -4,6 +4,7 @@
 // of patent rights can be found in the PATENTS file in the same directory.
 
 #include "cache/include/cache.h"
+#include "pstd/include/pstd_string.h"
 #include "pstd_defer.h"
 
 namespace cache {
@@ -115,6 +116,45 @@ Status RedisCache::ZRange(std::string& key, int64_t start, int64_t stop, std::ve
   return Status::OK();
 }
 
+Status RedisCache::ZRangeResp(std::string& key, int64_t start, int64_t stop, bool rev, bool with_scores,
+                              std::string *resp) {
+  zitem *items = nullptr;
+  uint64_t items_size = 0;
+  robj *kobj = createObject(OBJ_STRING, sdsnewlen(key.data(), key.size()));
+  DEFER {
+    DecrObjectsRefCount(kobj);
+  };
+  int ret = rev ? RcZRevrange(cache_, kobj, start, stop, &items, reinterpret_cast<unsigned long *>(&items_size))
+                : RcZrange(cache_, kobj, start, stop, &items, reinterpret_cast<unsigned long *>(&items_size));
+  if (C_OK != ret) {
+    if (REDIS_KEY_NOT_EXIST == ret) {
+      return Status::NotFound("key not in cache");
+    }
+    return Status::Corruption(rev ? "RcZRevrange failed" : "RcZrange failed");
+  }
+
+  // a score takes at most 32 bytes with its framing
+  size_t reserve_size = 16;
+  for (uint64_t i = 0; i < items_size; ++i) {
+    reserve_size += sdslen(items[i].member) + (with_scores ? 48 : 16);
+  }
+  resp->reserve(resp->size() + reserve_size);
+  AppendRespLen(resp, '*', with_scores ? items_size * 2 : items_size);
+  char buf[32];
+  for (uint64_t i = 0; i < items_size; ++i) {
+    AppendRespBulk(resp, items[i].member);
+    if (with_scores) {
+      int len = pstd::d2string(buf, sizeof(buf), items[i].score);
+      AppendRespLen(resp, '$', len);
+      resp->append(buf, len);
+      resp->append("\r\n", 2);
+    }
+  }
+
+  FreeZitemList(items, items_size);
+  return Status::OK();
+}
+
 Status RedisCache::ZRangebyscore(std::string& key, std::string &min, std::string &max,
                                  std::vector<storage::ScoreMember> *score_members, int64_t offset, int64_t count) {
   zitem *items = nullptr;
@@ -0,0 +1,68 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#ifndef NET_INCLUDE_BUFFER_POOL_H_
+#define NET_INCLUDE_BUFFER_POOL_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "pstd/include/noncopyable.h"
+
+namespace net {
+
+/*
+ * Read buffers of the connections, in size classes of powers of two from
+ * kMinSize to kMaxPooledSize. A connection borrows one when it has something
+ * to read and gives it back once the input is parsed, so idle connections
+ * hold none. Buffers above kMaxPooledSize, and buffers which would take the
+ * pool beyond its limit, are freed when given back.
+ */
+class BufferPool : public pstd::noncopyable {
+ public:
+  static constexpr size_t kMinSize = 16 * 1024;
+  static constexpr size_t kMaxPooledSize = 1024 * 1024;
+
+  explicit BufferPool(size_t max_pooled_bytes = 64 * 1024 * 1024);
+  ~BufferPool();
+
+  // a buffer of at least size bytes, *capacity is its real size
+  char* Borrow(size_t size, size_t* capacity);
+  void GiveBack(char* buf, size_t capacity);
+
+  // bytes of the buffers waiting in the pool
+  size_t PooledBytes() const { return pooled_bytes_.load(std::memory_order_relaxed); }
+  // bytes of the buffers borrowed by the connections
+  size_t InUseBytes() const { return in_use_bytes_.load(std::memory_order_relaxed); }
+
+  // the connections account the capacity of their reply buffers here
+  void AddReplyBytes(ptrdiff_t bytes) { reply_bytes_.fetch_add(bytes, std::memory_order_relaxed); }
+  size_t ReplyBytes() const { return static_cast<size_t>(reply_bytes_.load(std::memory_order_relaxed)); }
+
+ private:
+  static constexpr int kClassNum = 7;  // 16KB ... 1MB
+
+  struct SizeClass {
+    std::mutex mu;
+    std::vector<char*> free_bufs;
+  };
+
+  static int ClassOf(size_t size);
+  char* Malloc(size_t size);
+
+  SizeClass classes_[kClassNum];
+  const size_t max_pooled_bytes_;
+  std::atomic<size_t> pooled_bytes_ = 0;
+  std::atomic<size_t> in_use_bytes_ = 0;
+  std::atomic<ptrdiff_t> reply_bytes_ = 0;
+};
+
+// the pool shared by all connections of the process
+BufferPool* ConnBufferPool();
+
+}  // namespace net
+#endif  // NET_INCLUDE_BUFFER_POOL_H_
@@ -49,6 +49,18 @@ class NetConn : public std::enable_shared_from_this<NetConn>, public pstd::nonco
 
   virtual void TryResizeBuffer() {}
 
+  // bytes of the replies written to the conn but not sent yet
+  virtual size_t PendingReplyBytes() { return 0; }
+  virtual OutputBufferLimit output_buffer_limit() { return {}; }
+  // true once the pending replies broke the output buffer limit, the conn
+  // is to be closed then
+  bool OutputBufferLimitReached();
+  // true while the pending replies are above the soft limit
+  bool OutputBufferFull();
+  // the conn is not read while its output buffer is full
+  bool reads_paused() const { return reads_paused_; }
+  void set_reads_paused(bool paused) { reads_paused_ = paused; }
+
   int flags() const { return flags_; }
 
   void set_fd(const int fd) { fd_ = fd; }
@@ -101,6 +113,9 @@ class NetConn : public std::enable_shared_from_this<NetConn>, public pstd::nonco
   bool is_reply_ = false;
   bool is_writable_ = false;
   bool close_ = false;
+  bool reads_paused_ = false;
+  // when the pending replies went above the soft limit, 0 if they are below
+  time_t soft_limit_reached_time_ = 0;
   struct timeval last_interaction_;
   int flags_ = 0;
   std::string name_;
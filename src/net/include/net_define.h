@@ -6,6 +6,7 @@
 #ifndef NET_INCLUDE_NET_DEFINE_H_
 #define NET_INCLUDE_NET_DEFINE_H_
 
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <map>
@@ -76,6 +77,19 @@ enum WriteStatus {
   kWriteError = 2,
 };
 
+/*
+ * Limits of the replies a conn may have pending, as client-output-buffer-limit
+ * of redis: the conn is closed once they exceed hard_bytes, or stay above
+ * soft_bytes for soft_seconds. Above soft_bytes the conn is not read until
+ * they drain, with soft_seconds 0 that is all the soft limit does.
+ * 0 bytes is no limit.
+ */
+struct OutputBufferLimit {
+  uint64_t hard_bytes = 0;
+  uint64_t soft_bytes = 0;
+  int soft_seconds = 0;
+};
+
 enum RetCode {
   kSuccess = 0,
   kBindError = 1,
@@ -10,6 +10,7 @@
 #include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
 #include <queue>
 #include <set>
 #include <string>
@@ -23,20 +24,34 @@
 #include "net/include/net_define.h"
 #include "net/include/net_thread.h"
 #include "net/src/net_multiplexer.h"
+#include "net/src/net_notify_queue.h"
+#include "net/src/net_pattern_index.h"
 
 namespace net {
 
 class NetFiredEvent;
 class NetConn;
 
+/*
+ * Subscribed conns are moved here from the worker threads and spread over
+ * shards by fd, each shard reading and writing its conns in a thread of its
+ * own: shard 0 in this thread, the others in threads started along with it.
+ * Publish does not wait for the delivery. It counts the subscribers from the
+ * channel index, encodes the message once per channel or pattern matched and
+ * queues it, shared, to the shards of the subscribers, which write it out.
+ */
 class PubSubThread : public Thread {
  public:
-  PubSubThread();
+  explicit PubSubThread(int shard_num = 1);
 
   ~PubSubThread() override;
 
+  int StartThread() override;
+  int StopThread() override;
+
   // PubSub
 
+  // returns the number of subscribers the message was queued to
   int Publish(const std::string& channel, const std::string& msg);
 
   void Subscribe(const std::shared_ptr<NetConn>& conn, const std::vector<std::string>& channels, bool pattern,
@@ -70,6 +85,10 @@ class PubSubThread : public Thread {
     bool IsReady();
     std::shared_ptr<NetConn> conn;
     ReadyState ready_state;
+    // bytes of the messages queued to the shard for conn
+    std::atomic<uint64_t> queued_bytes = 0;
+    // the queued messages broke the output buffer limit of conn
+    std::atomic<bool> over_limit = false;
   };
 
   void UpdateConnReadyState(int fd, const ReadyState& state);
@@ -80,48 +99,72 @@ class PubSubThread : public Thread {
   void NotifyCloseAllConns();
 
  private:
+  // a published message for a subscriber, no resp asks the shard to close
+  // the conn for breaking its output buffer limit
+  struct Delivery {
+    std::shared_ptr<NetConn> conn;
+    std::shared_ptr<ConnHandle> handle;
+    std::shared_ptr<const std::string> resp;
+  };
+
+  struct Shard {
+    std::unique_ptr<NetMultiplexer> net_multiplexer;
+    // queued by the publishers, sent by the thread of the shard
+    MpscQueue<Delivery> deliveries;
+    std::atomic<bool> close_all_conn_sig{false};
+  };
+
+  // runs the loop of a shard other than 0
+  class ShardThread : public Thread {
+   public:
+    ShardThread(PubSubThread* pubsub, Shard* shard) : pubsub_(pubsub), shard_(shard) {}
+
+   private:
+    void* ThreadMain() override;
+
+    PubSubThread* pubsub_;
+    Shard* shard_;
+  };
+
+  Shard* ShardOf(int fd) { return shards_[fd % shards_.size()].get(); }
+  // queues resp for conn, false if conn may not get messages
+  bool Deliver(const std::shared_ptr<NetConn>& conn, const std::shared_ptr<const std::string>& resp);
+  // writes out the deliveries queued to the shard, one write per conn
+  void SendDeliveries(Shard* shard);
+  // true if conn is still here and may get messages
+  bool IsReady(const std::shared_ptr<NetConn>& conn);
+  void RunShard(Thread* thread, Shard* shard);
+
+  // channel_mutex_ or pattern_mutex_ is held by the caller
+  void RemoveChannelSubscriber(const std::string& channel, const std::shared_ptr<NetConn>& conn);
+  void RemovePatternSubscriber(const std::string& pattern, const std::shared_ptr<NetConn>& conn);
   void RemoveConn(const std::shared_ptr<NetConn>& conn);
   void CloseConn(const std::shared_ptr<NetConn>& conn);
-  void CloseAllConns();
+  void CloseAllConns(Shard* shard);
   int ClientChannelSize(const std::shared_ptr<NetConn>& conn);
 
-  int msg_pfd_[2];
-  bool should_exit_;
-
   mutable pstd::RWMutex rwlock_; /* For external statistics */
   std::map<int, std::shared_ptr<ConnHandle>> conns_;
-  std::atomic<bool> close_all_conn_sig_{false};
-
-  pstd::Mutex pub_mutex_;
-  pstd::CondVar receiver_rsignal_;
-  pstd::Mutex receiver_mutex_;
 
-  /*
-   * receive fd from worker thread
-   */
-  pstd::Mutex mutex_;
-  std::queue<NetItem> queue_;
-
-  std::string channel_;
-  std::string message_;
-  int receivers_{-1};
-
-  /*
-   * The epoll handler
-   */
-  std::unique_ptr<NetMultiplexer> net_multiplexer_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::vector<std::unique_ptr<ShardThread>> shard_threads_;
 
   void* ThreadMain() override;
 
-  // clean conns
-  void Cleanup();
+  // clean the conns of a shard
+  void Cleanup(Shard* shard);
 
-  // PubSub
-  pstd::Mutex channel_mutex_;
-  pstd::Mutex pattern_mutex_;
+  // PubSub, the publishers only read the index
+  pstd::RWMutex channel_mutex_;
+  pstd::RWMutex pattern_mutex_;
 
   std::map<std::string, std::vector<std::shared_ptr<NetConn>>> pubsub_channel_;  // channel <---> conns
   std::map<std::string, std::vector<std::shared_ptr<NetConn>>> pubsub_pattern_;  // channel <---> conns
+  // the channels and the patterns of each conn
+  std::map<std::shared_ptr<NetConn>, std::set<std::string>> conn_channels_;
+  std::map<std::shared_ptr<NetConn>, std::set<std::string>> conn_patterns_;
+  // the patterns in pubsub_pattern_ with subscribers, for Publish to match
+  PatternIndex pattern_index_;
 
 };  // class PubSubThread
 
@@ -23,12 +23,18 @@ class NetworkStatistic {
   void IncrRedisOutputBytes(uint64_t bytes);
   void IncrReplInputBytes(uint64_t bytes);
   void IncrReplOutputBytes(uint64_t bytes);
+  size_t OutputBufferLimitCloses();
+  size_t ReadPauses();
+  void IncrOutputBufferLimitCloses();
+  void IncrReadPauses();
 
  private:
   std::atomic<size_t> stat_net_input_bytes {0}; /* Bytes read from network. */
   std::atomic<size_t> stat_net_output_bytes {0}; /* Bytes written to network. */
   std::atomic<size_t> stat_net_repl_input_bytes {0}; /* Bytes read during replication, added to stat_net_input_bytes in 'info'. */
   std::atomic<size_t> stat_net_repl_output_bytes {0}; /* Bytes written during replication, added to stat_net_output_bytes in 'info'. */
+  std::atomic<size_t> stat_output_buffer_limit_closes {0}; /* Conns closed for breaking their output buffer limit. */
+  std::atomic<size_t> stat_read_pauses {0}; /* Times a conn was not read for its full output buffer. */
 };
 
 }
@@ -15,6 +15,11 @@
 
 namespace net {
 
+// called with each named thread net starts, Thread and ThreadPool workers,
+// from the starting thread right after it created and named it
+using ThreadStartHook = void (*)(pthread_t id, const std::string& name);
+void SetThreadStartHook(ThreadStartHook hook);
+
 class Thread : public pstd::noncopyable {
  public:
   Thread();
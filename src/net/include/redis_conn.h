@@ -32,11 +32,14 @@ class RedisConn : public NetConn {
   int WriteResp(const std::string& resp) override;
 
   void TryResizeBuffer() override;
+  size_t PendingReplyBytes() override { return response_.size() - wbuf_pos_; }
   void SetHandleType(const HandleType& handle_type);
   HandleType GetHandleType();
 
   virtual void ProcessRedisCmds(const std::vector<RedisCmdArgsType>& argvs, bool async, std::string* response);
-  void NotifyEpoll(bool success);
+  // try_send writes the reply right away from the calling thread, the worker
+  // thread then only has to watch the conn for reads again
+  void NotifyEpoll(bool success, bool try_send = false);
 
   virtual int DealMessage(const RedisCmdArgsType& argv, std::string* response) = 0;
   virtual const std::string& GetCurrentTable() = 0;
@@ -45,17 +48,22 @@ class RedisConn : public NetConn {
   static int ParserDealMessageCb(RedisParser* parser, const RedisCmdArgsType& argv);
   static int ParserCompleteCb(RedisParser* parser, const std::vector<RedisCmdArgsType>& argvs);
   ReadStatus ParseRedisParserStatus(RedisParserStatus status);
+  ReadStatus ReadRequest();
+  void ReleaseReadBuffer();
+  // tells the pool how much the reply buffer takes now
+  void AccountReplyBuffer();
 
   HandleType handle_type_ = kSynchronous;
 
+  // borrowed from ConnBufferPool() while reading
   char* rbuf_ = nullptr;
   int rbuf_len_ = 0;
   int rbuf_max_len_ = 0;
-  int msg_peak_ = 0;
   int command_len_ = 0;
 
   uint32_t wbuf_pos_ = 0;
   std::string response_;
+  size_t accounted_reply_bytes_ = 0;
 
   // For Redis Protocol parser
   int last_read_pos_ = -1;
@@ -161,6 +161,13 @@ class ServerThread : public Thread {
 
   virtual void SetQueueLimit(int queue_limit) {}
 
+  /*
+   * Accept in every worker on a SO_REUSEPORT listener of its own instead of
+   * in this thread, set before StartThread. With cpu_steering the kernel
+   * hands the conns received by cpu c to worker c % worker num.
+   */
+  virtual void EnableReusePort(bool cpu_steering) { UNUSED(cpu_steering); }
+
   ~ServerThread() override;
 
  protected:
@@ -179,6 +186,13 @@ class ServerThread : public Thread {
   int cron_interval_ = 0;
   virtual void DoCronTask();
 
+  /*
+   * Accept a conn on listen_fd and check it with the handle.
+   * Return false if nothing was accepted, otherwise *connfd is the conn
+   * or -1 if it was refused (and closed)
+   */
+  bool AcceptConn(int listen_fd, int* connfd, std::string* ip_port);
+
   // process events in notify_queue
   virtual void ProcessNotifyEvents(const NetFiredEvent* pfe);
   
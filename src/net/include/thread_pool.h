@@ -59,6 +59,8 @@ class ThreadPool : public pstd::noncopyable {
   void set_should_stop();
 
   void Schedule(TaskFunc func, void* arg);
+  // false instead of waiting if the queue is full, or if the pool is stopping
+  bool TrySchedule(TaskFunc func, void* arg);
   void DelaySchedule(uint64_t timeout, TaskFunc func, void* arg);
   size_t max_queue_size();
   size_t worker_size();
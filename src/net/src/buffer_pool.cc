@@ -0,0 +1,81 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "net/include/buffer_pool.h"
+
+#include <cstdlib>
+
+namespace net {
+
+BufferPool::BufferPool(size_t max_pooled_bytes) : max_pooled_bytes_(max_pooled_bytes) {}
+
+BufferPool::~BufferPool() {
+  for (auto& size_class : classes_) {
+    for (char* buf : size_class.free_bufs) {
+      free(buf);
+    }
+  }
+}
+
+int BufferPool::ClassOf(size_t size) {
+  int index = 0;
+  size_t class_size = kMinSize;
+  while (class_size < size) {
+    class_size <<= 1;
+    ++index;
+  }
+  return index;
+}
+
+char* BufferPool::Borrow(size_t size, size_t* capacity) {
+  if (size > kMaxPooledSize) {
+    *capacity = size;
+    return Malloc(size);
+  }
+  int index = ClassOf(size);
+  *capacity = kMinSize << index;
+  {
+    std::lock_guard l(classes_[index].mu);
+    std::vector<char*>& free_bufs = classes_[index].free_bufs;
+    if (!free_bufs.empty()) {
+      char* buf = free_bufs.back();
+      free_bufs.pop_back();
+      pooled_bytes_.fetch_sub(*capacity, std::memory_order_relaxed);
+      in_use_bytes_.fetch_add(*capacity, std::memory_order_relaxed);
+      return buf;
+    }
+  }
+  return Malloc(*capacity);
+}
+
+char* BufferPool::Malloc(size_t size) {
+  auto buf = static_cast<char*>(malloc(size));
+  if (buf) {
+    in_use_bytes_.fetch_add(size, std::memory_order_relaxed);
+  }
+  return buf;
+}
+
+void BufferPool::GiveBack(char* buf, size_t capacity) {
+  if (!buf) {
+    return;
+  }
+  in_use_bytes_.fetch_sub(capacity, std::memory_order_relaxed);
+  if (capacity <= kMaxPooledSize && pooled_bytes_.load(std::memory_order_relaxed) + capacity <= max_pooled_bytes_) {
+    int index = ClassOf(capacity);
+    std::lock_guard l(classes_[index].mu);
+    classes_[index].free_bufs.push_back(buf);
+    pooled_bytes_.fetch_add(capacity, std::memory_order_relaxed);
+    return;
+  }
+  free(buf);
+}
+
+BufferPool* ConnBufferPool() {
+  static BufferPool pool;
+  return &pool;
+}
+
+}  // namespace net
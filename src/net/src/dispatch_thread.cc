@@ -8,6 +8,7 @@
 #include <glog/logging.h>
 
 #include "net/src/dispatch_thread.h"
+#include "net/src/server_socket.h"
 #include "net/src/worker_thread.h"
 
 namespace net {
@@ -48,6 +49,12 @@ DispatchThread::DispatchThread(const std::set<std::string>& ips, int port, int w
 DispatchThread::~DispatchThread() = default;
 
 int DispatchThread::StartThread() {
+  if (reuse_port_) {
+    int ret = ListenInWorkers();
+    if (ret != kSuccess) {
+      return ret;
+    }
+  }
   for (int i = 0; i < work_num_; i++) {
     int ret = handle_->CreateWorkerSpecificData(&(worker_thread_[i]->private_data_));
     if (ret) {
@@ -55,7 +62,8 @@ int DispatchThread::StartThread() {
     }
 
     if (!thread_name().empty()) {
-      worker_thread_[i]->set_thread_name("WorkerThread");
+      // numbered like the listeners of ListenInWorkers, which the cpu steering picks by index
+      worker_thread_[i]->set_thread_name("WorkerThread" + std::to_string(i));
     }
     ret = worker_thread_[i]->StartThread();
     if (ret) {
@@ -262,6 +270,46 @@ void DispatchThread::ScanExpiredBlockedConnsOfBlrpop() {
 
 void DispatchThread::SetQueueLimit(int queue_limit) { queue_limit_ = queue_limit; }
 
+void DispatchThread::EnableReusePort(bool cpu_steering) {
+  reuse_port_ = true;
+  cpu_steering_ = cpu_steering;
+}
+
+int DispatchThread::ListenInWorkers() {
+  if (ips_.find("0.0.0.0") != ips_.end()) {
+    ips_.clear();
+    ips_.insert("0.0.0.0");
+  }
+  for (const auto& ip : ips_) {
+    std::shared_ptr<ServerSocket> first;
+    for (int i = 0; i < work_num_; i++) {
+      auto socket_p = std::make_shared<ServerSocket>(port_);
+      socket_p->set_reuse_port(true);
+      int ret = socket_p->Listen(ip);
+      if (ret != kSuccess) {
+        LOG(WARNING) << "worker " << i << " listen on " << ip << ":" << port_ << " with SO_REUSEPORT failed, errno "
+                     << errno << ", error reason " << strerror(errno);
+        return ret;
+      }
+      worker_thread_[i]->AddListener(socket_p);
+      if (!first) {
+        first = socket_p;
+      }
+    }
+    // the listeners joined the group in the order of the workers
+    if (cpu_steering_ && first->SetCpuSteering(work_num_) != 0) {
+      LOG(WARNING) << "steer the conns of " << ip << ":" << port_ << " by cpu failed, errno " << errno
+                   << ", the kernel spreads them by hash";
+    }
+  }
+  return kSuccess;
+}
+
+int DispatchThread::InitHandle() {
+  // the workers accept on their own
+  return reuse_port_ ? kSuccess : ServerThread::InitHandle();
+}
+
 void DispatchThread::AllConn(const std::function<void(const std::shared_ptr<NetConn>&)>& func) {
   std::unique_lock l(block_mtx_);
   for (const auto& item : worker_thread_) {
@@ -89,6 +89,8 @@ class DispatchThread : public ServerThread {
 
   void SetQueueLimit(int queue_limit) override;
 
+  void EnableReusePort(bool cpu_steering) override;
+
   void AllConn(const std::function<void(const std::shared_ptr<NetConn>&)>& func);
 
   /**
@@ -135,6 +137,12 @@ class DispatchThread : public ServerThread {
   int queue_limit_;
   std::map<WorkerThread*, void*> localdata_;
 
+  bool reuse_port_ = false;
+  bool cpu_steering_ = false;
+  // binds a SO_REUSEPORT listener per worker and ip, before the workers start
+  int ListenInWorkers();
+  int InitHandle() override;
+
   std::unordered_map<std::string, std::unordered_set<std::shared_ptr<NetConn>>> key_conns_map_;
   std::unordered_map<std::shared_ptr<NetConn>, std::unordered_set<std::string>> conn_keys_map_;
   std::mutex watch_keys_mu_;
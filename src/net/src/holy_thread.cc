@@ -278,29 +278,24 @@ bool HolyThread::KillConn(const std::string& ip_port) {
 
 void HolyThread::ProcessNotifyEvents(const net::NetFiredEvent* pfe) {
   if (pfe->mask & kReadable) {
-    char bb[2048];
-    int64_t nread = read(net_multiplexer_->NotifyReceiveFd(), bb, 2048);
-    if (nread == 0) {
-      return;
-    } else {
-      for (int32_t idx = 0; idx < nread; ++idx) {
-        net::NetItem ti = net_multiplexer_->NotifyQueuePop();
-        std::string ip_port = ti.ip_port();
-        int fd = ti.fd();
-        if (ti.notify_type() == net::kNotiWrite) {
-          net_multiplexer_->NetModEvent(ti.fd(), 0, kReadable | kWritable);
-        } else if (ti.notify_type() == net::kNotiClose) {
-          LOG(INFO) << "receive noti close";
-          std::shared_ptr<net::NetConn> conn = get_conn(fd);
-          if (!conn) {
-            continue;
-          }
-          CloseFd(conn);
-          conn = nullptr;
-          {
-            std::lock_guard l(rwlock_);
-            conns_.erase(fd);
-          }
+    net_multiplexer_->ClearNotify();
+    net::NetItem ti;
+    while (net_multiplexer_->NotifyQueuePop(&ti)) {
+      std::string ip_port = ti.ip_port();
+      int fd = ti.fd();
+      if (ti.notify_type() == net::kNotiWrite) {
+        net_multiplexer_->NetModEvent(ti.fd(), 0, kReadable | kWritable);
+      } else if (ti.notify_type() == net::kNotiClose) {
+        LOG(INFO) << "receive noti close";
+        std::shared_ptr<net::NetConn> conn = get_conn(fd);
+        if (!conn) {
+          continue;
+        }
+        CloseFd(conn);
+        conn = nullptr;
+        {
+          std::lock_guard l(rwlock_);
+          conns_.erase(fd);
         }
       }
     }
@@ -5,6 +5,7 @@
 
 #include <unistd.h>
 #include <cstdio>
+#include <ctime>
 
 #include <glog/logging.h>
 
@@ -39,6 +40,28 @@ void NetConn::SetClose(bool close) {
   close_ = close;
 }
 
+bool NetConn::OutputBufferFull() {
+  OutputBufferLimit limit = output_buffer_limit();
+  return limit.soft_bytes != 0 && PendingReplyBytes() > limit.soft_bytes;
+}
+
+bool NetConn::OutputBufferLimitReached() {
+  OutputBufferLimit limit = output_buffer_limit();
+  size_t pending = PendingReplyBytes();
+  if (limit.hard_bytes != 0 && pending > limit.hard_bytes) {
+    return true;
+  }
+  if (limit.soft_bytes == 0 || pending <= limit.soft_bytes) {
+    soft_limit_reached_time_ = 0;
+    return false;
+  }
+  time_t now = time(nullptr);
+  if (soft_limit_reached_time_ == 0) {
+    soft_limit_reached_time_ = now;
+  }
+  return limit.soft_seconds > 0 && now - soft_limit_reached_time_ >= limit.soft_seconds;
+}
+
 bool NetConn::SetNonblock() {
   flags_ = Setnonblocking(fd());
   return flags_ != -1;
@@ -7,6 +7,9 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
 #include <cstdlib>
 
 #include <glog/logging.h>
@@ -16,6 +19,13 @@
 namespace net {
 
 NetMultiplexer::NetMultiplexer(int queue_limit) : queue_limit_(queue_limit), fired_events_(NET_MAX_CLIENTS) {
+#if defined(__linux__)
+  notify_receive_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (notify_receive_fd_ < 0) {
+    exit(-1);
+  }
+  notify_send_fd_ = notify_receive_fd_;
+#else
   int fds[2];
   if (pipe(fds) != 0) {
     exit(-1);
@@ -25,12 +35,19 @@ NetMultiplexer::NetMultiplexer(int queue_limit) : queue_limit_(queue_limit), fir
 
   fcntl(notify_receive_fd_, F_SETFD, fcntl(notify_receive_fd_, F_GETFD) | FD_CLOEXEC);
   fcntl(notify_send_fd_, F_SETFD, fcntl(notify_send_fd_, F_GETFD) | FD_CLOEXEC);
+  fcntl(notify_receive_fd_, F_SETFL, fcntl(notify_receive_fd_, F_GETFL) | O_NONBLOCK);
+  fcntl(notify_send_fd_, F_SETFL, fcntl(notify_send_fd_, F_GETFL) | O_NONBLOCK);
+#endif
 }
 
 NetMultiplexer::~NetMultiplexer() {
   if (multiplexer_ != -1) {
     ::close(multiplexer_);
   }
+  if (notify_send_fd_ != notify_receive_fd_) {
+    ::close(notify_send_fd_);
+  }
+  ::close(notify_receive_fd_);
 }
 
 void NetMultiplexer::Initialize() {
@@ -38,18 +55,34 @@ void NetMultiplexer::Initialize() {
   init_ = true;
 }
 
-NetItem NetMultiplexer::NotifyQueuePop() {
+void NetMultiplexer::ClearNotify() {
+#if defined(__linux__)
+  uint64_t count = 0;
+  ssize_t n = read(notify_receive_fd_, &count, sizeof(count));
+  (void)(n);
+#else
+  char bb[2048];
+  while (read(notify_receive_fd_, bb, sizeof(bb)) > 0) {
+  }
+#endif
+  notify_batch_left_ = notify_queue_.Size();
+}
+
+bool NetMultiplexer::NotifyQueuePop(NetItem* it) {
   if (!init_) {
     LOG(ERROR) << "please call NetMultiplexer::Initialize()";
     std::abort();
   }
-
-  NetItem it;
-  notify_queue_protector_.lock();
-  it = notify_queue_.front();
-  notify_queue_.pop();
-  notify_queue_protector_.unlock();
-  return it;
+  if (notify_batch_left_ == 0) {
+    // what was registered meanwhile did not wake us if the queue was not
+    // empty at the time
+    if (notify_queue_.Size() > 0) {
+      WakeUp();
+    }
+    return false;
+  }
+  --notify_batch_left_;
+  return notify_queue_.Pop(it);
 }
 
 bool NetMultiplexer::Register(const NetItem& it, bool force) {
@@ -58,18 +91,24 @@ bool NetMultiplexer::Register(const NetItem& it, bool force) {
     return false;
   }
 
-  bool success = false;
-  notify_queue_protector_.lock();
-  if (force || queue_limit_ == kUnlimitedQueue || notify_queue_.size() < static_cast<size_t>(queue_limit_)) {
-    notify_queue_.push(it);
-    success = true;
+  if (!force && queue_limit_ != kUnlimitedQueue && notify_queue_.Size() >= static_cast<size_t>(queue_limit_)) {
+    return false;
   }
-  notify_queue_protector_.unlock();
-  if (success) {
-    ssize_t n = write(notify_send_fd_, "", 1);
-    (void)(n);
+  if (notify_queue_.Push(it) == 0) {
+    // the queue was empty, the poll thread may be asleep
+    WakeUp();
   }
-  return success;
+  return true;
+}
+
+void NetMultiplexer::WakeUp() {
+#if defined(__linux__)
+  uint64_t one = 1;
+  ssize_t n = write(notify_send_fd_, &one, sizeof(one));
+#else
+  ssize_t n = write(notify_send_fd_, "", 1);
+#endif
+  (void)(n);
 }
 
 }  // namespace net
@@ -5,11 +5,10 @@
 
 #ifndef NET_SRC_NET_MULTIPLEXER_H_
 #define NET_SRC_NET_MULTIPLEXER_H_
-#include <queue>
 #include <vector>
 
 #include "net/src/net_item.h"
-#include "pstd/include/pstd_mutex.h"
+#include "net/src/net_notify_queue.h"
 
 namespace net {
 
@@ -34,7 +33,11 @@ class NetMultiplexer {
 
   int NotifyReceiveFd() const { return notify_receive_fd_; }
   int NotifySendFd() const { return notify_send_fd_; }
-  NetItem NotifyQueuePop();
+  // Called when NotifyReceiveFd is readable, then NotifyQueuePop is called
+  // until it returns false. It pops the items queued before ClearNotify, the
+  // ones registered while they are handled are left to the next poll.
+  void ClearNotify();
+  bool NotifyQueuePop(NetItem* it);
 
   bool Register(const NetItem& it, bool force);
 
@@ -49,17 +52,23 @@ class NetMultiplexer {
    * The PbItem queue is the fd queue, receive from dispatch thread
    */
   int queue_limit_ = kUnlimitedQueue;
-  pstd::Mutex notify_queue_protector_;
-  std::queue<NetItem> notify_queue_;
+  NetNotifyQueue notify_queue_;
+  // items NotifyQueuePop still hands out for this wakeup
+  size_t notify_batch_left_ = 0;
   std::vector<NetFiredEvent> fired_events_;
 
   /*
-   * These two fd receive the notify from dispatch thread
+   * These two fd receive the notify from dispatch thread, the same eventfd
+   * on linux and a pipe elsewhere. Only the item which finds the queue empty
+   * writes to it, the items behind it are taken by the same wakeup.
    */
   int notify_receive_fd_ = -1;
   int notify_send_fd_ = -1;
 
   bool init_ = false;
+
+ private:
+  void WakeUp();
 };
 
 NetMultiplexer* CreateNetMultiplexer(int queue_limit = NetMultiplexer::kUnlimitedQueue);
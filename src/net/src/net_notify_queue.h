@@ -0,0 +1,77 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#ifndef NET_SRC_NET_NOTIFY_QUEUE_H_
+#define NET_SRC_NET_NOTIFY_QUEUE_H_
+
+#include <atomic>
+#include <thread>
+
+#include "net/src/net_item.h"
+#include "pstd/include/noncopyable.h"
+
+namespace net {
+
+/*
+ * Multi producer single consumer queue, a linked list where producers swap
+ * themselves in at the head and the consumer pops from a stub node at the
+ * tail. Push takes no lock, Pop may only be called by the thread owning the
+ * queue.
+ */
+template <typename T>
+class MpscQueue : public pstd::noncopyable {
+ public:
+  MpscQueue() : head_(new Node), tail_(head_.load()) {}
+  ~MpscQueue() {
+    T item;
+    while (Pop(&item)) {
+    }
+    delete tail_;
+  }
+
+  // returns the number of items which were in the queue before item
+  size_t Push(T item) {
+    auto node = new Node;
+    node->item = std::move(item);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+    return size_.fetch_add(1, std::memory_order_acq_rel);
+  }
+
+  bool Pop(T* item) {
+    if (size_.load(std::memory_order_acquire) == 0) {
+      return false;
+    }
+    // counted items are all linked but maybe not to us yet, a producer may
+    // still be between its exchange and its store above
+    Node* next = tail_->next.load(std::memory_order_acquire);
+    while (!next) {
+      std::this_thread::yield();
+      next = tail_->next.load(std::memory_order_acquire);
+    }
+    *item = std::move(next->item);
+    delete tail_;
+    tail_ = next;
+    size_.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+  }
+
+  size_t Size() const { return size_.load(std::memory_order_acquire); }
+
+ private:
+  struct Node {
+    std::atomic<Node*> next = nullptr;
+    T item;
+  };
+
+  std::atomic<Node*> head_;
+  Node* tail_;
+  std::atomic<size_t> size_ = 0;
+};
+
+using NetNotifyQueue = MpscQueue<NetItem>;
+
+}  // namespace net
+#endif  // NET_SRC_NET_NOTIFY_QUEUE_H_
@@ -0,0 +1,106 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "net/src/net_pattern_index.h"
+
+#include <vector>
+
+#include "pstd/include/pstd_string.h"
+
+namespace net {
+
+PatternIndex::PatternIndex() : root_(std::make_unique<Node>()) {}
+
+size_t PatternIndex::LiteralPrefixSize(const std::string& pattern) {
+  size_t pos = pattern.find_first_of("*?[\\");
+  return pos == std::string::npos ? pattern.size() : pos;
+}
+
+bool PatternIndex::Add(const std::string& pattern) {
+  size_t prefix_size = LiteralPrefixSize(pattern);
+  Node* node = root_.get();
+  for (size_t i = 0; i < prefix_size; ++i) {
+    auto& child = node->children[pattern[i]];
+    if (!child) {
+      child = std::make_unique<Node>();
+    }
+    node = child.get();
+  }
+
+  if (prefix_size == pattern.size()) {
+    if (node->literal) {
+      return false;
+    }
+    node->literal = true;
+  } else if (!node->globs.insert(pattern).second) {
+    return false;
+  }
+  ++size_;
+  return true;
+}
+
+bool PatternIndex::Remove(const std::string& pattern) {
+  size_t prefix_size = LiteralPrefixSize(pattern);
+  std::vector<Node*> path = {root_.get()};
+  for (size_t i = 0; i < prefix_size; ++i) {
+    auto iter = path.back()->children.find(pattern[i]);
+    if (iter == path.back()->children.end()) {
+      return false;
+    }
+    path.push_back(iter->second.get());
+  }
+
+  Node* node = path.back();
+  if (prefix_size == pattern.size()) {
+    if (!node->literal) {
+      return false;
+    }
+    node->literal = false;
+  } else if (node->globs.erase(pattern) == 0) {
+    return false;
+  }
+  --size_;
+
+  // drop the nodes left with nothing under them
+  for (size_t depth = prefix_size; depth > 0; --depth) {
+    Node* n = path[depth];
+    if (n->literal || !n->globs.empty() || !n->children.empty()) {
+      break;
+    }
+    path[depth - 1]->children.erase(pattern[depth - 1]);
+  }
+  return true;
+}
+
+void PatternIndex::Clear() {
+  root_ = std::make_unique<Node>();
+  size_ = 0;
+}
+
+void PatternIndex::Match(const std::string& channel, const std::function<void(const std::string&)>& func) const {
+  const Node* node = root_.get();
+  for (size_t depth = 0;; ++depth) {
+    for (const auto& glob : node->globs) {
+      // the prefix is matched already
+      if (pstd::stringmatchlen(glob.data() + depth, static_cast<int32_t>(glob.size() - depth), channel.data() + depth,
+                               static_cast<int32_t>(channel.size() - depth), 0) != 0) {
+        func(glob);
+      }
+    }
+    if (depth == channel.size()) {
+      if (node->literal) {
+        func(channel);
+      }
+      return;
+    }
+    auto iter = node->children.find(channel[depth]);
+    if (iter == node->children.end()) {
+      return;
+    }
+    node = iter->second.get();
+  }
+}
+
+}  // namespace net
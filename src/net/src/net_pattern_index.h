@@ -0,0 +1,56 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#ifndef NET_SRC_NET_PATTERN_INDEX_H_
+#define NET_SRC_NET_PATTERN_INDEX_H_
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace net {
+
+/*
+ * Index of glob patterns, answering which of them match a channel.
+ * A pattern is filed in a trie under its literal prefix, the part before its
+ * first '*', '?', '[' or '\'. Matching a channel walks the trie along it and
+ * only globs the rest of the patterns met on the way against the rest of the
+ * channel, so a pattern whose prefix the channel does not start with costs
+ * nothing. Patterns with no literal prefix, like "*", are checked for every
+ * channel. Not thread safe.
+ */
+class PatternIndex {
+ public:
+  PatternIndex();
+
+  // false if pattern is in already
+  bool Add(const std::string& pattern);
+  // false if pattern is not in
+  bool Remove(const std::string& pattern);
+  void Clear();
+  size_t size() const { return size_; }
+
+  // calls func with each pattern matching channel
+  void Match(const std::string& channel, const std::function<void(const std::string&)>& func) const;
+
+ private:
+  struct Node {
+    std::map<char, std::unique_ptr<Node>> children;
+    // the pattern made of the prefix alone, matching the prefix only
+    bool literal = false;
+    // the patterns with a glob after the prefix
+    std::set<std::string> globs;
+  };
+
+  static size_t LiteralPrefixSize(const std::string& pattern);
+
+  std::unique_ptr<Node> root_;
+  size_t size_ = 0;
+};
+
+}  // namespace net
+#endif  // NET_SRC_NET_PATTERN_INDEX_H_
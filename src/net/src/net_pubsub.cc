@@ -11,6 +11,9 @@
 
 #include "net/include/net_conn.h"
 #include "net/include/net_pubsub.h"
+#include "net/include/net_stats.h"
+
+extern std::unique_ptr<net::NetworkStatistic> g_network_statistic;
 
 namespace net {
 
@@ -47,25 +50,54 @@ void PubSubThread::ConnHandle::UpdateReadyState(const ReadyState& state) { ready
 
 bool PubSubThread::ConnHandle::IsReady() { return ready_state == PubSubThread::ReadyState::kReady; }
 
-PubSubThread::PubSubThread() {
+PubSubThread::PubSubThread(int shard_num) {
   set_thread_name("PubSubThread");
-  net_multiplexer_.reset(CreateNetMultiplexer());
-  net_multiplexer_->Initialize();
-  if (pipe(msg_pfd_)) {
-    exit(-1);
+  for (int i = 0; i < std::max(shard_num, 1); ++i) {
+    auto shard = std::make_unique<Shard>();
+    shard->net_multiplexer.reset(CreateNetMultiplexer());
+    shard->net_multiplexer->Initialize();
+    if (i > 0) {
+      auto shard_thread = std::make_unique<ShardThread>(this, shard.get());
+      shard_thread->set_thread_name("PubSubThread" + std::to_string(i));
+      shard_threads_.push_back(std::move(shard_thread));
+    }
+    shards_.push_back(std::move(shard));
   }
-  fcntl(msg_pfd_[0], F_SETFD, fcntl(msg_pfd_[0], F_GETFD) | FD_CLOEXEC);
-  fcntl(msg_pfd_[1], F_SETFD, fcntl(msg_pfd_[1], F_GETFD) | FD_CLOEXEC);
-
-  net_multiplexer_->NetAddEvent(msg_pfd_[0], kReadable);
 }
 
 PubSubThread::~PubSubThread() { StopThread(); }
 
+int PubSubThread::StartThread() {
+  for (auto& shard_thread : shard_threads_) {
+    int ret = shard_thread->StartThread();
+    if (ret != 0) {
+      return ret;
+    }
+  }
+  return Thread::StartThread();
+}
+
+int PubSubThread::StopThread() {
+  // let all the shards leave their poll at once rather than one after another
+  for (auto& shard_thread : shard_threads_) {
+    shard_thread->set_should_stop();
+  }
+  set_should_stop();
+  for (auto& shard_thread : shard_threads_) {
+    shard_thread->StopThread();
+  }
+  return Thread::StopThread();
+}
+
+void* PubSubThread::ShardThread::ThreadMain() {
+  pubsub_->RunShard(this, shard_);
+  return nullptr;
+}
+
 void PubSubThread::MoveConnOut(const std::shared_ptr<NetConn>& conn) {
   RemoveConn(conn);
 
-  net_multiplexer_->NetDelEvent(conn->fd(), 0);
+  ShardOf(conn->fd())->net_multiplexer->NetDelEvent(conn->fd(), 0);
   {
     std::lock_guard l(rwlock_);
     conns_.erase(conn->fd());
@@ -73,13 +105,14 @@ void PubSubThread::MoveConnOut(const std::shared_ptr<NetConn>& conn) {
 }
 
 void PubSubThread::MoveConnIn(const std::shared_ptr<NetConn>& conn, const NotifyType& notify_type) {
+  NetMultiplexer* net_multiplexer = ShardOf(conn->fd())->net_multiplexer.get();
   NetItem it(conn->fd(), conn->ip_port(), notify_type);
-  net_multiplexer_->Register(it, true);
+  net_multiplexer->Register(it, true);
   {
     std::lock_guard l(rwlock_);
     conns_[conn->fd()] = std::make_shared<ConnHandle>(conn);
   }
-  conn->set_net_multiplexer(net_multiplexer_.get());
+  conn->set_net_multiplexer(net_multiplexer);
 }
 
 void PubSubThread::UpdateConnReadyState(int fd, const ReadyState& state) {
@@ -100,58 +133,66 @@ bool PubSubThread::IsReady(int fd) {
   return false;
 }
 
+bool PubSubThread::IsReady(const std::shared_ptr<NetConn>& conn) {
+  std::shared_lock l(rwlock_);
+  const auto& it = conns_.find(conn->fd());
+  return it != conns_.end() && it->second->conn == conn && it->second->IsReady();
+}
+
 int PubSubThread::ClientPubSubChannelSize(const std::shared_ptr<NetConn>& conn) {
-  int subscribed = 0;
-  std::lock_guard l(channel_mutex_);
-  for (auto& channel : pubsub_channel_) {
-    auto conn_ptr = std::find(channel.second.begin(), channel.second.end(), conn);
-    if (conn_ptr != channel.second.end()) {
-      subscribed++;
-    }
-  }
-  return subscribed;
+  std::shared_lock l(channel_mutex_);
+  auto iter = conn_channels_.find(conn);
+  return iter == conn_channels_.end() ? 0 : static_cast<int>(iter->second.size());
 }
 
 int PubSubThread::ClientPubSubChannelPatternSize(const std::shared_ptr<NetConn>& conn) {
-  int subscribed = 0;
-  std::lock_guard l(pattern_mutex_);
-  for (auto& channel : pubsub_pattern_) {
-    auto conn_ptr = std::find(channel.second.begin(), channel.second.end(), conn);
-    if (conn_ptr != channel.second.end()) {
-      subscribed++;
-    }
+  std::shared_lock l(pattern_mutex_);
+  auto iter = conn_patterns_.find(conn);
+  return iter == conn_patterns_.end() ? 0 : static_cast<int>(iter->second.size());
+}
+
+void PubSubThread::RemoveChannelSubscriber(const std::string& channel, const std::shared_ptr<NetConn>& conn) {
+  auto iter = pubsub_channel_.find(channel);
+  if (iter != pubsub_channel_.end()) {
+    iter->second.erase(std::remove(iter->second.begin(), iter->second.end(), conn), iter->second.end());
+  }
+}
+
+void PubSubThread::RemovePatternSubscriber(const std::string& pattern, const std::shared_ptr<NetConn>& conn) {
+  auto iter = pubsub_pattern_.find(pattern);
+  if (iter == pubsub_pattern_.end()) {
+    return;
+  }
+  iter->second.erase(std::remove(iter->second.begin(), iter->second.end(), conn), iter->second.end());
+  if (iter->second.empty()) {
+    pattern_index_.Remove(pattern);
   }
-  return subscribed;
 }
 
 void PubSubThread::RemoveConn(const std::shared_ptr<NetConn>& conn) {
   {
     std::lock_guard lock(pattern_mutex_);
-    for (auto& it : pubsub_pattern_) {
-      for (auto conn_ptr = it.second.begin(); conn_ptr != it.second.end(); conn_ptr++) {
-        if ((*conn_ptr) == conn) {
-          conn_ptr = it.second.erase(conn_ptr);
-          break;
-        }
+    if (auto iter = conn_patterns_.find(conn); iter != conn_patterns_.end()) {
+      for (const auto& pattern : iter->second) {
+        RemovePatternSubscriber(pattern, conn);
       }
+      conn_patterns_.erase(iter);
     }
   }
 
   {
     std::lock_guard lock(channel_mutex_);
-    for (auto& it : pubsub_channel_) {
-      for (auto conn_ptr = it.second.begin(); conn_ptr != it.second.end(); conn_ptr++) {
-        if ((*conn_ptr) == conn) {
-          conn_ptr = it.second.erase(conn_ptr);
-          break;
-        }
+    if (auto iter = conn_channels_.find(conn); iter != conn_channels_.end()) {
+      for (const auto& channel : iter->second) {
+        RemoveChannelSubscriber(channel, conn);
       }
+      conn_channels_.erase(iter);
     }
   }
 }
 
 void PubSubThread::CloseConn(const std::shared_ptr<NetConn>& conn) {
-  net_multiplexer_->NetDelEvent(conn->fd(), 0);
+  ShardOf(conn->fd())->net_multiplexer->NetDelEvent(conn->fd(), 0);
   CloseFd(conn);
   {
     std::lock_guard l(rwlock_);
@@ -159,68 +200,143 @@ void PubSubThread::CloseConn(const std::shared_ptr<NetConn>& conn) {
   }
 }
 
-void PubSubThread::CloseAllConns() {
+void PubSubThread::CloseAllConns(Shard* shard) {
   {
     std::lock_guard l(channel_mutex_);
     pubsub_channel_.clear();
+    conn_channels_.clear();
   }
   {
     std::lock_guard l(pattern_mutex_);
     pubsub_pattern_.clear();
+    conn_patterns_.clear();
+    pattern_index_.Clear();
   }
   {
     std::lock_guard l(rwlock_);
-    for (auto& pair : conns_) {
-      net_multiplexer_->NetDelEvent(pair.second->conn->fd(), 0);
-      CloseFd(pair.second->conn);
+    for (auto iter = conns_.begin(); iter != conns_.end();) {
+      if (ShardOf(iter->first) != shard) {
+        ++iter;
+        continue;
+      }
+      shard->net_multiplexer->NetDelEvent(iter->first, 0);
+      CloseFd(iter->second->conn);
+      iter = conns_.erase(iter);
     }
-    std::map<int, std::shared_ptr<ConnHandle>> tmp;
-    conns_.swap(tmp);
   }
 }
 
 int PubSubThread::Publish(const std::string& channel, const std::string& msg) {
-  // TODO(LIBA-S): change the Publish Mode to Asynchronous
-  std::lock_guard lk(pub_mutex_);
-  channel_ = channel;
-  message_ = msg;
-  // Send signal to ThreadMain()
-  ssize_t n = write(msg_pfd_[1], "", 1);
-  (void)(n);
-  std::unique_lock lock(receiver_mutex_);
-  receiver_rsignal_.wait(lock, [this]() { return receivers_ != -1; });
-
-  int receivers = receivers_;
-  receivers_ = -1;
+  int receivers = 0;
+  {
+    std::shared_lock l(channel_mutex_);
+    auto it = pubsub_channel_.find(channel);
+    if (it != pubsub_channel_.end() && !it->second.empty()) {
+      auto resp = std::make_shared<const std::string>(ConstructPublishResp(it->first, channel, msg, false));
+      for (const auto& conn : it->second) {
+        if (Deliver(conn, resp)) {
+          ++receivers;
+        }
+      }
+    }
+  }
 
+  {
+    std::shared_lock l(pattern_mutex_);
+    // the index holds the patterns with subscribers only
+    pattern_index_.Match(channel, [&](const std::string& pattern) {
+      const auto& conns = pubsub_pattern_.find(pattern)->second;
+      auto resp = std::make_shared<const std::string>(ConstructPublishResp(pattern, channel, msg, true));
+      for (const auto& conn : conns) {
+        if (Deliver(conn, resp)) {
+          ++receivers;
+        }
+      }
+    });
+  }
   return receivers;
 }
 
-/*
- * return the number of channels that the specific connection currently subscribed
- */
-int PubSubThread::ClientChannelSize(const std::shared_ptr<NetConn>& conn) {
-  int subscribed = 0;
+bool PubSubThread::Deliver(const std::shared_ptr<NetConn>& conn, const std::shared_ptr<const std::string>& resp) {
+  std::shared_ptr<ConnHandle> handle;
+  {
+    std::shared_lock l(rwlock_);
+    auto it = conns_.find(conn->fd());
+    if (it == conns_.end() || it->second->conn != conn || !it->second->IsReady()) {
+      return false;
+    }
+    handle = it->second;
+  }
+  if (handle->over_limit.load()) {
+    return true;
+  }
+
+  // the hard output buffer limit of the conn applies to its queued messages
+  // too, a subscriber which does not read can not grow the queue for good
+  Delivery delivery{conn, handle, resp};
+  uint64_t hard_bytes = conn->output_buffer_limit().hard_bytes;
+  if (hard_bytes != 0 && handle->queued_bytes.fetch_add(resp->size()) + resp->size() > hard_bytes) {
+    handle->queued_bytes.fetch_sub(resp->size());
+    if (handle->over_limit.exchange(true)) {
+      return true;
+    }
+    delivery.resp = nullptr;
+  }
+  Shard* shard = ShardOf(conn->fd());
+  // only the delivery finding the queue empty wakes the shard, it sends
+  // all that is queued by the time it gets to it
+  if (shard->deliveries.Push(std::move(delivery)) == 0) {
+    shard->net_multiplexer->Register(NetItem(0, "", kNotiWrite), true);
+  }
+  return true;
+}
 
-  channel_mutex_.lock();
-  for (auto& channel : pubsub_channel_) {
-    auto conn_ptr = std::find(channel.second.begin(), channel.second.end(), conn);
-    if (conn_ptr != channel.second.end()) {
-      subscribed++;
+void PubSubThread::SendDeliveries(Shard* shard) {
+  std::map<int, std::shared_ptr<NetConn>> written;
+  std::vector<std::shared_ptr<NetConn>> over_limit;
+  Delivery delivery;
+  while (shard->deliveries.Pop(&delivery)) {
+    if (!delivery.resp) {
+      over_limit.push_back(std::move(delivery.conn));
+      continue;
     }
+    delivery.handle->queued_bytes.fetch_sub(delivery.resp->size());
+    // unsubscribed or closed since
+    if (!IsReady(delivery.conn) || delivery.conn->IsClose()) {
+      continue;
+    }
+    delivery.conn->WriteResp(*delivery.resp);
+    written.emplace(delivery.conn->fd(), std::move(delivery.conn));
   }
-  channel_mutex_.unlock();
 
-  pattern_mutex_.lock();
-  for (auto& channel : pubsub_pattern_) {
-    auto conn_ptr = std::find(channel.second.begin(), channel.second.end(), conn);
-    if (conn_ptr != channel.second.end()) {
-      subscribed++;
+  for (auto& conn : over_limit) {
+    written.erase(conn->fd());
+    if (!IsReady(conn)) {
+      continue;
     }
+    LOG(WARNING) << "close conn " << conn->ip_port() << ", the messages queued for it broke its output buffer limit";
+    g_network_statistic->IncrOutputBufferLimitCloses();
+    MoveConnOut(conn);
+    CloseFd(conn);
   }
-  pattern_mutex_.unlock();
 
-  return subscribed;
+  for (auto& [fd, conn] : written) {
+    // a conn which broke its output buffer limit goes as one failing to write
+    WriteStatus write_status = conn->IsClose() ? kWriteError : conn->SendReply();
+    if (write_status == kWriteHalf) {
+      shard->net_multiplexer->NetModEvent(fd, kReadable, kWritable);
+    } else if (write_status == kWriteError) {
+      MoveConnOut(conn);
+      CloseFd(conn);
+    }
+  }
+}
+
+/*
+ * return the number of channels that the specific connection currently subscribed
+ */
+int PubSubThread::ClientChannelSize(const std::shared_ptr<NetConn>& conn) {
+  return ClientPubSubChannelSize(conn) + ClientPubSubChannelPatternSize(conn);
 }
 
 void PubSubThread::Subscribe(const std::shared_ptr<NetConn>& conn, const std::vector<std::string>& channels,
@@ -234,29 +350,19 @@ void PubSubThread::Subscribe(const std::shared_ptr<NetConn>& conn, const std::ve
   for (const auto& channel : channels) {
     if (pattern) {  // if pattern mode, register channel to map
       std::lock_guard channel_lock(pattern_mutex_);
-      if (pubsub_pattern_.find(channel) != pubsub_pattern_.end()) {
-        auto conn_ptr = std::find(pubsub_pattern_[channel].begin(), pubsub_pattern_[channel].end(), conn);
-        if (conn_ptr == pubsub_pattern_[channel].end()) {  // the connection first subscrbied
-          pubsub_pattern_[channel].push_back(conn);
-          ++subscribed;
+      if (conn_patterns_[conn].insert(channel).second) {  // the connection first subscribed
+        auto& conns = pubsub_pattern_[channel];
+        if (conns.empty()) {
+          pattern_index_.Add(channel);
         }
-      } else {  // the channel first subscribed
-        std::vector<std::shared_ptr<NetConn>> conns = {conn};
-        pubsub_pattern_[channel] = conns;
+        conns.push_back(conn);
         ++subscribed;
       }
       result->emplace_back(channel, subscribed);
     } else {  // if general mode, reigster channel to map
       std::lock_guard channel_lock(channel_mutex_);
-      if (pubsub_channel_.find(channel) != pubsub_channel_.end()) {
-        auto conn_ptr = std::find(pubsub_channel_[channel].begin(), pubsub_channel_[channel].end(), conn);
-        if (conn_ptr == pubsub_channel_[channel].end()) {  // the connection first subscribed
-          pubsub_channel_[channel].push_back(conn);
-          ++subscribed;
-        }
-      } else {  // the channel first subscribed
-        std::vector<std::shared_ptr<NetConn>> conns = {conn};
-        pubsub_channel_[channel] = conns;
+      if (conn_channels_[conn].insert(channel).second) {  // the connection first subscribed
+        pubsub_channel_[channel].push_back(conn);
         ++subscribed;
       }
       result->emplace_back(channel, subscribed);
@@ -277,19 +383,17 @@ int PubSubThread::UnSubscribe(const std::shared_ptr<NetConn>& conn, const std::v
   }
   if (channels.empty()) {  // if client want to unsubscribe all of channels
     if (pattern) {         // all of pattern channels
-      std::lock_guard l(pattern_mutex_);
-      for (auto& channel : pubsub_pattern_) {
-        auto conn_ptr = std::find(channel.second.begin(), channel.second.end(), conn);
-        if (conn_ptr != channel.second.end()) {
-          result->emplace_back(channel.first, --subscribed);
+      std::shared_lock l(pattern_mutex_);
+      if (auto iter = conn_patterns_.find(conn); iter != conn_patterns_.end()) {
+        for (const auto& channel : iter->second) {
+          result->emplace_back(channel, --subscribed);
         }
       }
     } else {
-      std::lock_guard l(channel_mutex_);
-      for (auto& channel : pubsub_channel_) {
-        auto conn_ptr = std::find(channel.second.begin(), channel.second.end(), conn);
-        if (conn_ptr != channel.second.end()) {
-          result->emplace_back(channel.first, --subscribed);
+      std::shared_lock l(channel_mutex_);
+      if (auto iter = conn_channels_.find(conn); iter != conn_channels_.end()) {
+        for (const auto& channel : iter->second) {
+          result->emplace_back(channel, --subscribed);
         }
       }
     }
@@ -302,31 +406,29 @@ int PubSubThread::UnSubscribe(const std::shared_ptr<NetConn>& conn, const std::v
   for (const auto& channel : channels) {
     if (pattern) {  // if pattern mode, unsubscribe the channels of specified
       std::lock_guard l(pattern_mutex_);
-      auto channel_ptr = pubsub_pattern_.find(channel);
-      if (channel_ptr != pubsub_pattern_.end()) {
-        auto it = std::find(channel_ptr->second.begin(), channel_ptr->second.end(), conn);
-        if (it != channel_ptr->second.end()) {
-          channel_ptr->second.erase(std::remove(channel_ptr->second.begin(), channel_ptr->second.end(), conn),
-                                    channel_ptr->second.end());
-          result->emplace_back(channel, --subscribed);
-        } else {
-          result->emplace_back(channel, subscribed);
+      auto conn_iter = conn_patterns_.find(conn);
+      if (conn_iter != conn_patterns_.end() && conn_iter->second.erase(channel) != 0) {
+        if (conn_iter->second.empty()) {
+          conn_patterns_.erase(conn_iter);
         }
+        RemovePatternSubscriber(channel, conn);
+        result->emplace_back(channel, --subscribed);
+      } else if (pubsub_pattern_.find(channel) != pubsub_pattern_.end()) {
+        result->emplace_back(channel, subscribed);
       } else {
         result->emplace_back(channel, 0);
       }
     } else {  // if general mode, unsubscribe the channels of specified
       std::lock_guard l(channel_mutex_);
-      auto channel_ptr = pubsub_channel_.find(channel);
-      if (channel_ptr != pubsub_channel_.end()) {
-        auto it = std::find(channel_ptr->second.begin(), channel_ptr->second.end(), conn);
-        if (it != channel_ptr->second.end()) {
-          channel_ptr->second.erase(std::remove(channel_ptr->second.begin(), channel_ptr->second.end(), conn),
-                                    channel_ptr->second.end());
-          result->emplace_back(channel, --subscribed);
-        } else {
-          result->emplace_back(channel, subscribed);
+      auto conn_iter = conn_channels_.find(conn);
+      if (conn_iter != conn_channels_.end() && conn_iter->second.erase(channel) != 0) {
+        if (conn_iter->second.empty()) {
+          conn_channels_.erase(conn_iter);
         }
+        RemoveChannelSubscriber(channel, conn);
+        result->emplace_back(channel, --subscribed);
+      } else if (pubsub_channel_.find(channel) != pubsub_channel_.end()) {
+        result->emplace_back(channel, subscribed);
       } else {
         result->emplace_back(channel, 0);
       }
@@ -343,14 +445,14 @@ int PubSubThread::UnSubscribe(const std::shared_ptr<NetConn>& conn, const std::v
 
 void PubSubThread::PubSubChannels(const std::string& pattern, std::vector<std::string>* result) {
   if (pattern.empty()) {
-    std::lock_guard l(channel_mutex_);
+    std::shared_lock l(channel_mutex_);
     for (auto& channel : pubsub_channel_) {
       if (!channel.second.empty()) {
         result->push_back(channel.first);
       }
     }
   } else {
-    std::lock_guard l(channel_mutex_);
+    std::shared_lock l(channel_mutex_);
     for (auto& channel : pubsub_channel_) {
       if (pstd::stringmatchlen(channel.first.c_str(), static_cast<int32_t>(channel.first.size()), pattern.c_str(),
                                static_cast<int32_t>(pattern.size()), 0)) {
@@ -365,7 +467,7 @@ void PubSubThread::PubSubChannels(const std::string& pattern, std::vector<std::s
 void PubSubThread::PubSubNumSub(const std::vector<std::string>& channels,
                                 std::vector<std::pair<std::string, int>>* result) {
   int subscribed;
-  std::lock_guard l(channel_mutex_);
+  std::shared_lock l(channel_mutex_);
   for (const auto& i : channels) {
     subscribed = 0;
     for (auto& channel : pubsub_channel_) {
@@ -379,7 +481,7 @@ void PubSubThread::PubSubNumSub(const std::vector<std::string>& channels,
 
 int PubSubThread::PubSubNumPat() {
   int subscribed = 0;
-  std::lock_guard l(pattern_mutex_);
+  std::shared_lock l(pattern_mutex_);
   for (auto& channel : pubsub_pattern_) {
     subscribed += static_cast<int32_t>(channel.second.size());
   }
@@ -388,230 +490,171 @@ int PubSubThread::PubSubNumPat() {
 
 void PubSubThread::ConnCanSubscribe(const std::vector<std::string>& allChannel,
                                     const std::function<bool(const std::shared_ptr<NetConn>&)>& func) {
+  std::set<std::shared_ptr<NetConn>> killed;
   {
-    std::lock_guard l(channel_mutex_);
-    for (auto& item : pubsub_channel_) {
-      for (auto it = item.second.rbegin(); it != item.second.rend(); it++) {
-        if (func(*it) && (allChannel.empty() || !std::count(allChannel.begin(), allChannel.end(), item.first))) {
-          item.second.erase(std::next(it).base());
-          CloseConn(*it);
+    std::shared_lock l(channel_mutex_);
+    for (const auto& [conn, subscribed] : conn_channels_) {
+      if (!func(conn)) {
+        continue;
+      }
+      for (const auto& channel : subscribed) {
+        if (allChannel.empty() || !std::count(allChannel.begin(), allChannel.end(), channel)) {
+          killed.insert(conn);
+          break;
         }
-      }  // for end
+      }
     }
   }
 
   {
-    std::lock_guard l(pattern_mutex_);
-    for (auto& item : pubsub_pattern_) {
-      for (auto it = item.second.rbegin(); it != item.second.rend(); it++) {
-        bool kill = false;
-        if (func(*it)) {
-          if (allChannel.empty()) {
+    std::shared_lock l(pattern_mutex_);
+    for (const auto& [conn, subscribed] : conn_patterns_) {
+      if (!func(conn)) {
+        continue;
+      }
+      for (const auto& pattern : subscribed) {
+        bool kill = allChannel.empty();
+        for (const auto& channelName : allChannel) {
+          if (!pstd::stringmatchlen(channelName.c_str(), static_cast<int32_t>(channelName.size()), pattern.c_str(),
+                                    static_cast<int32_t>(pattern.size()), 0)) {
             kill = true;
-          }
-          for (const auto& channelName : allChannel) {
-            if (kill || !pstd::stringmatchlen(channelName.c_str(), static_cast<int32_t>(channelName.size()),
-                                              item.first.c_str(), static_cast<int32_t>(item.first.size()), 0)) {
-              kill = true;
-              break;
-            }
+            break;
           }
         }
         if (kill) {
-          item.second.erase(std::next(it).base());
-          CloseConn(*it);
+          killed.insert(conn);
+          break;
         }
       }
     }
   }
+
+  for (const auto& conn : killed) {
+    RemoveConn(conn);
+    CloseConn(conn);
+  }
 }
 
 void* PubSubThread::ThreadMain() {
+  RunShard(this, shards_.front().get());
+  return nullptr;
+}
+
+void PubSubThread::RunShard(Thread* thread, Shard* shard) {
   int nfds;
   NetFiredEvent* pfe;
-  pstd::Status s;
   std::shared_ptr<NetConn> in_conn = nullptr;
-  char triger[1];
+  NetMultiplexer* net_multiplexer = shard->net_multiplexer.get();
 
-  while (!should_stop()) {
+  while (!thread->should_stop()) {
 
-    if (close_all_conn_sig_.load()) {
-      close_all_conn_sig_.store(false);
-      CloseAllConns();
+    if (shard->close_all_conn_sig.load()) {
+      shard->close_all_conn_sig.store(false);
+      CloseAllConns(shard);
     }
 
-    nfds = net_multiplexer_->NetPoll(NET_CRON_INTERVAL);
+    nfds = net_multiplexer->NetPoll(NET_CRON_INTERVAL);
     for (int i = 0; i < nfds; i++) {
-      pfe = (net_multiplexer_->FiredEvents()) + i;
-      if (pfe->fd == net_multiplexer_->NotifyReceiveFd()) {  // New connection comming
+      pfe = (net_multiplexer->FiredEvents()) + i;
+      if (pfe->fd == net_multiplexer->NotifyReceiveFd()) {  // New connection comming
         if (pfe->mask & kReadable) {
-          ssize_t n = read(net_multiplexer_->NotifyReceiveFd(), triger, 1);
-          (void)(n);
-          {
-            NetItem ti = net_multiplexer_->NotifyQueuePop();
+          net_multiplexer->ClearNotify();
+          NetItem ti;
+          while (net_multiplexer->NotifyQueuePop(&ti)) {
             if (ti.notify_type() == kNotiClose) {
             } else if (ti.notify_type() == kNotiEpollout) {
-              net_multiplexer_->NetModEvent(ti.fd(), 0, kWritable);
+              net_multiplexer->NetModEvent(ti.fd(), 0, kWritable);
             } else if (ti.notify_type() == kNotiEpollin) {
-              net_multiplexer_->NetModEvent(ti.fd(), 0, kReadable);
+              net_multiplexer->NetModEvent(ti.fd(), 0, kReadable);
             } else if (ti.notify_type() == kNotiEpolloutAndEpollin) {
-              net_multiplexer_->NetModEvent(ti.fd(), 0, kWritable | kReadable);
+              net_multiplexer->NetModEvent(ti.fd(), 0, kWritable | kReadable);
             } else if (ti.notify_type() == kNotiWait) {
               // do not register events
-              net_multiplexer_->NetAddEvent(ti.fd(), 0);
+              net_multiplexer->NetAddEvent(ti.fd(), 0);
+            } else if (ti.notify_type() == kNotiWrite) {
+              // published messages, sent below
             }
           }
-          continue;
         }
+        continue;
       }
-      if (pfe->fd == msg_pfd_[0]) {  // Publish message
-        if (pfe->mask & kReadable) {
-          ssize_t n = read(msg_pfd_[0], triger, 1);
-          (void)(n);
-          std::string channel;
-          std::string msg;
-          int32_t receivers = 0;
-          channel = channel_;
-          msg = message_;
-          channel_.clear();
-          message_.clear();
-
-          // Send message to a channel's clients
-          channel_mutex_.lock();
-          auto it = pubsub_channel_.find(channel);
-          if (it != pubsub_channel_.end()) {
-            for (size_t i = 0; i < it->second.size(); i++) {
-              auto& conn = it->second[i];
-              if (!IsReady(conn->fd())) {
-                continue;
-              }
-              std::string resp = ConstructPublishResp(it->first, channel, msg, false);
-              conn->WriteResp(resp);
-              WriteStatus write_status = conn->SendReply();
-              if (write_status == kWriteHalf) {
-                net_multiplexer_->NetModEvent(conn->fd(), kReadable, kWritable);
-              } else if (write_status == kWriteError) {
-                channel_mutex_.unlock();
-
-                MoveConnOut(conn);
-
-                channel_mutex_.lock();
-                CloseFd(conn);
-              } else if (write_status == kWriteAll) {
-                receivers++;
-              }
-            }
-          }
-          channel_mutex_.unlock();
-
-          // Send message to a channel pattern's clients
-          pattern_mutex_.lock();
-          for (auto& it : pubsub_pattern_) {
-            if (pstd::stringmatchlen(it.first.c_str(), static_cast<int32_t>(it.first.size()), channel.c_str(),
-                                     static_cast<int32_t>(channel.size()), 0)) {
-              for (size_t i = 0; i < it.second.size(); i++) {
-                auto& conn = it.second[i];
-                if (!IsReady(conn->fd())) {
-                  continue;
-                }
-                std::string resp = ConstructPublishResp(it.first, channel, msg, true);
-                conn->WriteResp(resp);
-                WriteStatus write_status = conn->SendReply();
-                if (write_status == kWriteHalf) {
-                  net_multiplexer_->NetModEvent(conn->fd(), kReadable, kWritable);
-                } else if (write_status == kWriteError) {
-                  pattern_mutex_.unlock();
-
-                  MoveConnOut(conn);
-
-                  pattern_mutex_.lock();
-                  CloseFd(conn);
-                } else if (write_status == kWriteAll) {
-                  receivers++;
-                }
-              }
-            }
-          }
-          pattern_mutex_.unlock();
 
-          receiver_mutex_.lock();
-          receivers_ = receivers;
-          receiver_rsignal_.notify_one();
-          receiver_mutex_.unlock();
-        } else {
+      in_conn = nullptr;
+      bool should_close = false;
+
+      {
+        std::shared_lock l(rwlock_);
+        if (auto iter = conns_.find(pfe->fd); iter == conns_.end()) {
+          net_multiplexer->NetDelEvent(pfe->fd, 0);
           continue;
+        } else {
+          in_conn = iter->second->conn;
         }
-      } else {
-        in_conn = nullptr;
-        bool should_close = false;
-
-        {
-          std::shared_lock l(rwlock_);
-          if (auto iter = conns_.find(pfe->fd); iter == conns_.end()) {
-            net_multiplexer_->NetDelEvent(pfe->fd, 0);
-            continue;
-          } else {
+      }
 
-            in_conn = iter->second->conn;
-          }
+      // Send reply
+      if ((pfe->mask & kWritable) && in_conn->is_ready_to_reply()) {
+        WriteStatus write_status = in_conn->SendReply();
+        if (write_status == kWriteAll) {
+          in_conn->set_is_reply(false);
+          net_multiplexer->NetModEvent(pfe->fd, 0, kReadable);  // Remove kWritable
+        } else if (write_status == kWriteHalf) {
+          continue;  //  send all write buffer,
+                     //  in case of next GetRequest()
+                     //  pollute the write buffer
+        } else if (write_status == kWriteError) {
+          should_close = true;
         }
+      }
 
-        // Send reply
-        if ((pfe->mask & kWritable) && in_conn->is_ready_to_reply()) {
+      // Client request again
+      if (!should_close && (pfe->mask & kReadable)) {
+        ReadStatus getRes = in_conn->GetRequest();
+        // Do not response to client when we leave the pub/sub status here
+        if (getRes != kReadAll && getRes != kReadHalf) {
+          // kReadError kReadClose kFullError kParseError kDealError
+          should_close = true;
+        } else if (in_conn->is_ready_to_reply()) {
           WriteStatus write_status = in_conn->SendReply();
           if (write_status == kWriteAll) {
             in_conn->set_is_reply(false);
-            net_multiplexer_->NetModEvent(pfe->fd, 0, kReadable);  // Remove kWritable
           } else if (write_status == kWriteHalf) {
-            continue;  //  send all write buffer,
-                       //  in case of next GetRequest()
-                       //  pollute the write buffer
+            net_multiplexer->NetModEvent(pfe->fd, kReadable, kWritable);
           } else if (write_status == kWriteError) {
             should_close = true;
           }
+        } else {
+          continue;
         }
-
-        // Client request again
-        if (!should_close && (pfe->mask & kReadable)) {
-          ReadStatus getRes = in_conn->GetRequest();
-          // Do not response to client when we leave the pub/sub status here
-          if (getRes != kReadAll && getRes != kReadHalf) {
-            // kReadError kReadClose kFullError kParseError kDealError
-            should_close = true;
-          } else if (in_conn->is_ready_to_reply()) {
-            WriteStatus write_status = in_conn->SendReply();
-            if (write_status == kWriteAll) {
-              in_conn->set_is_reply(false);
-            } else if (write_status == kWriteHalf) {
-              net_multiplexer_->NetModEvent(pfe->fd, kReadable, kWritable);
-            } else if (write_status == kWriteError) {
-              should_close = true;
-            }
-          } else {
-            continue;
-          }
-        }
-        // Error
-        if ((pfe->mask & kErrorEvent) || should_close) {
-          MoveConnOut(in_conn);
-          CloseFd(in_conn);
-          in_conn = nullptr;
-        }
+      }
+      // Error
+      if ((pfe->mask & kErrorEvent) || should_close) {
+        MoveConnOut(in_conn);
+        CloseFd(in_conn);
+        in_conn = nullptr;
       }
     }
+
+    SendDeliveries(shard);
   }
-  Cleanup();
-  return nullptr;
+  Cleanup(shard);
 }
 
-void PubSubThread::Cleanup() {
+void PubSubThread::Cleanup(Shard* shard) {
   std::lock_guard l(rwlock_);
-  for (auto& iter : conns_) {
-    CloseFd(iter.second->conn);
+  for (auto iter = conns_.begin(); iter != conns_.end();) {
+    if (ShardOf(iter->first) != shard) {
+      ++iter;
+      continue;
+    }
+    CloseFd(iter->second->conn);
+    iter = conns_.erase(iter);
   }
-  conns_.clear();
 }
+
 void PubSubThread::NotifyCloseAllConns() {
-  close_all_conn_sig_.store(true);
+  for (auto& shard : shards_) {
+    shard->close_all_conn_sig.store(true);
+  }
 }
 };  // namespace net
@@ -27,6 +27,14 @@ size_t NetworkStatistic::NetReplOutputBytes() {
   return stat_net_repl_output_bytes.load(std::memory_order_relaxed);
 }
 
+size_t NetworkStatistic::OutputBufferLimitCloses() {
+  return stat_output_buffer_limit_closes.load(std::memory_order_relaxed);
+}
+
+size_t NetworkStatistic::ReadPauses() {
+  return stat_read_pauses.load(std::memory_order_relaxed);
+}
+
 void NetworkStatistic::IncrRedisInputBytes(uint64_t bytes) {
   stat_net_input_bytes.fetch_add(bytes, std::memory_order_relaxed);
 }
@@ -43,4 +51,12 @@ void NetworkStatistic::IncrReplOutputBytes(uint64_t bytes) {
   stat_net_repl_output_bytes.fetch_add(bytes, std::memory_order_relaxed);
 }
 
+void NetworkStatistic::IncrOutputBufferLimitCloses() {
+  stat_output_buffer_limit_closes.fetch_add(1, std::memory_order_relaxed);
+}
+
+void NetworkStatistic::IncrReadPauses() {
+  stat_read_pauses.fetch_add(1, std::memory_order_relaxed);
+}
+
 }
\ No newline at end of file
@@ -10,6 +10,17 @@
 
 namespace net {
 
+static std::atomic<ThreadStartHook> thread_start_hook = nullptr;
+
+void SetThreadStartHook(ThreadStartHook hook) { thread_start_hook.store(hook); }
+
+void RunThreadStartHook(pthread_t id, const std::string& name) {
+  ThreadStartHook hook = thread_start_hook.load();
+  if (hook && !name.empty()) {
+    hook(id, name);
+  }
+}
+
 Thread::Thread() : should_stop_(false) {}
 
 Thread::~Thread() = default;
@@ -31,7 +42,11 @@ int Thread::StartThread() {
   should_stop_ = false;
   if (!running_) {
     running_ = true;
-    return pthread_create(&thread_id_, nullptr, RunThread, this);
+    int ret = pthread_create(&thread_id_, nullptr, RunThread, this);
+    if (ret == 0) {
+      RunThreadStartHook(thread_id_, thread_name_);
+    }
+    return ret;
   }
   return 0;
 }
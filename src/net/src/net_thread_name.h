@@ -29,6 +29,9 @@ inline bool SetThreadName(pthread_t id, const std::string& name) {
   return pthread_setname_np(name.c_str()) == 0;
 }
 #endif
+
+// runs the hook given to SetThreadStartHook, if any
+void RunThreadStartHook(pthread_t id, const std::string& name);
 }  // namespace net
 
 #endif
@@ -5,11 +5,14 @@
 
 #include "net/include/redis_conn.h"
 
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <sstream>
 
 #include <glog/logging.h>
 
+#include "net/include/buffer_pool.h"
 #include "net/include/net_stats.h"
 #include "pstd/include/pstd_string.h"
 #include "pstd/include/xdebug.h"
@@ -18,6 +21,9 @@ extern std::unique_ptr<net::NetworkStatistic> g_network_statistic;
 
 namespace net {
 
+// a reply buffer larger than this is freed once it is sent
+static const size_t kIdleReplyBufSize = 1024;
+
 RedisConn::RedisConn(const int fd, const std::string& ip_port, Thread* thread, NetMultiplexer* net_mpx,
                      const HandleType& handle_type, const int rbuf_max_len)
     : NetConn(fd, ip_port, thread, net_mpx),
@@ -32,7 +38,24 @@ RedisConn::RedisConn(const int fd, const std::string& ip_port, Thread* thread, N
   redis_parser_.data = this;
 }
 
-RedisConn::~RedisConn() { free(rbuf_); }
+RedisConn::~RedisConn() {
+  ReleaseReadBuffer();
+  ConnBufferPool()->AddReplyBytes(-static_cast<ptrdiff_t>(accounted_reply_bytes_));
+}
+
+void RedisConn::ReleaseReadBuffer() {
+  ConnBufferPool()->GiveBack(rbuf_, rbuf_len_);
+  rbuf_ = nullptr;
+  rbuf_len_ = 0;
+}
+
+void RedisConn::AccountReplyBuffer() {
+  size_t capacity = response_.capacity();
+  if (capacity != accounted_reply_bytes_) {
+    ConnBufferPool()->AddReplyBytes(static_cast<ptrdiff_t>(capacity) - static_cast<ptrdiff_t>(accounted_reply_bytes_));
+    accounted_reply_bytes_ = capacity;
+  }
+}
 
 ReadStatus RedisConn::ParseRedisParserStatus(RedisParserStatus status) {
   if (status == kRedisParserInitDone) {
@@ -63,27 +86,41 @@ ReadStatus RedisConn::ParseRedisParserStatus(RedisParserStatus status) {
 }
 
 ReadStatus RedisConn::GetRequest() {
+  ReadStatus read_status = ReadRequest();
+  // everything read was parsed, the parser keeps its own copy of a half
+  // command, so the buffer goes back until the conn is readable again
+  if (last_read_pos_ == -1) {
+    ReleaseReadBuffer();
+  }
+  return read_status;
+}
+
+ReadStatus RedisConn::ReadRequest() {
   ssize_t nread = 0;
   int next_read_pos = last_read_pos_ + 1;
 
   int64_t remain = rbuf_len_ - next_read_pos;  // Remain buffer size
   int64_t new_size = 0;
-  if (remain == 0) {
-    new_size = rbuf_len_ + REDIS_IOBUF_LEN;
-    remain += REDIS_IOBUF_LEN;
-  } else if (remain < bulk_len_) {
-    new_size = next_read_pos + bulk_len_;
-    remain = bulk_len_;
+  if (remain == 0 || remain < bulk_len_) {
+    // a fresh buffer fits the rest of a big bulk at once
+    remain = std::max<int64_t>(REDIS_IOBUF_LEN, bulk_len_);
+    new_size = next_read_pos + remain;
   }
   if (new_size > rbuf_len_) {
     if (new_size > rbuf_max_len_) {
       return kFullError;
     }
-    rbuf_ = static_cast<char*>(realloc(rbuf_, new_size));  // NOLINT
-    if (!rbuf_) {
+    size_t capacity = 0;
+    char* buf = ConnBufferPool()->Borrow(new_size, &capacity);
+    if (!buf) {
       return kFullError;
     }
-    rbuf_len_ = static_cast<int32_t>(new_size);
+    if (next_read_pos > 0) {
+      memcpy(buf, rbuf_, next_read_pos);
+    }
+    ReleaseReadBuffer();
+    rbuf_ = buf;
+    rbuf_len_ = static_cast<int32_t>(capacity);
   }
 
   nread = read(fd(), rbuf_ + next_read_pos, remain);
@@ -102,7 +139,6 @@ ReadStatus RedisConn::GetRequest() {
   g_network_statistic->IncrRedisInputBytes(nread);
   // assert(nread > 0);
   last_read_pos_ += static_cast<int32_t>(nread);
-  msg_peak_ = last_read_pos_;
   command_len_ += static_cast<int32_t> (nread);
   if (command_len_ >= rbuf_max_len_) {
     LOG(INFO) << "close conn command_len " << command_len_ << ", rbuf_max_len " << rbuf_max_len_;
@@ -137,17 +173,17 @@ WriteStatus RedisConn::SendReply() {
     wbuf_pos_ += nwritten;
     if (wbuf_pos_ == wbuf_len) {
       // Have sended all response data
-      if (wbuf_len > DEFAULT_WBUF_SIZE) {
-        std::string buf;
-        buf.reserve(DEFAULT_WBUF_SIZE);
-        response_.swap(buf);
+      if (response_.capacity() > kIdleReplyBufSize) {
+        std::string().swap(response_);
+      } else {
+        response_.clear();
       }
-      response_.clear();
 
       wbuf_len = 0;
       wbuf_pos_ = 0;
     }
   }
+  AccountReplyBuffer();
   if (nwritten == -1) {
     if (errno == EAGAIN || errno == EWOULDBLOCK) {
       return kWriteHalf;
@@ -165,22 +201,25 @@ WriteStatus RedisConn::SendReply() {
 
 int RedisConn::WriteResp(const std::string& resp) {
   response_.append(resp);
+  if (OutputBufferLimitReached()) {
+    LOG(WARNING) << "close conn " << String() << ", " << PendingReplyBytes()
+                 << " bytes of replies pending broke its output buffer limit";
+    g_network_statistic->IncrOutputBufferLimitCloses();
+    // the replies are dropped, the conn is closed once found writable
+    std::string().swap(response_);
+    wbuf_pos_ = 0;
+    SetClose(true);
+  }
+  AccountReplyBuffer();
   set_is_reply(true);
   return 0;
 }
 
 void RedisConn::TryResizeBuffer() {
-  struct timeval now;
-  gettimeofday(&now, nullptr);
-  time_t idletime = now.tv_sec - last_interaction().tv_sec;
-  if (rbuf_len_ > REDIS_MBULK_BIG_ARG && ((rbuf_len_ / (msg_peak_ + 1)) > 2 || idletime > 2)) {
-    int new_size = ((last_read_pos_ + REDIS_IOBUF_LEN) / REDIS_IOBUF_LEN) * REDIS_IOBUF_LEN;
-    if (new_size < rbuf_len_) {
-      rbuf_ = static_cast<char*>(realloc(rbuf_, new_size));
-      rbuf_len_ = new_size;
-      LOG(INFO) << "Resize buffer to " << rbuf_len_ << ", last_read_pos_: " << last_read_pos_;
-    }
-    msg_peak_ = 0;
+  // GetRequest gives the read buffer back itself, only a conn which failed
+  // in the middle of a read may still hold it
+  if (rbuf_ && last_read_pos_ == -1) {
+    ReleaseReadBuffer();
   }
 }
 
@@ -190,8 +229,24 @@ HandleType RedisConn::GetHandleType() { return handle_type_; }
 
 void RedisConn::ProcessRedisCmds(const std::vector<RedisCmdArgsType>& argvs, bool async, std::string* response) {}
 
-void RedisConn::NotifyEpoll(bool success) {
-  NetItem ti(fd(), ip_port(), success ? kNotiEpolloutAndEpollin : kNotiClose);
+void RedisConn::NotifyEpoll(bool success, bool try_send) {
+  NotifyType type = success ? kNotiEpolloutAndEpollin : kNotiClose;
+  // the worker thread does not touch the conn until notified, and what it
+  // has not sent yet is sent by it so as to keep the order of the replies
+  if (success && try_send && wbuf_pos_ == 0 && !IsClose()) {
+    if (SendReply() == kWriteAll) {
+      set_is_reply(false);
+      type = kNotiEpollin;
+    }
+  }
+  // not read again before its replies drain under the soft limit, the client
+  // can not pile up more of them meanwhile
+  if (type == kNotiEpolloutAndEpollin && OutputBufferFull()) {
+    set_reads_paused(true);
+    g_network_statistic->IncrReadPauses();
+    type = kNotiEpollout;
+  }
+  NetItem ti(fd(), ip_port(), type);
   net_multiplexer()->Register(ti, true);
 }
 
@@ -8,6 +8,9 @@
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <unistd.h>
+#if defined(__linux__)
+#  include <linux/filter.h>
+#endif
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -39,6 +42,16 @@ int ServerSocket::Listen(const std::string& bind_ip) {
   if (ret < 0) {
     return kSetSockOptError;
   }
+  if (reuse_port_) {
+#ifdef SO_REUSEPORT
+    ret = setsockopt(sockfd_, SOL_SOCKET, SO_REUSEPORT, &yes, sizeof(yes));
+    if (ret < 0) {
+      return kSetSockOptError;
+    }
+#else
+    return kSetSockOptError;
+#endif
+  }
 
   servaddr_.sin_family = AF_INET;
   if (bind_ip.empty()) {
@@ -66,6 +79,24 @@ int ServerSocket::Listen(const std::string& bind_ip) {
   return kSuccess;
 }
 
+int ServerSocket::SetCpuSteering(int group_size) {
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  if (!reuse_port_ || group_size <= 0) {
+    return -1;
+  }
+  // A = cpu; A %= group_size; return A
+  struct sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<uint32_t>(group_size)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  struct sock_fprog prog = {sizeof(code) / sizeof(code[0]), code};
+  return setsockopt(sockfd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0 ? -1 : 0;
+#else
+  return -1;
+#endif
+}
+
 int ServerSocket::SetNonBlock() {
   flags_ = Setnonblocking(sockfd());
   if (flags_ == -1) {
@@ -28,6 +28,13 @@ class ServerSocket : public pstd::noncopyable {
    */
   int Listen(const std::string& bind_ip = std::string());
 
+  /*
+   * Lets the kernel pick the listener of a SO_REUSEPORT group by the cpu
+   * which received the connection: cpu % group_size, in the order the
+   * listeners were bound. Linux only, return 0 if success, -1 otherwise
+   */
+  int SetCpuSteering(int group_size);
+
   void Close();
 
   /*
@@ -37,6 +44,10 @@ class ServerSocket : public pstd::noncopyable {
 
   int port() { return port_; }
 
+  // set before Listen, listeners bound to the same ip and port share the connections
+  void set_reuse_port(bool reuse_port) { reuse_port_ = reuse_port; }
+  bool reuse_port() const { return reuse_port_; }
+
   void set_keep_alive(bool keep_alive) { keep_alive_ = keep_alive; }
   bool keep_alive() const { return keep_alive_; }
 
@@ -65,6 +76,7 @@ class ServerSocket : public pstd::noncopyable {
   int tcp_send_buffer_{0};
   int tcp_recv_buffer_{0};
   bool keep_alive_{false};
+  bool reuse_port_{false};
   bool listening_{false};
   bool is_block_;
 
@@ -26,7 +26,9 @@ int ThreadPool::Worker::start() {
     } else {
       start_.store(true);
       std::string thread_id_str = std::to_string(reinterpret_cast<unsigned long>(thread_id_));
-      SetThreadName(thread_id_, thread_pool_->thread_pool_name() + "_Worker_" + thread_id_str);
+      std::string thread_name = thread_pool_->thread_pool_name() + "_Worker_" + thread_id_str;
+      SetThreadName(thread_id_, thread_name);
+      RunThreadStartHook(thread_id_, thread_name);
     }
   }
   return 0;
@@ -101,6 +103,16 @@ void ThreadPool::Schedule(TaskFunc func, void* arg) {
   }
 }
 
+bool ThreadPool::TrySchedule(TaskFunc func, void* arg) {
+  std::lock_guard lock(mu_);
+  if (queue_.size() >= max_queue_size_ || should_stop()) {
+    return false;
+  }
+  queue_.emplace(func, arg);
+  rsignal_.notify_one();
+  return true;
+}
+
 /*
  * timeout is in millisecond
  */
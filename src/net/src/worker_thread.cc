@@ -13,9 +13,13 @@
 #include "dispatch_thread.h"
 #include "net/include/net_conn.h"
 #include "net/src/net_item.h"
+#include "net/src/server_socket.h"
 
 namespace net {
 
+// conns accepted on a reuseport listener per poll of the worker
+static const int kMaxAcceptsPerPoll = 64;
+
 WorkerThread::WorkerThread(ConnFactory* conn_factory, ServerThread* server_thread, int queue_limit, int cron_interval)
     :
       server_thread_(server_thread),
@@ -71,10 +75,55 @@ bool WorkerThread::MoveConnIn(const std::shared_ptr<NetConn>& conn, const Notify
 
 bool WorkerThread::MoveConnIn(const NetItem& it, bool force) { return net_multiplexer_->Register(it, force); }
 
+void WorkerThread::AddListener(const std::shared_ptr<ServerSocket>& listener) {
+  server_sockets_.push_back(listener);
+  server_fds_.insert(listener->sockfd());
+  net_multiplexer_->NetAddEvent(listener->sockfd(), kReadable);
+}
+
+void WorkerThread::AcceptConns(int listen_fd) {
+  int connfd = -1;
+  std::string ip_port;
+  // bounded, the conns of this worker must not wait out a connect storm
+  for (int i = 0; i < kMaxAcceptsPerPoll; i++) {
+    if (!server_thread_->AcceptConn(listen_fd, &connfd, &ip_port)) {
+      return;
+    }
+    if (connfd == -1) {
+      continue;
+    }
+    if (server_thread_->log_net_activities_.load(std::memory_order::memory_order_relaxed)) {
+      LOG(INFO) << "accept new conn " << ip_port << " in worker " << thread_name();
+    }
+    NewConn(connfd, ip_port);
+  }
+}
+
+void WorkerThread::NewConn(int fd, const std::string& ip_port) {
+  std::shared_ptr<NetConn> tc =
+      conn_factory_->NewNetConn(fd, ip_port, server_thread_, private_data_, net_multiplexer_.get());
+  if (!tc || !tc->SetNonblock()) {
+    return;
+  }
+
+#ifdef __ENABLE_SSL
+  // Create SSL failed
+  if (server_thread_->security() && !tc->CreateSSL(server_thread_->ssl_ctx())) {
+    CloseFd(tc);
+    return;
+  }
+#endif
+
+  {
+    std::lock_guard lock(rwlock_);
+    conns_[fd] = tc;
+  }
+  net_multiplexer_->NetAddEvent(fd, kReadable);
+}
+
 void* WorkerThread::ThreadMain() {
   int nfds;
   NetFiredEvent* pfe = nullptr;
-  char bb[2048];
   NetItem ti;
 
 
@@ -111,49 +160,33 @@ void* WorkerThread::ThreadMain() {
       }
       if (pfe->fd == net_multiplexer_->NotifyReceiveFd()) {
         if ((pfe->mask & kReadable) != 0) {
-          auto nread = static_cast<int32_t>(read(net_multiplexer_->NotifyReceiveFd(), bb, 2048));
-          if (nread == 0) {
-            continue;
-          } else {
-            for (int32_t idx = 0; idx < nread; ++idx) {
-              NetItem ti = net_multiplexer_->NotifyQueuePop();
-              if (ti.notify_type() == kNotiConnect) {
-                std::shared_ptr<NetConn> tc = conn_factory_->NewNetConn(ti.fd(), ti.ip_port(), server_thread_,
-                                                                        private_data_, net_multiplexer_.get());
-                if (!tc || !tc->SetNonblock()) {
-                  continue;
-                }
-
-#ifdef __ENABLE_SSL
-                // Create SSL failed
-                if (server_thread_->security() && !tc->CreateSSL(server_thread_->ssl_ctx())) {
-                  CloseFd(tc);
-                  continue;
-                }
-#endif
-
-                {
-                  std::lock_guard lock(rwlock_);
-                  conns_[ti.fd()] = tc;
-                }
-                net_multiplexer_->NetAddEvent(ti.fd(), kReadable);
-              } else if (ti.notify_type() == kNotiClose) {
-                // should close?
-              } else if (ti.notify_type() == kNotiEpollout) {
-                net_multiplexer_->NetModEvent(ti.fd(), 0, kWritable);
-              } else if (ti.notify_type() == kNotiEpollin) {
-                net_multiplexer_->NetModEvent(ti.fd(), 0, kReadable);
-              } else if (ti.notify_type() == kNotiEpolloutAndEpollin) {
-                net_multiplexer_->NetModEvent(ti.fd(), 0, kReadable | kWritable);
-              } else if (ti.notify_type() == kNotiWait) {
-                // do not register events
-                net_multiplexer_->NetAddEvent(ti.fd(), 0);
-              }
+          net_multiplexer_->ClearNotify();
+          while (net_multiplexer_->NotifyQueuePop(&ti)) {
+            if (ti.notify_type() == kNotiConnect) {
+              NewConn(ti.fd(), ti.ip_port());
+            } else if (ti.notify_type() == kNotiClose) {
+              // should close?
+            } else if (ti.notify_type() == kNotiEpollout) {
+              net_multiplexer_->NetModEvent(ti.fd(), 0, kWritable);
+            } else if (ti.notify_type() == kNotiEpollin) {
+              net_multiplexer_->NetModEvent(ti.fd(), 0, kReadable);
+            } else if (ti.notify_type() == kNotiEpolloutAndEpollin) {
+              net_multiplexer_->NetModEvent(ti.fd(), 0, kReadable | kWritable);
+            } else if (ti.notify_type() == kNotiWait) {
+              // do not register events
+              net_multiplexer_->NetAddEvent(ti.fd(), 0);
             }
           }
         } else {
           continue;
         }
+      } else if (server_fds_.find(pfe->fd) != server_fds_.end()) {
+        if ((pfe->mask & kReadable) != 0) {
+          AcceptConns(pfe->fd);
+        } else if ((pfe->mask & kErrorEvent) != 0) {
+          LOG(WARNING) << "error on the listen fd " << pfe->fd << " of worker " << thread_name();
+          net_multiplexer_->NetDelEvent(pfe->fd, 0);
+        }
       } else {
         std::shared_ptr<NetConn> in_conn = nullptr;
         int should_close = 0;
@@ -174,11 +207,16 @@ void* WorkerThread::ThreadMain() {
           if (write_status == kWriteAll) {
             net_multiplexer_->NetModEvent(pfe->fd, 0, kReadable);
             in_conn->set_is_reply(false);
+            in_conn->set_reads_paused(false);
             if (in_conn->IsClose()) {
               should_close = 1;
               LOG(INFO) << "will close client connection " << in_conn->String();
             }
           } else if (write_status == kWriteHalf) {
+            if (in_conn->reads_paused() && !in_conn->OutputBufferFull()) {
+              in_conn->set_reads_paused(false);
+              net_multiplexer_->NetModEvent(pfe->fd, 0, kReadable | kWritable);
+            }
             continue;
           } else {
             should_close = 1;
@@ -213,6 +251,8 @@ void* WorkerThread::ThreadMain() {
     }    // for (int i = 0; i < nfds; i++)
   }      // while (!should_stop())
 
+  server_sockets_.clear();
+  server_fds_.clear();
   Cleanup();
   return nullptr;
 }
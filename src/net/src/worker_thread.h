@@ -26,6 +26,7 @@ class NetItem;
 class NetFiredEvent;
 class NetConn;
 class ConnFactory;
+class ServerSocket;
 
 class WorkerThread : public Thread {
  public:
@@ -45,6 +46,9 @@ class WorkerThread : public Thread {
 
   bool MoveConnIn(const NetItem& it, bool force);
 
+  // accept the conns of listener in this thread, called before StartThread
+  void AddListener(const std::shared_ptr<ServerSocket>& listener);
+
   NetMultiplexer* net_multiplexer() { return net_multiplexer_.get(); }
   bool TryKillConn(const std::string& ip_port);
 
@@ -72,9 +76,18 @@ class WorkerThread : public Thread {
 
   std::atomic<int> keepalive_timeout_;  // keepalive second
 
+  /*
+   * The SO_REUSEPORT listeners of this worker, if any
+   */
+  std::vector<std::shared_ptr<ServerSocket>> server_sockets_;
+  std::set<int> server_fds_;
+
   void* ThreadMain() override;
   void DoCronTask();
 
+  void AcceptConns(int listen_fd);
+  void NewConn(int fd, const std::string& ip_port);
+
   pstd::Mutex killer_mutex_;
   std::set<std::string> deleting_conn_ipport_;
 
@@ -0,0 +1,63 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "net/include/buffer_pool.h"
+
+#include "gtest/gtest.h"
+
+TEST(BufferPoolTest, SizeClasses) {
+  net::BufferPool pool;
+  size_t capacity = 0;
+  char* buf = pool.Borrow(1, &capacity);
+  ASSERT_NE(buf, nullptr);
+  ASSERT_EQ(capacity, net::BufferPool::kMinSize);
+  pool.GiveBack(buf, capacity);
+
+  buf = pool.Borrow(net::BufferPool::kMinSize + 1, &capacity);
+  ASSERT_EQ(capacity, 2 * net::BufferPool::kMinSize);
+  pool.GiveBack(buf, capacity);
+
+  buf = pool.Borrow(net::BufferPool::kMaxPooledSize, &capacity);
+  ASSERT_EQ(capacity, net::BufferPool::kMaxPooledSize);
+  pool.GiveBack(buf, capacity);
+}
+
+TEST(BufferPoolTest, ReuseAndAccounting) {
+  net::BufferPool pool;
+  size_t capacity = 0;
+  char* buf = pool.Borrow(100, &capacity);
+  ASSERT_EQ(pool.InUseBytes(), capacity);
+  ASSERT_EQ(pool.PooledBytes(), 0);
+  pool.GiveBack(buf, capacity);
+  ASSERT_EQ(pool.InUseBytes(), 0);
+  ASSERT_EQ(pool.PooledBytes(), capacity);
+
+  // the same class hands out the pooled buffer again
+  size_t again = 0;
+  ASSERT_EQ(pool.Borrow(200, &again), buf);
+  ASSERT_EQ(again, capacity);
+  ASSERT_EQ(pool.PooledBytes(), 0);
+  pool.GiveBack(buf, again);
+}
+
+TEST(BufferPoolTest, HugeAndOverLimitAreFreed) {
+  net::BufferPool pool(net::BufferPool::kMinSize);
+  size_t capacity = 0;
+  char* huge = pool.Borrow(net::BufferPool::kMaxPooledSize + 1, &capacity);
+  ASSERT_EQ(capacity, net::BufferPool::kMaxPooledSize + 1);
+  ASSERT_EQ(pool.InUseBytes(), capacity);
+  pool.GiveBack(huge, capacity);
+  ASSERT_EQ(pool.InUseBytes(), 0);
+  ASSERT_EQ(pool.PooledBytes(), 0);
+
+  size_t c1 = 0;
+  size_t c2 = 0;
+  char* b1 = pool.Borrow(1, &c1);
+  char* b2 = pool.Borrow(1, &c2);
+  pool.GiveBack(b1, c1);
+  pool.GiveBack(b2, c2);
+  // the limit only takes one of them
+  ASSERT_EQ(pool.PooledBytes(), net::BufferPool::kMinSize);
+}
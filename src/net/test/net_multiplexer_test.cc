@@ -0,0 +1,107 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "net/src/net_multiplexer.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "net/src/net_notify_queue.h"
+
+TEST(NetNotifyQueueTest, ProducersKeepTheirOrder) {
+  const int kProducers = 4;
+  const int kItems = 10000;
+  net::NetNotifyQueue queue;
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p] {
+      for (int i = 0; i < kItems; ++i) {
+        queue.Push(net::NetItem(i, std::to_string(p)));
+      }
+    });
+  }
+
+  std::vector<int> next(kProducers, 0);
+  int popped = 0;
+  net::NetItem item;
+  while (popped < kProducers * kItems) {
+    if (!queue.Pop(&item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    int p = std::stoi(item.ip_port());
+    ASSERT_EQ(item.fd(), next[p]);
+    ++next[p];
+    ++popped;
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  ASSERT_FALSE(queue.Pop(&item));
+  ASSERT_EQ(queue.Size(), 0);
+}
+
+TEST(NetMultiplexerTest, CoalescedNotify) {
+  std::unique_ptr<net::NetMultiplexer> mpx(net::CreateNetMultiplexer());
+  mpx->Initialize();
+
+  // only the first item finds the queue empty and wakes the poll
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(mpx->Register(net::NetItem(i, "127.0.0.1:9221", net::kNotiEpollin), true));
+  }
+  ASSERT_EQ(mpx->NetPoll(0), 1);
+  ASSERT_EQ(mpx->FiredEvents()[0].fd, mpx->NotifyReceiveFd());
+
+  mpx->ClearNotify();
+  net::NetItem item;
+  int popped = 0;
+  while (mpx->NotifyQueuePop(&item)) {
+    ASSERT_EQ(item.fd(), popped);
+    ++popped;
+  }
+  ASSERT_EQ(popped, 100);
+  ASSERT_EQ(mpx->NetPoll(0), 0);
+
+  // the queue went empty, the next item wakes the poll again
+  ASSERT_TRUE(mpx->Register(net::NetItem(100, "127.0.0.1:9221", net::kNotiEpollin), true));
+  ASSERT_EQ(mpx->NetPoll(0), 1);
+}
+
+TEST(NetMultiplexerTest, ItemsRegisteredWhilePopping) {
+  std::unique_ptr<net::NetMultiplexer> mpx(net::CreateNetMultiplexer());
+  mpx->Initialize();
+
+  ASSERT_TRUE(mpx->Register(net::NetItem(0, "127.0.0.1:9221", net::kNotiEpollin), true));
+  ASSERT_EQ(mpx->NetPoll(0), 1);
+  mpx->ClearNotify();
+  net::NetItem item;
+  ASSERT_TRUE(mpx->NotifyQueuePop(&item));
+  // registered after ClearNotify, left to the next poll which must wake up
+  ASSERT_TRUE(mpx->Register(net::NetItem(1, "127.0.0.1:9221", net::kNotiEpollin), true));
+  ASSERT_TRUE(mpx->Register(net::NetItem(2, "127.0.0.1:9221", net::kNotiEpollin), true));
+  ASSERT_FALSE(mpx->NotifyQueuePop(&item));
+
+  ASSERT_EQ(mpx->NetPoll(0), 1);
+  mpx->ClearNotify();
+  ASSERT_TRUE(mpx->NotifyQueuePop(&item));
+  ASSERT_EQ(item.fd(), 1);
+  ASSERT_TRUE(mpx->NotifyQueuePop(&item));
+  ASSERT_EQ(item.fd(), 2);
+  ASSERT_FALSE(mpx->NotifyQueuePop(&item));
+}
+
+TEST(NetMultiplexerTest, QueueLimit) {
+  std::unique_ptr<net::NetMultiplexer> mpx(net::CreateNetMultiplexer(2));
+  mpx->Initialize();
+
+  ASSERT_TRUE(mpx->Register(net::NetItem(0, "127.0.0.1:9221"), false));
+  ASSERT_TRUE(mpx->Register(net::NetItem(1, "127.0.0.1:9221"), false));
+  ASSERT_FALSE(mpx->Register(net::NetItem(2, "127.0.0.1:9221"), false));
+  ASSERT_TRUE(mpx->Register(net::NetItem(3, "127.0.0.1:9221"), true));
+}
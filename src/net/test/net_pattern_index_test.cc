@@ -0,0 +1,84 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "net/src/net_pattern_index.h"
+#include "pstd/include/pstd_string.h"
+
+namespace {
+
+std::vector<std::string> Match(const net::PatternIndex& index, const std::string& channel) {
+  std::vector<std::string> matched;
+  index.Match(channel, [&matched](const std::string& pattern) { matched.push_back(pattern); });
+  std::sort(matched.begin(), matched.end());
+  return matched;
+}
+
+}  // namespace
+
+TEST(PatternIndexTest, MatchesByPrefixAndGlob) {
+  net::PatternIndex index;
+  for (const auto& pattern : {"*", "news.*", "news.t?ch", "news.[ab]rt", "news.tech", "news", "sport.*", "a\\*b"}) {
+    ASSERT_TRUE(index.Add(pattern));
+  }
+  ASSERT_FALSE(index.Add("news.*"));
+  ASSERT_EQ(index.size(), 8);
+
+  ASSERT_EQ(Match(index, "news.tech"), (std::vector<std::string>{"*", "news.*", "news.t?ch", "news.tech"}));
+  ASSERT_EQ(Match(index, "news.art"), (std::vector<std::string>{"*", "news.*", "news.[ab]rt"}));
+  ASSERT_EQ(Match(index, "news"), (std::vector<std::string>{"*", "news"}));
+  ASSERT_EQ(Match(index, "new"), (std::vector<std::string>{"*"}));
+  ASSERT_EQ(Match(index, "a*b"), (std::vector<std::string>{"*", "a\\*b"}));
+  ASSERT_EQ(Match(index, ""), (std::vector<std::string>{"*"}));
+}
+
+TEST(PatternIndexTest, Remove) {
+  net::PatternIndex index;
+  ASSERT_TRUE(index.Add("news.*"));
+  ASSERT_TRUE(index.Add("news.tech"));
+  ASSERT_TRUE(index.Add("news.tech.*"));
+
+  ASSERT_TRUE(index.Remove("news.tech"));
+  ASSERT_FALSE(index.Remove("news.tech"));
+  ASSERT_FALSE(index.Remove("news.art"));
+  ASSERT_EQ(Match(index, "news.tech"), (std::vector<std::string>{"news.*"}));
+  ASSERT_EQ(Match(index, "news.tech.ai"), (std::vector<std::string>{"news.*", "news.tech.*"}));
+
+  ASSERT_TRUE(index.Remove("news.tech.*"));
+  ASSERT_TRUE(index.Remove("news.*"));
+  ASSERT_EQ(index.size(), 0);
+  ASSERT_TRUE(Match(index, "news.tech.ai").empty());
+
+  ASSERT_TRUE(index.Add("news.*"));
+  index.Clear();
+  ASSERT_EQ(index.size(), 0);
+  ASSERT_TRUE(Match(index, "news.tech").empty());
+}
+
+TEST(PatternIndexTest, AgreesWithStringMatch) {
+  const std::vector<std::string> patterns = {"*",     "a*",    "ab*",   "a?c",  "a[bc]*", "a[^b]c", "*c",
+                                             "abc",   "ab\\?", "a*b*c", "[a-c]", "?",     "ab[c",   "a\\"};
+  const std::vector<std::string> channels = {"", "a", "ab", "abc", "acc", "adc", "ab?", "abbc", "b", "ab[c", "a\\"};
+  net::PatternIndex index;
+  for (const auto& pattern : patterns) {
+    index.Add(pattern);
+  }
+  for (const auto& channel : channels) {
+    std::vector<std::string> expected;
+    for (const auto& pattern : patterns) {
+      if (pstd::stringmatchlen(pattern.data(), static_cast<int32_t>(pattern.size()), channel.data(),
+                               static_cast<int32_t>(channel.size()), 0) != 0) {
+        expected.push_back(pattern);
+      }
+    }
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(Match(index, channel), expected) << channel;
+  }
+}
@@ -0,0 +1,165 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "net/include/net_pubsub.h"
+#include "net/include/net_stats.h"
+#include "net/include/redis_conn.h"
+
+extern std::unique_ptr<net::NetworkStatistic> g_network_statistic;
+
+namespace {
+
+class TestConn : public net::RedisConn {
+ public:
+  explicit TestConn(int fd, uint64_t hard_bytes = 0)
+      : net::RedisConn(fd, "127.0.0.1:9221", nullptr, nullptr), hard_bytes_(hard_bytes) {}
+
+  int DealMessage(const net::RedisCmdArgsType& argv, std::string* response) override { return 0; }
+  const std::string& GetCurrentTable() override { return table_; }
+  net::OutputBufferLimit output_buffer_limit() override { return {hard_bytes_, 0, 0}; }
+
+ private:
+  std::string table_;
+  uint64_t hard_bytes_;
+};
+
+// reads what the peer of fd got, waiting up to a second for want bytes
+std::string ReadPeer(int fd, size_t want) {
+  std::string got;
+  char buf[256];
+  pollfd pfd{fd, POLLIN, 0};
+  while (got.size() < want && poll(&pfd, 1, 1000) > 0) {
+    ssize_t n = read(fd, buf, sizeof(buf));
+    if (n <= 0) {
+      break;
+    }
+    got.append(buf, n);
+  }
+  return got;
+}
+
+class PubSubTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!g_network_statistic) {
+      g_network_statistic = std::make_unique<net::NetworkStatistic>();
+    }
+    pubsub_ = std::make_unique<net::PubSubThread>(2);
+    ASSERT_EQ(pubsub_->StartThread(), 0);
+  }
+  void TearDown() override { pubsub_->StopThread(); }
+
+  // a subscriber ready for messages and the fd of its peer
+  std::pair<std::shared_ptr<TestConn>, int> Subscriber(const std::string& channel, bool pattern,
+                                                       uint64_t hard_bytes = 0) {
+    int fds[2];
+    EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    auto conn = std::make_shared<TestConn>(fds[0], hard_bytes);
+    std::vector<std::pair<std::string, int>> result;
+    pubsub_->Subscribe(conn, {channel}, pattern, &result);
+    pubsub_->UpdateConnReadyState(conn->fd(), net::PubSubThread::ReadyState::kReady);
+    return {conn, fds[1]};
+  }
+
+  std::unique_ptr<net::PubSubThread> pubsub_;
+};
+
+}  // namespace
+
+TEST_F(PubSubTest, PublishFansOutOverShards) {
+  std::vector<std::pair<std::shared_ptr<TestConn>, int>> subscribers;
+  for (int i = 0; i < 4; ++i) {
+    subscribers.push_back(Subscriber("news", false));
+  }
+
+  ASSERT_EQ(pubsub_->Publish("news", "hello"), 4);
+  const std::string resp = "*3\r\n$7\r\nmessage\r\n$4\r\nnews\r\n$5\r\nhello\r\n";
+  for (auto& [conn, peer] : subscribers) {
+    ASSERT_EQ(ReadPeer(peer, resp.size()), resp);
+    close(peer);
+  }
+}
+
+TEST_F(PubSubTest, PublishMatchesPatterns) {
+  auto [channel_conn, channel_peer] = Subscriber("news.tech", false);
+  auto [pattern_conn, pattern_peer] = Subscriber("news.*", true);
+
+  ASSERT_EQ(pubsub_->Publish("news.tech", "hi"), 2);
+  ASSERT_EQ(pubsub_->Publish("news.art", "hi"), 1);
+
+  const std::string message = "*3\r\n$7\r\nmessage\r\n$9\r\nnews.tech\r\n$2\r\nhi\r\n";
+  ASSERT_EQ(ReadPeer(channel_peer, message.size()), message);
+  const std::string pmessages =
+      "*4\r\n$8\r\npmessage\r\n$6\r\nnews.*\r\n$9\r\nnews.tech\r\n$2\r\nhi\r\n"
+      "*4\r\n$8\r\npmessage\r\n$6\r\nnews.*\r\n$8\r\nnews.art\r\n$2\r\nhi\r\n";
+  ASSERT_EQ(ReadPeer(pattern_peer, pmessages.size()), pmessages);
+  close(channel_peer);
+  close(pattern_peer);
+}
+
+TEST_F(PubSubTest, NotReadySubscribersGetNothing) {
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  auto conn = std::make_shared<TestConn>(fds[0]);
+  std::vector<std::pair<std::string, int>> result;
+  pubsub_->Subscribe(conn, {"news"}, false, &result);
+
+  ASSERT_EQ(pubsub_->Publish("news", "hello"), 0);
+  ASSERT_EQ(pubsub_->Publish("other", "hello"), 0);
+  close(fds[1]);
+}
+
+TEST_F(PubSubTest, UnsubscribedPatternsStopMatching) {
+  auto [conn, peer] = Subscriber("news.*", true);
+  std::vector<std::pair<std::string, int>> result;
+  pubsub_->Subscribe(conn, {"sport.*", "news"}, true, &result);
+  pubsub_->Subscribe(conn, {"news"}, false, &result);
+  ASSERT_EQ(pubsub_->ClientPubSubChannelPatternSize(conn), 3);
+  ASSERT_EQ(pubsub_->ClientPubSubChannelSize(conn), 1);
+  ASSERT_EQ(pubsub_->PubSubNumPat(), 3);
+
+  result.clear();
+  ASSERT_EQ(pubsub_->UnSubscribe(conn, {"news.*", "art.*"}, true, &result), 3);
+  ASSERT_EQ(result, (std::vector<std::pair<std::string, int>>{{"news.*", 3}, {"art.*", 0}}));
+  ASSERT_EQ(pubsub_->Publish("news.tech", "hi"), 0);
+  ASSERT_EQ(pubsub_->Publish("sport.ski", "hi"), 1);
+  // the channel and the literal pattern both match
+  ASSERT_EQ(pubsub_->Publish("news", "hi"), 2);
+
+  result.clear();
+  ASSERT_EQ(pubsub_->UnSubscribe(conn, {}, true, &result), 0);
+  ASSERT_EQ(result, (std::vector<std::pair<std::string, int>>{{"news", 2}, {"sport.*", 1}}));
+  ASSERT_EQ(pubsub_->ClientPubSubChannelPatternSize(conn), 0);
+  ASSERT_EQ(pubsub_->ClientPubSubChannelSize(conn), 0);
+  ASSERT_EQ(pubsub_->Publish("sport.ski", "hi"), 0);
+  close(peer);
+}
+
+TEST_F(PubSubTest, QueuedMessagesOverLimitCloseTheConn) {
+  auto [conn, peer] = Subscriber("news", false, 16);
+  auto [other_conn, other_peer] = Subscriber("news", false);
+
+  ASSERT_EQ(pubsub_->Publish("news", "hello"), 2);
+  const std::string resp = "*3\r\n$7\r\nmessage\r\n$4\r\nnews\r\n$5\r\nhello\r\n";
+  ASSERT_EQ(ReadPeer(other_peer, resp.size()), resp);
+  // the message alone is above the limit, the conn is closed without it
+  ASSERT_EQ(ReadPeer(peer, resp.size()), "");
+  ASSERT_FALSE(pubsub_->IsReady(conn->fd()));
+  ASSERT_EQ(pubsub_->Publish("news", "hello"), 1);
+  ASSERT_EQ(ReadPeer(other_peer, resp.size()), resp);
+  close(peer);
+  close(other_peer);
+}
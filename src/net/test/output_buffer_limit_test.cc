@@ -0,0 +1,123 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "net/include/net_stats.h"
+#include "net/include/redis_conn.h"
+#include "net/src/net_multiplexer.h"
+
+extern std::unique_ptr<net::NetworkStatistic> g_network_statistic;
+
+namespace {
+
+class TestConn : public net::RedisConn {
+ public:
+  TestConn(int fd, net::NetMultiplexer* mpx) : net::RedisConn(fd, "127.0.0.1:9221", nullptr, mpx) {}
+
+  int DealMessage(const net::RedisCmdArgsType& argv, std::string* response) override { return 0; }
+  const std::string& GetCurrentTable() override { return table_; }
+  net::OutputBufferLimit output_buffer_limit() override { return limit; }
+
+  net::OutputBufferLimit limit;
+
+ private:
+  std::string table_;
+};
+
+class OutputBufferLimitTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!g_network_statistic) {
+      g_network_statistic = std::make_unique<net::NetworkStatistic>();
+    }
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds_), 0);
+  }
+  void TearDown() override {
+    close(fds_[0]);
+    close(fds_[1]);
+  }
+
+  int fds_[2] = {-1, -1};
+};
+
+}  // namespace
+
+TEST_F(OutputBufferLimitTest, HardLimitCloses) {
+  TestConn conn(fds_[0], nullptr);
+  conn.limit.hard_bytes = 100;
+  conn.WriteResp(std::string(100, 'a'));
+  ASSERT_FALSE(conn.IsClose());
+  ASSERT_EQ(conn.PendingReplyBytes(), 100);
+
+  size_t closes = g_network_statistic->OutputBufferLimitCloses();
+  conn.WriteResp("b");
+  ASSERT_TRUE(conn.IsClose());
+  // the replies are dropped rather than sent
+  ASSERT_EQ(conn.PendingReplyBytes(), 0);
+  ASSERT_EQ(g_network_statistic->OutputBufferLimitCloses(), closes + 1);
+}
+
+TEST_F(OutputBufferLimitTest, SoftLimitCloses) {
+  TestConn conn(fds_[0], nullptr);
+  conn.limit.soft_bytes = 10;
+  conn.limit.soft_seconds = 1;
+  conn.WriteResp(std::string(20, 'a'));
+  ASSERT_FALSE(conn.IsClose());
+  ASSERT_TRUE(conn.OutputBufferFull());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+  conn.WriteResp("b");
+  ASSERT_TRUE(conn.IsClose());
+}
+
+TEST_F(OutputBufferLimitTest, SoftLimitClockRestarts) {
+  TestConn conn(fds_[0], nullptr);
+  conn.limit.soft_bytes = 10;
+  conn.limit.soft_seconds = 1;
+  conn.WriteResp(std::string(20, 'a'));
+  ASSERT_EQ(conn.SendReply(), net::kWriteAll);
+  ASSERT_FALSE(conn.OutputBufferFull());
+
+  // below the soft limit in between, the time above it counts from scratch
+  std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+  conn.WriteResp("b");
+  conn.WriteResp(std::string(20, 'a'));
+  ASSERT_FALSE(conn.IsClose());
+}
+
+TEST_F(OutputBufferLimitTest, FullOutputBufferPausesReads) {
+  std::unique_ptr<net::NetMultiplexer> mpx(net::CreateNetMultiplexer());
+  mpx->Initialize();
+  TestConn conn(fds_[0], mpx.get());
+  conn.limit.soft_bytes = 10;
+
+  conn.WriteResp(std::string(5, 'a'));
+  conn.NotifyEpoll(true);
+  net::NetItem item;
+  ASSERT_EQ(mpx->NetPoll(0), 1);
+  mpx->ClearNotify();
+  ASSERT_TRUE(mpx->NotifyQueuePop(&item));
+  ASSERT_EQ(item.notify_type(), net::kNotiEpolloutAndEpollin);
+  ASSERT_FALSE(conn.reads_paused());
+
+  conn.WriteResp(std::string(20, 'a'));
+  conn.NotifyEpoll(true);
+  ASSERT_EQ(mpx->NetPoll(0), 1);
+  mpx->ClearNotify();
+  ASSERT_TRUE(mpx->NotifyQueuePop(&item));
+  ASSERT_EQ(item.notify_type(), net::kNotiEpollout);
+  ASSERT_TRUE(conn.reads_paused());
+  // soft seconds 0 never closes
+  ASSERT_FALSE(conn.IsClose());
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "net/include/thread_pool.h"
+
+namespace {
+
+std::atomic<int> g_done = 0;
+
+void WaitTask(void* arg) {
+  static_cast<std::shared_future<void>*>(arg)->wait();
+  ++g_done;
+}
+
+void CountTask(void* arg) { ++g_done; }
+
+}  // namespace
+
+TEST(ThreadPoolTest, TryScheduleDoesNotWaitForRoom) {
+  g_done = 0;
+  net::ThreadPool pool(1, 1);
+  ASSERT_EQ(pool.start_thread_pool(), net::kSuccess);
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  ASSERT_TRUE(pool.TrySchedule(&WaitTask, &released));
+  // the worker takes the first task off the queue and waits in it
+  size_t qsize = 1;
+  for (int i = 0; i < 100 && qsize != 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pool.cur_queue_size(&qsize);
+  }
+  ASSERT_EQ(qsize, 0);
+  ASSERT_TRUE(pool.TrySchedule(&CountTask, nullptr));
+  ASSERT_FALSE(pool.TrySchedule(&CountTask, nullptr));
+
+  release.set_value();
+  for (int i = 0; i < 100 && g_done != 2; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(g_done, 2);
+  ASSERT_TRUE(pool.TrySchedule(&CountTask, nullptr));
+
+  pool.stop_thread_pool();
+  ASSERT_FALSE(pool.TrySchedule(&CountTask, nullptr));
+}
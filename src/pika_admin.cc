@@ -20,6 +20,8 @@
 #include "include/pika_server.h"
 #include "include/pika_version.h"
 #include "include/pika_conf.h"
+#include "include/pika_repl_compression.h"
+#include "net/include/buffer_pool.h"
 #include "pstd/include/rsync.h"
 #include "include/throttle.h"
 using pstd::Status;
@@ -113,7 +115,7 @@ void SlaveofCmd::DoInitial() {
     return;
   }
   // self is master of A , want to slaveof B
-  if ((g_pika_server->role() & PIKA_ROLE_MASTER) != 0) {
+  if ((g_pika_server->role() & PIKA_ROLE_MASTER) != 0 && !g_pika_conf->slave_serve_slaves()) {
     res_.SetRes(CmdRes::kErrOther, "already master of others, invalid usage");
     return;
   }
@@ -183,7 +185,8 @@ void DbSlaveofCmd::DoInitial() {
     res_.SetRes(CmdRes::kWrongNum, kCmdNameDbSlaveof);
     return;
   }
-  if (((g_pika_server->role() ^ PIKA_ROLE_SLAVE) != 0) || !g_pika_server->MetaSyncDone()) {
+  // a slave in a chain is also the master of its own slaves
+  if (((g_pika_server->role() & PIKA_ROLE_SLAVE) == 0) || !g_pika_server->MetaSyncDone()) {
     res_.SetRes(CmdRes::kErrOther, "Not currently a slave");
     return;
   }
@@ -1060,6 +1063,10 @@ void InfoCmd::InfoClients(std::string& info) {
   tmp_stream << "# Clients"
              << "\r\n";
   tmp_stream << "connected_clients:" << g_pika_server->ClientList() << "\r\n";
+  net::BufferPool* buffer_pool = net::ConnBufferPool();
+  tmp_stream << "client_read_buffer_in_use_bytes:" << buffer_pool->InUseBytes() << "\r\n";
+  tmp_stream << "client_read_buffer_pooled_bytes:" << buffer_pool->PooledBytes() << "\r\n";
+  tmp_stream << "client_reply_buffer_bytes:" << buffer_pool->ReplyBytes() << "\r\n";
 
   info.append(tmp_stream.str());
 }
@@ -1073,6 +1080,14 @@ void InfoCmd::InfoStats(std::string& info) {
   tmp_stream << "total_commands_processed:" << g_pika_server->ServerQueryNum() << "\r\n";
   tmp_stream << "keyspace_hits:" << g_pika_server->ServerKeyspaceHits() << "\r\n";
   tmp_stream << "keyspace_misses:" << g_pika_server->ServerKeyspaceMisses() << "\r\n";
+  tmp_stream << "total_split_pipelines:" << g_pika_server->SplitPipelines() << "\r\n";
+  tmp_stream << "total_split_pipeline_segments:" << g_pika_server->SplitPipelineSegments() << "\r\n";
+  PikaAdmissionController* admission_controller = g_pika_server->admission_controller();
+  tmp_stream << "total_busy_rejected_cmds:" << admission_controller->RejectedCmds() << "\r\n";
+  tmp_stream << "fast_cmd_pool_overloaded:"
+             << (admission_controller->Overloaded(PikaAdmissionController::kFastPool) ? "Yes" : "No") << "\r\n";
+  tmp_stream << "slow_cmd_pool_overloaded:"
+             << (admission_controller->Overloaded(PikaAdmissionController::kSlowPool) ? "Yes" : "No") << "\r\n";
 
   // Network stats
   tmp_stream << "total_net_input_bytes:" << g_pika_server->NetInputBytes() + g_pika_server->NetReplInputBytes()
@@ -1085,6 +1100,8 @@ void InfoCmd::InfoStats(std::string& info) {
   tmp_stream << "instantaneous_output_kbps:" << g_pika_server->InstantaneousOutputKbps() << "\r\n";
   tmp_stream << "instantaneous_input_repl_kbps:" << g_pika_server->InstantaneousInputReplKbps() << "\r\n";
   tmp_stream << "instantaneous_output_repl_kbps:" << g_pika_server->InstantaneousOutputReplKbps() << "\r\n";
+  tmp_stream << "client_output_buffer_limit_disconnections:" << g_pika_server->OutputBufferLimitCloses() << "\r\n";
+  tmp_stream << "total_client_read_pauses:" << g_pika_server->ClientReadPauses() << "\r\n";
 
   tmp_stream << "is_bgsaving:" << (g_pika_server->IsBgSaving() ? "Yes" : "No") << "\r\n";
   tmp_stream << "is_scaning_keyspace:" << (g_pika_server->IsKeyScaning() ? "Yes" : "No") << "\r\n";
@@ -1149,6 +1166,14 @@ void InfoCmd::InfoCPU(std::string& info) {
   tmp_stream << "used_cpu_user_children:" << std::setiosflags(std::ios::fixed) << std::setprecision(2)
              << static_cast<float>(c_ru.ru_utime.tv_sec) + static_cast<float>(c_ru.ru_utime.tv_usec) / 1000000
              << "\r\n";
+  for (const auto& usage : g_pika_server->thread_placement()->Usage()) {
+    std::string group = usage.group;
+    std::replace(group.begin(), group.end(), '-', '_');
+    // the cpu list may hold commas, it gets a line of its own
+    tmp_stream << "thread_group_" << group << ":threads=" << usage.threads << ",used_cpu=" << std::setprecision(2)
+               << usage.used_cpu << "\r\n";
+    tmp_stream << "thread_group_" << group << "_cpus:" << usage.cpus << "\r\n";
+  }
   info.append(tmp_stream.str());
 }
 
@@ -1279,8 +1304,28 @@ void InfoCmd::InfoReplication(std::string& info) {
     tmp_stream << db_name << ":binlog_offset=" << filenum << " " << offset;
     s = master_db->GetSafetyPurgeBinlog(&safety_purge);
     tmp_stream << ",safety_purge=" << (s.ok() ? safety_purge : "error") << "\r\n";
+    std::shared_ptr<BinlogTail> tail = master_db->Logger()->tail();
+    tmp_stream << db_name << "_binlog_tail:items=" << tail->ItemsNum() << ",bytes=" << tail->Bytes()
+               << ",hits=" << tail->Hits() << ",misses=" << tail->Misses() << "\r\n";
   }
   tmp_stream << "slave_repl_offset:" << slave_repl_offset << "\r\n";
+  // binlog sync compressed to slaves and uncompressed from the master
+  auto compression_stats = [&tmp_stream](const char* name, ReplCompressionStats* stats) {
+    uint64_t raw_bytes = stats->raw_bytes;
+    uint64_t wire_bytes = stats->wire_bytes;
+    tmp_stream << name << ":raw_bytes=" << raw_bytes << ",wire_bytes=" << wire_bytes << ",ratio=" << std::fixed
+               << std::setprecision(2) << (wire_bytes == 0 ? 1.0 : static_cast<double>(raw_bytes) / wire_bytes)
+               << ",cpu_us=" << stats->cpu_us << "\r\n";
+  };
+  tmp_stream << "replication_compression:" << g_pika_conf->replication_compression() << "\r\n";
+  compression_stats("binlog_compress", g_pika_rm->ReplServerCompressionStats());
+  compression_stats("binlog_uncompress", g_pika_rm->ReplClientCompressionStats());
+  PikaReplApplyScheduler* apply_scheduler = g_pika_rm->ReplClientApplyScheduler();
+  tmp_stream << "repl_apply:inflight=" << apply_scheduler->InflightNum()
+             << ",scheduled=" << apply_scheduler->ScheduledNum()
+             << ",conflicts=" << apply_scheduler->ConflictNum()
+             << ",groups=" << apply_scheduler->GroupsNum()
+             << ",grouped_cmds=" << apply_scheduler->GroupedCmdsNum() << "\r\n";
   info.append(tmp_stream.str());
 }
 
@@ -1484,6 +1529,25 @@ void InfoCmd::InfoCache(std::string& info, std::shared_ptr<DB> db) {
     tmp_stream << "hitratio_all:" << std::setprecision(4) << cache_info.hitratio_all << "%" << "\r\n";
     tmp_stream << "load_keys_per_sec:" << cache_info.load_keys_per_sec << "\r\n";
     tmp_stream << "waitting_load_keys_num:" << cache_info.waitting_load_keys_num << "\r\n";
+    tmp_stream << "invalidate_pending_keys_num:" << cache_info.invalidate_pending_keys_num << "\r\n";
+    tmp_stream << "invalidated_keys_num:" << cache_info.invalidated_keys_num << "\r\n";
+    tmp_stream << "negative_keys_num:" << cache_info.negative_keys_num << "\r\n";
+    tmp_stream << "negative_hits:" << cache_info.negative_hits << "\r\n";
+    tmp_stream << "negative_misses:" << cache_info.negative_misses << "\r\n";
+    tmp_stream << "write_behind_pending_keys:" << db->cache_write_behind()->PendingKeysNum() << "\r\n";
+    tmp_stream << "write_behind_coalesced_incrs:" << db->cache_write_behind()->CoalescedIncrsNum() << "\r\n";
+    tmp_stream << "write_behind_flushed_keys:" << db->cache_write_behind()->FlushedKeysNum() << "\r\n";
+    // estimated usage, refreshed by the cache cron task
+    for (size_t i = 0; i < cache_info.type_used_memory.size(); ++i) {
+      tmp_stream << "cache_type_" << PIKA_CACHE_TYPE_NAMES[i] << ":keys=" << cache_info.type_keys_num[i]
+                 << ",memory=" << cache_info.type_used_memory[i]
+                 << ",budget_percent=" << g_pika_conf->cache_type_maxmemory_percent(static_cast<int>(i))
+                 << ",rejected_keys=" << cache_info.type_rejected_keys_num[i] << "\r\n";
+    }
+    for (size_t i = 0; i < cache_info.shard_keys_num.size(); ++i) {
+      tmp_stream << "cache_shard_" << i << ":keys=" << cache_info.shard_keys_num[i]
+                 << ",memory=" << cache_info.shard_used_memory[i] << "\r\n";
+    }
   }
   info.append(tmp_stream.str());
 }
@@ -1610,6 +1674,24 @@ void ConfigCmd::ConfigGet(std::string& ret) {
     EncodeNumber(&config_body, g_pika_conf->thread_num());
   }
 
+  if (pstd::stringmatch(pattern.data(), "reuse-port", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "reuse-port");
+    EncodeString(&config_body, g_pika_conf->reuse_port() ? "yes" : "no");
+  }
+
+  if (pstd::stringmatch(pattern.data(), "reuse-port-cpu-steering", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "reuse-port-cpu-steering");
+    EncodeString(&config_body, g_pika_conf->reuse_port_cpu_steering() ? "yes" : "no");
+  }
+
+  if (pstd::stringmatch(pattern.data(), "thread-placement", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "thread-placement");
+    EncodeString(&config_body, g_pika_conf->thread_placement());
+  }
+
   if (pstd::stringmatch(pattern.data(), "thread-pool-size", 1) != 0) {
     elements += 2;
     EncodeString(&config_body, "thread-pool-size");
@@ -1628,6 +1710,12 @@ void ConfigCmd::ConfigGet(std::string& ret) {
     EncodeNumber(&config_body, g_pika_conf->admin_thread_pool_size());
   }
 
+  if (pstd::stringmatch(pattern.data(), "pubsub-thread-num", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "pubsub-thread-num");
+    EncodeNumber(&config_body, g_pika_conf->pubsub_thread_num());
+  }
+
   if (pstd::stringmatch(pattern.data(), "userblacklist", 1) != 0) {
     elements += 2;
     EncodeString(&config_body, "userblacklist");
@@ -1745,6 +1833,12 @@ void ConfigCmd::ConfigGet(std::string& ret) {
     EncodeString(&config_body, g_pika_conf->slow_cmd_pool() ? "yes" : "no");
   }
 
+  if (pstd::stringmatch(pattern.data(), "split-pipeline", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "split-pipeline");
+    EncodeString(&config_body, g_pika_conf->split_pipeline() ? "yes" : "no");
+  }
+
   if (pstd::stringmatch(pattern.data(), "slotmigrate-thread-num", 1)!= 0) {
     elements += 2;
     EncodeString(&config_body, "slotmigrate-thread-num");
@@ -1919,6 +2013,12 @@ void ConfigCmd::ConfigGet(std::string& ret) {
     EncodeNumber(&config_body, g_pika_conf->slowlog_slower_than());
   }
 
+  if (pstd::stringmatch(pattern.data(), "admission-queue-target-us", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "admission-queue-target-us");
+    EncodeNumber(&config_body, g_pika_conf->admission_queue_target_us());
+  }
+
   if (pstd::stringmatch(pattern.data(), "slowlog-max-len", 1) != 0) {
     elements += 2;
     EncodeString(&config_body, "slowlog-max-len");
@@ -2030,6 +2130,12 @@ void ConfigCmd::ConfigGet(std::string& ret) {
     EncodeNumber(&config_body, g_pika_conf->slave_priority());
   }
 
+  if (pstd::stringmatch(pattern.data(), "slave-serve-slaves", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "slave-serve-slaves");
+    EncodeString(&config_body, g_pika_conf->slave_serve_slaves() ? "yes" : "no");
+  }
+
   // fake string for redis-benchmark
   if (pstd::stringmatch(pattern.data(), "save", 1) != 0) {
     elements += 2;
@@ -2049,12 +2155,66 @@ void ConfigCmd::ConfigGet(std::string& ret) {
     EncodeNumber(&config_body, g_pika_conf->sync_window_size());
   }
 
+  if (pstd::stringmatch(pattern.data(), "binlog-tail-cache-size", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "binlog-tail-cache-size");
+    EncodeNumber(&config_body, g_pika_conf->binlog_tail_cache_size());
+  }
+
+  if (pstd::stringmatch(pattern.data(), "binlog-format", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "binlog-format");
+    EncodeString(&config_body, g_pika_conf->binlog_format());
+  }
+
+  if (pstd::stringmatch(pattern.data(), "binlog-checksum", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "binlog-checksum");
+    EncodeString(&config_body, g_pika_conf->binlog_checksum() ? "yes" : "no");
+  }
+
+  if (pstd::stringmatch(pattern.data(), "replication-compression", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "replication-compression");
+    EncodeString(&config_body, g_pika_conf->replication_compression());
+  }
+
+  if (pstd::stringmatch(pattern.data(), "replication-compression-level", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "replication-compression-level");
+    EncodeNumber(&config_body, g_pika_conf->replication_compression_level());
+  }
+
+  if (pstd::stringmatch(pattern.data(), "replication-apply-batch-cmds", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "replication-apply-batch-cmds");
+    EncodeNumber(&config_body, g_pika_conf->replication_apply_batch_cmds());
+  }
+
+  if (pstd::stringmatch(pattern.data(), "replication-apply-batch-bytes", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "replication-apply-batch-bytes");
+    EncodeNumber(&config_body, g_pika_conf->replication_apply_batch_bytes());
+  }
+
   if (pstd::stringmatch(pattern.data(), "max-conn-rbuf-size", 1) != 0) {
     elements += 2;
     EncodeString(&config_body, "max-conn-rbuf-size");
     EncodeNumber(&config_body, g_pika_conf->max_conn_rbuf_size());
   }
 
+  if (pstd::stringmatch(pattern.data(), "reply-direct-write", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "reply-direct-write");
+    EncodeString(&config_body, g_pika_conf->reply_direct_write() ? "yes" : "no");
+  }
+
+  if (pstd::stringmatch(pattern.data(), "client-output-buffer-limit", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "client-output-buffer-limit");
+    EncodeString(&config_body, g_pika_conf->client_output_buffer_limit_string());
+  }
+
   if (pstd::stringmatch(pattern.data(), "replication-num", 1) != 0) {
     elements += 2;
     EncodeString(&config_body, "replication-num");
@@ -2204,6 +2364,18 @@ void ConfigCmd::ConfigGet(std::string& ret) {
     EncodeNumber(&config_body, g_pika_conf->max_rsync_parallel_num());
   }
 
+  if (pstd::stringmatch(pattern.data(), "max-rsync-window-num", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "max-rsync-window-num");
+    EncodeNumber(&config_body, g_pika_conf->max_rsync_window_num());
+  }
+
+  if (pstd::stringmatch(pattern.data(), "dbsync-streaming", 1) != 0) {
+    elements += 2;
+    EncodeString(&config_body, "dbsync-streaming");
+    EncodeString(&config_body, g_pika_conf->dbsync_streaming() ? "yes" : "no");
+  }
+
   if (pstd::stringmatch(pattern.data(), "replication-id", 1) != 0) {
     elements += 2;
     EncodeString(&config_body, "replication-id");
@@ -2265,6 +2437,30 @@ void ConfigCmd::ConfigGet(std::string& ret) {
     EncodeNumber(&config_body, g_pika_conf->cache_lfu_decay_time());
   }
 
+  if (pstd::stringmatch(pattern.data(), "slave-cache-invalidate", 1)) {
+    elements += 2;
+    EncodeString(&config_body, "slave-cache-invalidate");
+    EncodeString(&config_body, g_pika_conf->slave_cache_invalidate() ? "yes" : "no");
+  }
+
+  if (pstd::stringmatch(pattern.data(), "cache-type-maxmemory-percent", 1)) {
+    elements += 2;
+    EncodeString(&config_body, "cache-type-maxmemory-percent");
+    EncodeString(&config_body, g_pika_conf->cache_type_maxmemory_percent_string());
+  }
+
+  if (pstd::stringmatch(pattern.data(), "cache-counter-write-behind-ms", 1)) {
+    elements += 2;
+    EncodeString(&config_body, "cache-counter-write-behind-ms");
+    EncodeNumber(&config_body, g_pika_conf->cache_counter_write_behind_ms());
+  }
+
+  if (pstd::stringmatch(pattern.data(), "cache-negative-ttl-ms", 1)) {
+    elements += 2;
+    EncodeString(&config_body, "cache-negative-ttl-ms");
+    EncodeNumber(&config_body, g_pika_conf->cache_negative_ttl_ms());
+  }
+
   if (pstd::stringmatch(pattern.data(), "acl-pubsub-default", 1) != 0) {
     elements += 2;
     EncodeString(&config_body, "acl-pubsub-default");
@@ -2299,6 +2495,7 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
         "masterauth",
         "slotmigrate",
         "slow-cmd-pool",
+        "split-pipeline",
         "slotmigrate-thread-num",
         "thread-migrate-keys-num",
         "userpass",
@@ -2311,6 +2508,8 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
         "root-connection-num",
         "slowlog-write-errorlog",
         "slowlog-log-slower-than",
+        "admission-queue-target-us",
+        "thread-placement",
         "slowlog-max-len",
         "write-binlog",
         "max-cache-statistic-keys",
@@ -2322,7 +2521,15 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
         "compact-interval",
         "disable_auto_compactions",
         "slave-priority",
+        "slave-serve-slaves",
         "sync-window-size",
+        "binlog-tail-cache-size",
+        "binlog-format",
+        "binlog-checksum",
+        "replication-compression",
+        "replication-compression-level",
+        "replication-apply-batch-cmds",
+        "replication-apply-batch-bytes",
         "slow-cmd-list",
         // Options for storage engine
         // MutableDBOptions
@@ -2340,12 +2547,20 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
         "arena-block-size",
         "throttle-bytes-per-second",
         "max-rsync-parallel-num",
+        "max-rsync-window-num",
+        "dbsync-streaming",
         "cache-model",
         "cache-type",
         "zset-cache-start-direction",
         "zset-cache-field-num-per-key",
         "cache-lfu-decay-time",
+        "slave-cache-invalidate",
+        "cache-negative-ttl-ms",
+        "cache-counter-write-behind-ms",
+        "cache-type-maxmemory-percent",
         "max-conn-rbuf-size",
+        "reply-direct-write",
+        "client-output-buffer-limit",
     });
     res_.AppendStringVector(replyVt);
     return;
@@ -2404,6 +2619,18 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
     }
     g_pika_conf->SetSlavePriority(static_cast<int>(ival));
     res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "slave-serve-slaves") {
+    bool serve_slaves = false;
+    if (value == "yes") {
+      serve_slaves = true;
+    } else if (value == "no") {
+      serve_slaves = false;
+    } else {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'slave-serve-slaves'\r\n");
+      return;
+    }
+    g_pika_conf->SetSlaveServeSlaves(serve_slaves);
+    res_.AppendStringRaw("+OK\r\n");
   } else if (set_item == "expire-logs-days") {
     if ((pstd::string2int(value.data(), value.size(), &ival) == 0) || ival <= 0) {
       res_.AppendStringRaw( "-ERR Invalid argument \'" + value + "\' for CONFIG SET 'expire-logs-days'\r\n");
@@ -2478,6 +2705,13 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
     g_pika_conf->SetSlowCmdPool(SlowCmdPool);
     g_pika_server->SetSlowCmdThreadPoolFlag(SlowCmdPool);
     res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "split-pipeline") {
+    if (value != "yes" && value != "no") {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'split-pipeline'\r\n");
+      return;
+    }
+    g_pika_conf->SetSplitPipeline(value == "yes");
+    res_.AppendStringRaw("+OK\r\n");
   } else if (set_item == "slowlog-log-slower-than") {
     if ((pstd::string2int(value.data(), value.size(), &ival) == 0) || ival < 0) {
       res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'slowlog-log-slower-than'\r\n");
@@ -2485,6 +2719,21 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
     }
     g_pika_conf->SetSlowlogSlowerThan(static_cast<int>(ival));
     res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "admission-queue-target-us") {
+    if ((pstd::string2int(value.data(), value.size(), &ival) == 0) || ival < 0) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'admission-queue-target-us'\r\n");
+      return;
+    }
+    g_pika_conf->SetAdmissionQueueTargetUs(static_cast<int>(ival));
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "thread-placement") {
+    std::string err;
+    if (!g_pika_server->thread_placement()->Reset(value, &err)) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'thread-placement': " + err + "\r\n");
+      return;
+    }
+    g_pika_conf->SetThreadPlacement(value);
+    res_.AppendStringRaw("+OK\r\n");
   } else if (set_item == "slowlog-max-len") {
     if ((pstd::string2int(value.data(), value.size(), &ival) == 0) || ival < 0) {
       res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'slowlog-max-len'\r\n");
@@ -2678,6 +2927,62 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
     }
     g_pika_conf->SetSyncWindowSize(static_cast<int>(ival));
     res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "binlog-tail-cache-size") {
+    if (pstd::string2int(value.data(), value.size(), &ival) == 0 || ival < 0) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'binlog-tail-cache-size'\r\n");
+      return;
+    }
+    g_pika_conf->SetBinlogTailCacheSize(ival);
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "binlog-format") {
+    if (value != "resp" && value != "compact") {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'binlog-format'\r\n");
+      return;
+    }
+    g_pika_conf->SetBinlogFormat(value);
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "binlog-checksum") {
+    bool is_checksum = false;
+    if (value == "yes") {
+      is_checksum = true;
+    } else if (value == "no") {
+      is_checksum = false;
+    } else {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'binlog-checksum'\r\n");
+      return;
+    }
+    g_pika_conf->SetBinlogChecksum(is_checksum);
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "replication-compression") {
+    InnerMessage::CompressionType compression;
+    if (!StringToReplCompression(value, &compression)) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'replication-compression'\r\n");
+      return;
+    }
+    // takes effect for slaves connecting from now on
+    g_pika_conf->SetReplicationCompression(value);
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "replication-compression-level") {
+    if (pstd::string2int(value.data(), value.size(), &ival) == 0 || ival < 1 || ival > 22) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'replication-compression-level'\r\n");
+      return;
+    }
+    g_pika_conf->SetReplicationCompressionLevel(static_cast<int>(ival));
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "replication-apply-batch-cmds") {
+    if (pstd::string2int(value.data(), value.size(), &ival) == 0 || ival < 1) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'replication-apply-batch-cmds'\r\n");
+      return;
+    }
+    g_pika_conf->SetReplicationApplyBatchCmds(static_cast<int>(ival));
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "replication-apply-batch-bytes") {
+    if (pstd::string2int(value.data(), value.size(), &ival) == 0 || ival <= 0) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'replication-apply-batch-bytes'\r\n");
+      return;
+    }
+    g_pika_conf->SetReplicationApplyBatchBytes(ival);
+    res_.AppendStringRaw("+OK\r\n");
   } else if (set_item == "slow-cmd-list") {
     g_pika_conf->SetSlowCmd(value);
     res_.AppendStringRaw("+OK\r\n");
@@ -2893,6 +3198,25 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
     }
     g_pika_conf->SetMaxRsyncParallelNum(static_cast<int>(ival));
     res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "max-rsync-window-num") {
+    if ((pstd::string2int(value.data(), value.size(), &ival) == 0) || ival > kMaxRsyncWindowNum || ival <= 0) {
+      res_.AppendStringRaw( "-ERR Invalid argument \'" + value + "\' for CONFIG SET 'max-rsync-window-num'\r\n");
+      return;
+    }
+    g_pika_conf->SetMaxRsyncWindowNum(static_cast<int>(ival));
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "dbsync-streaming") {
+    bool is_streaming = false;
+    if (value == "yes") {
+      is_streaming = true;
+    } else if (value == "no") {
+      is_streaming = false;
+    } else {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'dbsync-streaming'\r\n");
+      return;
+    }
+    g_pika_conf->SetDBSyncStreaming(is_streaming);
+    res_.AppendStringRaw("+OK\r\n");
   } else if (set_item == "cache-num") {
     if (!pstd::string2int(value.data(), value.size(), &ival) || ival < 0) {
       res_.AppendStringRaw("-ERR Invalid argument " + value + " for CONFIG SET 'cache-num'\r\n");
@@ -2993,6 +3317,43 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
     g_pika_conf->SetCacheLFUDecayTime(cache_lfu_decay_time);
     g_pika_server->ResetCacheConfig(db);
     res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "slave-cache-invalidate") {
+    bool is_invalidate = false;
+    if (value == "yes") {
+      is_invalidate = true;
+    } else if (value == "no") {
+      is_invalidate = false;
+    } else {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'slave-cache-invalidate'\r\n");
+      return;
+    }
+    g_pika_conf->SetSlaveCacheInvalidate(is_invalidate);
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "cache-type-maxmemory-percent") {
+    if (!g_pika_conf->SetCacheTypeMaxmemoryPercent(value)) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'cache-type-maxmemory-percent'\r\n");
+      return;
+    }
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "cache-counter-write-behind-ms") {
+    if (!pstd::string2int(value.data(), value.size(), &ival) || ival < 0) {
+      res_.AppendStringRaw("-ERR Invalid argument " + value + " for CONFIG SET 'cache-counter-write-behind-ms'\r\n");
+      return;
+    }
+    g_pika_conf->SetCacheCounterWriteBehindMs(ival);
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "cache-negative-ttl-ms") {
+    if (!pstd::string2int(value.data(), value.size(), &ival) || ival < 0) {
+      res_.AppendStringRaw("-ERR Invalid argument " + value + " for CONFIG SET 'cache-negative-ttl-ms'\r\n");
+      return;
+    }
+    g_pika_conf->SetCacheNegativeTtlMs(ival);
+    if (0 == ival) {
+      for (const auto& db_item : g_pika_server->GetDB()) {
+        db_item.second->cache()->ClearNegativeKeys();
+      }
+    }
+    res_.AppendStringRaw("+OK\r\n");
   } else if (set_item == "acl-pubsub-default") {
     std::string v(value);
     pstd::StringToLower(v);
@@ -3016,6 +3377,24 @@ void ConfigCmd::ConfigSet(std::shared_ptr<DB> db) {
     }
     g_pika_conf->SetMaxConnRbufSize(static_cast<int>(ival));
     res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "reply-direct-write") {
+    bool direct_write = false;
+    if (value == "yes") {
+      direct_write = true;
+    } else if (value == "no") {
+      direct_write = false;
+    } else {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'reply-direct-write'\r\n");
+      return;
+    }
+    g_pika_conf->SetReplyDirectWrite(direct_write);
+    res_.AppendStringRaw("+OK\r\n");
+  } else if (set_item == "client-output-buffer-limit") {
+    if (!g_pika_conf->SetClientOutputBufferLimit(value)) {
+      res_.AppendStringRaw("-ERR Invalid argument \'" + value + "\' for CONFIG SET 'client-output-buffer-limit'\r\n");
+      return;
+    }
+    res_.AppendStringRaw("+OK\r\n");
   } else {
     res_.AppendStringRaw("-ERR Unsupported CONFIG parameter: " + set_item + "\r\n");
   }
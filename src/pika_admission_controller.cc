@@ -0,0 +1,88 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "include/pika_admission_controller.h"
+
+#include <algorithm>
+
+#include <glog/logging.h>
+
+#include "pstd/include/env.h"
+
+void PikaAdmissionController::Observe(int pool, uint64_t queue_time_us, uint64_t queue_target_us) {
+  if (pool >= kPoolNum) {
+    return;
+  }
+  PoolState& state = pools_[pool];
+  if (queue_target_us == 0) {
+    state.overloaded.store(false);
+    return;
+  }
+
+  uint64_t min = state.min_queue_time_us.load();
+  while (queue_time_us < min && !state.min_queue_time_us.compare_exchange_weak(min, queue_time_us)) {
+  }
+
+  MaybeNextInterval(pool, queue_target_us);
+}
+
+void PikaAdmissionController::MaybeNextInterval(int pool, uint64_t queue_target_us) {
+  PoolState& state = pools_[pool];
+  uint64_t now = pstd::NowMicros();
+  uint64_t start = state.interval_start_us.load();
+  if (now - start < kIntervalUs || !state.interval_start_us.compare_exchange_strong(start, now)) {
+    return;
+  }
+  // the thread which moved the interval on judges the one which ended, an
+  // interval in which no task left the queue is not overloaded
+  uint64_t min = state.min_queue_time_us.exchange(UINT64_MAX);
+  bool overloaded = min != UINT64_MAX && min > queue_target_us;
+  if (state.overloaded.exchange(overloaded) != overloaded) {
+    LOG(WARNING) << (pool == kFastPool ? "fast" : "slow") << " command pool "
+                 << (overloaded ? "is overloaded" : "is no longer overloaded") << ", shortest queue wait "
+                 << (min == UINT64_MAX ? 0 : min) << "us, target " << queue_target_us << "us";
+  }
+  state.admitted_cmds.store(0);
+  state.active_conns.store(0);
+  ++state.interval;
+}
+
+bool PikaAdmissionController::Admit(int pool, size_t cmd_num, uint64_t queue_target_us, ConnState* conn_state) {
+  if (pool >= kPoolNum || queue_target_us == 0) {
+    return true;
+  }
+  PoolState& state = pools_[pool];
+  if (!state.overloaded.load()) {
+    return true;
+  }
+  // Observe only runs for tasks which got queued, so an overloaded pool
+  // which admits nothing would never be judged again
+  MaybeNextInterval(pool, queue_target_us);
+  if (!state.overloaded.load()) {
+    return true;
+  }
+  if (pool == kSlowPool) {
+    return Reject(cmd_num);
+  }
+
+  uint64_t interval = state.interval.load();
+  if (conn_state->interval != interval) {
+    conn_state->interval = interval;
+    conn_state->admitted_cmds = 0;
+    ++state.active_conns;
+  }
+  uint64_t fair_share = state.admitted_cmds.load() / std::max<uint64_t>(state.active_conns.load(), 1);
+  if (conn_state->admitted_cmds > fair_share) {
+    return Reject(cmd_num);
+  }
+  conn_state->admitted_cmds += cmd_num;
+  state.admitted_cmds += cmd_num;
+  return true;
+}
+
+bool PikaAdmissionController::Reject(size_t cmd_num) {
+  rejected_cmds_ += cmd_num;
+  return false;
+}
@@ -12,17 +12,30 @@
 #include <utility>
 
 #include "include/pika_binlog_transverter.h"
+#include "include/pika_conf.h"
+#include "pstd/include/pstd_coding.h"
+#include "pstd/include/pstd_crc32c.h"
 #include "pstd/include/pstd_defer.h"
 #include "pstd_status.h"
 
 using pstd::Status;
 
+extern std::unique_ptr<PikaConf> g_pika_conf;
+
 std::string NewFileName(const std::string& name, const uint32_t current) {
   char buf[256];
   snprintf(buf, sizeof(buf), "%s%u", name.c_str(), current);
   return {buf};
 }
 
+bool BinlogRecordChecksumMatch(const char* header, const char* content, size_t n) {
+  if ((static_cast<uint8_t>(header[7]) & kRecordChecksumFlag) == 0) {
+    return true;
+  }
+  uint32_t expect = pstd::crc32c::Unmask(pstd::DecodeFixed32(header + 3));
+  return expect == pstd::crc32c::Extend(pstd::crc32c::Value(header + 7, 1), content, n);
+}
+
 /*
  * Version
  */
@@ -64,7 +77,8 @@ Binlog::Binlog(std::string  binlog_path, const int file_size)
     : opened_(false),
       binlog_path_(std::move(binlog_path)),
       file_size_(file_size),
-      binlog_io_error_(false) {
+      binlog_io_error_(false),
+      tail_(std::make_shared<BinlogTail>()) {
   // To intergrate with old version, we don't set mmap file size to 100M;
   // pstd::SetMmapBoundSize(file_size);
   // pstd::kMmapBoundSize = 1024 * 1024 * 100;
@@ -111,6 +125,7 @@ Binlog::Binlog(std::string  binlog_path, const int file_size)
     }
 
     profile = NewFileName(filename_, pro_num_);
+    RecoverProducer(profile);
     DLOG(INFO) << "Binlog: open profile " << profile;
     s = pstd::AppendWritableFile(profile, queue_, version_->pro_offset_);
     if (!s.ok()) {
@@ -136,6 +151,164 @@ void Binlog::Close() {
   opened_.store(false);
 }
 
+namespace {
+
+struct BinlogScan {
+  // end of the last intact record
+  uint64_t intact_offset = 0;
+  // logic id of the last intact item and the number of intact items
+  uint64_t intact_logic_id = 0;
+  uint64_t records_num = 0;
+  // logic id of the item cut at intact_offset, 0 if its header is lost too
+  uint64_t cut_logic_id = 0;
+  std::string reason;
+};
+
+uint64_t ItemLogicId(const std::string& record) {
+  BinlogItem item;
+  if (record.size() < BINLOG_ITEM_HEADER_SIZE ||
+      !PikaBinlogTransverter::BinlogItemWithoutContentDecode(TypeFirst, record, &item)) {
+    return 0;
+  }
+  return item.logic_id();
+}
+
+// scans the records of file up to limit, stops at the first torn one
+void ScanBinlog(pstd::SequentialFile* file, uint64_t limit, BinlogScan* scan) {
+  auto backing_store = std::make_unique<char[]>(kBlockSize);
+  pstd::Slice fragment;
+  std::string record;
+  uint64_t offset = 0;
+  while (offset < limit) {
+    uint64_t leftover = kBlockSize - offset % kBlockSize;
+    if (leftover <= kHeaderSize) {
+      // trailer of a block, the same skip as PikaBinlogReader
+      if (!file->Skip(leftover).ok()) {
+        scan->reason = "skip block trailer failed";
+        break;
+      }
+      offset += leftover;
+      if (record.empty()) {
+        scan->intact_offset = offset;
+      }
+      continue;
+    }
+    char header[kHeaderSize];
+    if (!file->Read(kHeaderSize, &fragment, backing_store.get()).ok() || fragment.size() != kHeaderSize) {
+      scan->reason = "header cut short";
+      break;
+    }
+    memcpy(header, fragment.data(), kHeaderSize);
+    const uint32_t length = (static_cast<uint32_t>(header[0]) & 0xff) | ((static_cast<uint32_t>(header[1]) & 0xff) << 8)
+                            | ((static_cast<uint32_t>(header[2]) & 0xff) << 16);
+    const unsigned int type = static_cast<uint8_t>(header[7]) & ~kRecordChecksumFlag;
+    if (type == kZeroType || length > leftover - kHeaderSize || offset + kHeaderSize + length > limit) {
+      scan->reason = "bad header";
+      break;
+    }
+    if (!file->Read(length, &fragment, backing_store.get()).ok() || fragment.size() != length) {
+      scan->reason = "content cut short";
+      break;
+    }
+    if (!BinlogRecordChecksumMatch(header, fragment.data(), length)) {
+      scan->reason = "checksum mismatch";
+      break;
+    }
+    offset += kHeaderSize + length;
+
+    bool complete = false;
+    if (type == kFullType) {
+      record.assign(fragment.data(), fragment.size());
+      complete = true;
+    } else if (type == kFirstType) {
+      record.assign(fragment.data(), fragment.size());
+    } else if (type == kMiddleType || type == kLastType) {
+      if (record.empty()) {
+        scan->reason = "fragment without its first part";
+        break;
+      }
+      record.append(fragment.data(), fragment.size());
+      complete = type == kLastType;
+    } else if (type == kBadRecord) {
+      // padding written by SetProducerStatus
+      record.clear();
+      scan->intact_offset = offset;
+      continue;
+    } else {
+      scan->reason = "unknown record type " + std::to_string(type);
+      break;
+    }
+    if (complete) {
+      uint64_t logic_id = ItemLogicId(record);
+      if (logic_id != 0) {
+        scan->intact_logic_id = logic_id;
+        ++scan->records_num;
+      }
+      record.clear();
+      scan->intact_offset = offset;
+    }
+  }
+  // the fragments read of the item that is cut
+  scan->cut_logic_id = ItemLogicId(record);
+}
+
+}  // namespace
+
+/*
+ * After an unclean shutdown the tail of the binlog file being written may be
+ * torn: cut short, never flushed (zeros) or, with binlog-checksum, corrupted.
+ * Scan it up to the producer offset and move the producer back to the end of
+ * the last intact record, the next write overwrites what follows. Slaves then
+ * go on from there instead of failing to decode it and asking for a full sync.
+ * The logic id goes back to that of the last intact item. With none left in
+ * profile it is the one before the cut item, or else the last one of the
+ * previous binlog file.
+ */
+void Binlog::RecoverProducer(const std::string& profile) {
+  uint64_t pro_offset = version_->pro_offset_;
+  if (pro_offset == 0 || !pstd::FileExists(profile)) {
+    return;
+  }
+  std::unique_ptr<pstd::SequentialFile> file;
+  if (!pstd::NewSequentialFile(profile, file).ok()) {
+    LOG(WARNING) << "Binlog: open " << profile << " to recover failed, skip it";
+    return;
+  }
+  BinlogScan scan;
+  ScanBinlog(file.get(), pro_offset, &scan);
+  if (scan.intact_offset >= pro_offset) {
+    return;
+  }
+
+  uint64_t logic_id = 0;
+  if (scan.records_num > 0) {
+    logic_id = scan.intact_logic_id;
+  } else if (scan.cut_logic_id > 0) {
+    logic_id = scan.cut_logic_id - 1;
+  } else if (pro_num_ > 0) {
+    std::string prev_profile = NewFileName(filename_, pro_num_ - 1);
+    std::unique_ptr<pstd::SequentialFile> prev_file;
+    if (pstd::FileExists(prev_profile) && pstd::NewSequentialFile(prev_profile, prev_file).ok()) {
+      BinlogScan prev_scan;
+      ScanBinlog(prev_file.get(), UINT64_MAX, &prev_scan);
+      if (prev_scan.records_num > 0) {
+        logic_id = prev_scan.intact_logic_id;
+      }
+    }
+  }
+
+  LOG(WARNING) << "Binlog: " << profile << " is torn at offset " << scan.intact_offset << " (" << scan.reason
+               << "), cut the producer offset back from " << pro_offset << " to it";
+  std::lock_guard l(version_->rwlock_);
+  version_->pro_offset_ = scan.intact_offset;
+  if (logic_id > 0) {
+    version_->logic_id_ = logic_id;
+  } else {
+    LOG(WARNING) << "Binlog: no intact item to take the logic id from, keep " << version_->logic_id_;
+  }
+  version_->StableSave();
+}
+
 void Binlog::InitLogFile() {
   assert(queue_ != nullptr);
 
@@ -172,7 +345,15 @@ Status Binlog::GetProducerStatus(uint32_t* filenum, uint64_t* pro_offset, uint32
 }
 
 // Note: mutex lock should be held
-Status Binlog::Put(const std::string& item) {
+Status Binlog::Put(const std::string& item, BinlogType type) {
+  return PutItem(item, type, nullptr);
+}
+
+Status Binlog::PutReplicated(const std::string& item, BinlogType type, const BinlogItem& attribute) {
+  return PutItem(item, type, &attribute);
+}
+
+Status Binlog::PutItem(const std::string& item, BinlogType type, const BinlogItem* attribute) {
   if (!opened_.load()) {
     return Status::Busy("Binlog is not open yet");
   }
@@ -190,14 +371,35 @@ Status Binlog::Put(const std::string& item) {
   if (!s.ok()) {
     return s;
   }
-  logic_id++;
-  std::string data = PikaBinlogTransverter::BinlogEncode(BinlogType::TypeFirst,
-      time(nullptr), term, logic_id, filenum, offset, item, {});
+  auto exec_time = static_cast<uint32_t>(time(nullptr));
+  if (attribute) {
+    exec_time = attribute->exec_time();
+    term = attribute->term_id();
+    logic_id = attribute->logic_id();
+  } else {
+    logic_id++;
+  }
+  std::string data = PikaBinlogTransverter::BinlogEncode(type,
+      exec_time, term, logic_id, filenum, offset, item, {});
 
   s = Put(data.c_str(), static_cast<int>(data.size()));
   if (!s.ok()) {
     binlog_io_error_.store(true);
+    return s;
   }
+  if (attribute) {
+    std::lock_guard l(version_->rwlock_);
+    version_->logic_id_ = logic_id;
+    version_->StableSave();
+  }
+
+  LogOffset end_offset;
+  {
+    std::shared_lock l(version_->rwlock_);
+    end_offset = LogOffset(BinlogOffset(version_->pro_num_, version_->pro_offset_), LogicOffset(term, logic_id));
+  }
+  tail_->Append(BinlogOffset(filenum, offset), end_offset, std::make_shared<const std::string>(std::move(data)),
+                g_pika_conf->binlog_tail_cache_size());
   return s;
 }
 
@@ -254,11 +456,17 @@ Status Binlog::EmitPhysicalRecord(RecordType t, const char* ptr, size_t n, int*
   buf[0] = static_cast<char>(n & 0xff);
   buf[1] = static_cast<char>((n & 0xff00) >> 8);
   buf[2] = static_cast<char>(n >> 16);
-  buf[3] = static_cast<char>(now & 0xff);
-  buf[4] = static_cast<char>((now & 0xff00) >> 8);
-  buf[5] = static_cast<char>((now & 0xff0000) >> 16);
-  buf[6] = static_cast<char>((now & 0xff000000) >> 24);
-  buf[7] = static_cast<char>(t);
+  if (g_pika_conf->binlog_checksum()) {
+    buf[7] = static_cast<char>(t | kRecordChecksumFlag);
+    uint32_t crc = pstd::crc32c::Mask(pstd::crc32c::Extend(pstd::crc32c::Value(buf + 7, 1), ptr, n));
+    pstd::EncodeFixed32(buf + 3, crc);
+  } else {
+    buf[3] = static_cast<char>(now & 0xff);
+    buf[4] = static_cast<char>((now & 0xff00) >> 8);
+    buf[5] = static_cast<char>((now & 0xff0000) >> 16);
+    buf[6] = static_cast<char>((now & 0xff000000) >> 24);
+    buf[7] = static_cast<char>(t);
+  }
 
   s = queue_->Append(pstd::Slice(buf, kHeaderSize));
   if (s.ok()) {
@@ -369,6 +577,7 @@ Status Binlog::SetProducerStatus(uint32_t pro_num, uint64_t pro_offset, uint32_t
   }
 
   std::lock_guard l(mutex_);
+  tail_->Clear();
 
   // offset smaller than the first header
   if (pro_offset < 4) {
@@ -406,6 +615,7 @@ Status Binlog::SetProducerStatus(uint32_t pro_num, uint64_t pro_offset, uint32_t
 }
 
 Status Binlog::Truncate(uint32_t pro_num, uint64_t pro_offset, uint64_t index) {
+  tail_->Clear();
   queue_.reset();
   std::string profile = NewFileName(filename_, pro_num);
   const int fd = open(profile.c_str(), O_RDWR | O_CLOEXEC, 0644);
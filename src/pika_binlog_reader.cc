@@ -7,6 +7,8 @@
 
 #include <glog/logging.h>
 
+#include <cstring>
+
 using pstd::Status;
 
 PikaBinlogReader::PikaBinlogReader(uint32_t cur_filenum, uint64_t cur_offset)
@@ -98,7 +100,7 @@ bool PikaBinlogReader::GetNext(uint64_t* size) {
     const uint32_t a = static_cast<uint32_t>(header[0]) & 0xff;
     const uint32_t b = static_cast<uint32_t>(header[1]) & 0xff;
     const uint32_t c = static_cast<uint32_t>(header[2]) & 0xff;
-    const unsigned int type = header[7];
+    const unsigned int type = static_cast<uint8_t>(header[7]) & ~kRecordChecksumFlag;
     const uint32_t length = a | (b << 8) | (c << 16);
 
     if (length > (kBlockSize - kHeaderSize)) {
@@ -152,8 +154,11 @@ unsigned int PikaBinlogReader::ReadPhysicalRecord(pstd::Slice* result, uint32_t*
   const uint32_t a = static_cast<uint32_t>(header[0]) & 0xff;
   const uint32_t b = static_cast<uint32_t>(header[1]) & 0xff;
   const uint32_t c = static_cast<uint32_t>(header[2]) & 0xff;
-  const unsigned int type = header[7];
+  const unsigned int type = static_cast<uint8_t>(header[7]) & ~kRecordChecksumFlag;
   const uint32_t length = a | (b << 8) | (c << 16);
+  // the content is read into the same store, keep the header for the checksum
+  char header_copy[kHeaderSize];
+  memcpy(header_copy, header, kHeaderSize);
 
   if (length > (kBlockSize - kHeaderSize)) {
     return kBadRecord;
@@ -167,6 +172,9 @@ unsigned int PikaBinlogReader::ReadPhysicalRecord(pstd::Slice* result, uint32_t*
   buffer_.clear();
   s = queue_->Read(length, &buffer_, backing_store_.get());
   *result = pstd::Slice(buffer_.data(), buffer_.size());
+  if (s.ok() && !BinlogRecordChecksumMatch(header_copy, result->data(), result->size())) {
+    return kBadChecksum;
+  }
   last_record_offset_ += kHeaderSize + length;
   if (s.ok()) {
     std::lock_guard l(rwlock_);
@@ -209,6 +217,10 @@ Status PikaBinlogReader::Consume(std::string* scratch, uint32_t* filenum, uint64
         return Status::IOError("Data Corruption");
       case kOldRecord:
         return Status::EndFile("Eof");
+      case kBadChecksum:
+        LOG(ERROR) << "Read binlog record with a mismatched checksum at filenum " << cur_filenum_ << " offset "
+                   << cur_offset_;
+        return Status::Corruption("binlog checksum mismatch");
       default:
         return Status::IOError("Unknow reason");
     }
@@ -0,0 +1,63 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "include/pika_binlog_tail.h"
+
+#include <algorithm>
+
+void BinlogTail::Append(const BinlogOffset& prev_offset, const LogOffset& offset,
+                        std::shared_ptr<const std::string> binlog, uint64_t capacity) {
+  std::lock_guard l(rwlock_);
+  if (!items_.empty() && items_.back().offset.b_offset != prev_offset) {
+    // the binlog was moved by someone else, what we hold is not contiguous
+    items_.clear();
+    bytes_ = 0;
+  }
+  if (binlog->size() > capacity) {
+    items_.clear();
+    bytes_ = 0;
+    return;
+  }
+  bytes_ += binlog->size();
+  items_.push_back({prev_offset, offset, std::move(binlog)});
+  while (bytes_ > capacity) {
+    bytes_ -= items_.front().binlog->size();
+    items_.pop_front();
+  }
+}
+
+bool BinlogTail::Get(const BinlogOffset& prev_offset, Item* item) {
+  std::shared_lock l(rwlock_);
+  if (!items_.empty() && items_.back().offset.b_offset == prev_offset) {
+    // caught up, nothing to read yet
+    return false;
+  }
+  // records are ordered, the wanted one is the first ending after prev_offset
+  auto iter = std::upper_bound(items_.begin(), items_.end(), prev_offset,
+                               [](const BinlogOffset& offset, const Item& i) { return offset < i.offset.b_offset; });
+  if (iter == items_.end() || iter->prev_offset != prev_offset) {
+    ++misses_;
+    return false;
+  }
+  *item = *iter;
+  ++hits_;
+  return true;
+}
+
+void BinlogTail::Clear() {
+  std::lock_guard l(rwlock_);
+  items_.clear();
+  bytes_ = 0;
+}
+
+uint64_t BinlogTail::ItemsNum() {
+  std::shared_lock l(rwlock_);
+  return items_.size();
+}
+
+uint64_t BinlogTail::Bytes() {
+  std::shared_lock l(rwlock_);
+  return bytes_;
+}
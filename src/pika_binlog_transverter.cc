@@ -6,6 +6,7 @@
 #include "include/pika_binlog_transverter.h"
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 
@@ -26,6 +27,8 @@ uint32_t BinlogItem::filenum() const { return filenum_; }
 
 uint64_t BinlogItem::offset() const { return offset_; }
 
+BinlogType BinlogItem::type() const { return type_; }
+
 std::string BinlogItem::content() const { return content_; }
 
 void BinlogItem::set_exec_time(uint32_t exec_time) { exec_time_ = exec_time; }
@@ -59,6 +62,14 @@ std::string BinlogItem::ToString() const {
   return str;
 }
 
+// TypeFirst and TypeCompact only differ in the content, a reader of one reads the other
+static bool BinlogTypeMatch(BinlogType expect, uint16_t actual) {
+  if (actual == expect) {
+    return true;
+  }
+  return (expect == TypeFirst || expect == TypeCompact) && (actual == TypeFirst || actual == TypeCompact);
+}
+
 std::string PikaBinlogTransverter::BinlogEncode(BinlogType type, uint32_t exec_time, uint32_t term_id,
                                                 uint64_t logic_id, uint32_t filenum, uint64_t offset,
                                                 const std::string& content, const std::vector<std::string>& extends) {
@@ -80,10 +91,11 @@ bool PikaBinlogTransverter::BinlogDecode(BinlogType type, const std::string& bin
   uint32_t content_length = 0;
   pstd::Slice binlog_str = binlog;
   pstd::GetFixed16(&binlog_str, &binlog_type);
-  if (binlog_type != type) {
+  if (!BinlogTypeMatch(type, binlog_type)) {
     LOG(ERROR) << "Binlog Item type error, expect type:" << type << " actualy type: " << binlog_type;
     return false;
   }
+  binlog_item->type_ = static_cast<BinlogType>(binlog_type);
   pstd::GetFixed32(&binlog_str, &binlog_item->exec_time_);
   pstd::GetFixed32(&binlog_str, &binlog_item->term_id_);
   pstd::GetFixed64(&binlog_str, &binlog_item->logic_id_);
@@ -163,10 +175,11 @@ bool PikaBinlogTransverter::BinlogItemWithoutContentDecode(BinlogType type, cons
   uint16_t binlog_type = 0;
   pstd::Slice binlog_str = binlog;
   pstd::GetFixed16(&binlog_str, &binlog_type);
-  if (binlog_type != type) {
+  if (!BinlogTypeMatch(type, binlog_type)) {
     LOG(ERROR) << "Binlog Item type error, expect type:" << type << " actualy type: " << binlog_type;
     return false;
   }
+  binlog_item->type_ = static_cast<BinlogType>(binlog_type);
   pstd::GetFixed32(&binlog_str, &binlog_item->exec_time_);
   pstd::GetFixed32(&binlog_str, &binlog_item->term_id_);
   pstd::GetFixed64(&binlog_str, &binlog_item->logic_id_);
@@ -174,3 +187,70 @@ bool PikaBinlogTransverter::BinlogItemWithoutContentDecode(BinlogType type, cons
   pstd::GetFixed64(&binlog_str, &binlog_item->offset_);
   return true;
 }
+
+static bool ParseRedisNumber(pstd::Slice* input, char prefix, uint64_t* value) {
+  if (input->empty() || (*input)[0] != prefix) {
+    return false;
+  }
+  input->remove_prefix(1);
+  uint64_t num = 0;
+  size_t digits = 0;
+  while (digits < input->size() && (*input)[digits] >= '0' && (*input)[digits] <= '9' && digits < 19) {
+    num = num * 10 + ((*input)[digits] - '0');
+    ++digits;
+  }
+  if (digits == 0 || !pstd::Slice(input->data() + digits, input->size() - digits).starts_with(kNewLine)) {
+    return false;
+  }
+  input->remove_prefix(digits + kNewLine.size());
+  *value = num;
+  return true;
+}
+
+bool PikaBinlogTransverter::RedisProtocolToCompactContent(const std::string& redis_protocol, std::string* content) {
+  pstd::Slice input(redis_protocol);
+  uint64_t argc = 0;
+  if (!ParseRedisNumber(&input, '*', &argc) || argc == 0 || argc > UINT32_MAX) {
+    return false;
+  }
+  content->clear();
+  content->reserve(redis_protocol.size());
+  content->push_back(static_cast<char>(BINLOG_COMPACT_VERSION));
+  pstd::PutVarint32(content, static_cast<uint32_t>(argc));
+  for (uint64_t i = 0; i < argc; ++i) {
+    uint64_t arg_len = 0;
+    if (!ParseRedisNumber(&input, '$', &arg_len) || arg_len > UINT32_MAX || input.size() < arg_len + kNewLine.size()
+        || !pstd::Slice(input.data() + arg_len, kNewLine.size()).starts_with(kNewLine)) {
+      return false;
+    }
+    pstd::PutVarint32(content, static_cast<uint32_t>(arg_len));
+    content->append(input.data(), arg_len);
+    input.remove_prefix(arg_len + kNewLine.size());
+  }
+  return input.empty();
+}
+
+bool PikaBinlogTransverter::CompactContentDecode(const char* content, size_t len, std::vector<std::string>* argv) {
+  pstd::Slice input(content, len);
+  if (input.empty() || static_cast<uint8_t>(input[0]) != BINLOG_COMPACT_VERSION) {
+    LOG(ERROR) << "Binlog compact content version error, actualy version: "
+               << (input.empty() ? -1 : static_cast<int>(static_cast<uint8_t>(input[0])));
+    return false;
+  }
+  input.remove_prefix(1);
+  uint32_t argc = 0;
+  if (!pstd::GetVarint32(&input, &argc) || argc == 0) {
+    return false;
+  }
+  argv->clear();
+  // every argument takes at least one byte for its length
+  argv->reserve(std::min<size_t>(argc, input.size()));
+  for (uint32_t i = 0; i < argc; ++i) {
+    pstd::Slice arg;
+    if (!pstd::GetLengthPrefixedSlice(&input, &arg)) {
+      return false;
+    }
+    argv->emplace_back(arg.data(), arg.size());
+  }
+  return input.empty();
+}
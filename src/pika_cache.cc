@@ -11,6 +11,7 @@
 
 #include "include/pika_cache.h"
 #include "include/pika_cache_load_thread.h"
+#include "include/pika_cache_invalidate_thread.h"
 #include "include/pika_server.h"
 #include "include/pika_slot_command.h"
 #include "pstd/include/pika_codis_slot.h"
@@ -28,9 +29,12 @@ PikaCache::PikaCache(int zset_cache_start_direction, int zset_cache_field_num_pe
       zset_cache_field_num_per_key_(EXTEND_CACHE_SIZE(zset_cache_field_num_per_key)) {
   cache_load_thread_ = std::make_unique<PikaCacheLoadThread> (zset_cache_start_direction_, zset_cache_field_num_per_key_);
   cache_load_thread_->StartThread();
+  cache_invalidate_thread_ = std::make_unique<PikaCacheInvalidateThread>(this);
+  cache_invalidate_thread_->StartThread();
 }
 
 PikaCache::~PikaCache() {
+  cache_invalidate_thread_.reset();
   {
     std::lock_guard l(rwlock_);
     DestroyWithoutLock();
@@ -52,6 +56,8 @@ void PikaCache::ProcessCronTask(void) {
     std::unique_lock lm(*cache_mutexs_[i]);
     caches_[i]->ActiveExpireCycle();
   }
+  ReconcileTypeUsage();
+  PurgeExpiredNegativeKeys();
 }
 
 Status PikaCache::Reset(uint32_t cache_num, cache::CacheConfig *cache_cfg) {
@@ -89,10 +95,28 @@ void PikaCache::Info(CacheInfo &info) {
   info.used_memory = cache::RedisCache::GetUsedMemory();
   info.async_load_keys_num = cache_load_thread_->AsyncLoadKeysNum();
   info.waitting_load_keys_num = cache_load_thread_->WaittingLoadKeysNum();
+  info.invalidate_pending_keys_num = invalidate_pending_keys_num_;
+  info.invalidated_keys_num = invalidated_keys_num_;
+  info.negative_keys_num = negative_keys_num_;
+  info.negative_hits = negative_hits_;
+  info.negative_misses = negative_misses_;
   cache::RedisCache::GetHitAndMissNum(&info.hits, &info.misses);
+  info.type_keys_num.resize(PIKA_CACHE_TYPE_NUM, 0);
+  info.type_used_memory.resize(PIKA_CACHE_TYPE_NUM, 0);
+  info.type_rejected_keys_num.resize(PIKA_CACHE_TYPE_NUM, 0);
+  info.shard_keys_num.resize(caches_.size(), 0);
+  info.shard_used_memory.resize(caches_.size(), 0);
   for (uint32_t i = 0; i < caches_.size(); ++i) {
     std::lock_guard lm(*cache_mutexs_[i]);
-    info.keys_num += caches_[i]->DbSize();
+    info.shard_keys_num[i] = caches_[i]->DbSize();
+    info.keys_num += info.shard_keys_num[i];
+    const auto& usage = type_usages_[i];
+    for (int t = 0; t < PIKA_CACHE_TYPE_NUM; ++t) {
+      info.type_keys_num[t] += usage.keys_num[t];
+      info.type_used_memory[t] += usage.used_memory[t];
+      info.type_rejected_keys_num[t] += usage.rejected_keys_num[t];
+      info.shard_used_memory[i] += usage.used_memory[t];
+    }
   }
 }
 
@@ -107,7 +131,9 @@ void PikaCache::FlushCache(void) {
   for (uint32_t i = 0; i < caches_.size(); ++i) {
     std::lock_guard lm(*cache_mutexs_[i]);
     caches_[i]->FlushCache();
+    type_usages_[i] = CacheTypeUsage();
   }
+  ClearNegativeKeys();
 }
 
 Status PikaCache::Del(const std::vector<std::string> &keys) {
@@ -337,6 +363,15 @@ Status PikaCache::IncrByxx(std::string& key, uint64_t incr) {
   return Status::NotFound("key not exist");
 }
 
+Status PikaCache::IncrByxx(std::string& key, int64_t incr, int64_t* new_value) {
+  int cache_index = CacheIndex(key);
+  std::lock_guard lm(*cache_mutexs_[cache_index]);
+  if (caches_[cache_index]->Exists(key)) {
+    return caches_[cache_index]->IncrBy(key, incr, new_value);
+  }
+  return Status::NotFound("key not exist");
+}
+
 Status PikaCache::DecrByxx(std::string& key, uint64_t incr) {
   int cache_index = CacheIndex(key);
   std::lock_guard lm(*cache_mutexs_[cache_index]);
@@ -470,10 +505,10 @@ Status PikaCache::HMGet(std::string& key, std::vector<std::string> &fields, std:
   return caches_[cache_index]->HMGet(key, fields, vss);
 }
 
-Status PikaCache::HGetall(std::string& key, std::vector<storage::FieldValue> *fvs) {
+Status PikaCache::HGetallResp(std::string& key, std::string *resp) {
   int cache_index = CacheIndex(key);
   std::lock_guard lm(*cache_mutexs_[cache_index]);
-  return caches_[cache_index]->HGetall(key, fvs);
+  return caches_[cache_index]->HGetallResp(key, resp);
 }
 
 Status PikaCache::HKeys(std::string& key, std::vector<std::string> *fields) {
@@ -503,6 +538,15 @@ Status PikaCache::HIncrbyxx(std::string& key, std::string &field, int64_t value)
   return Status::NotFound("key not exist");
 }
 
+Status PikaCache::HIncrbyxx(std::string& key, std::string &field, int64_t value, int64_t* new_value) {
+  int cache_index = CacheIndex(key);
+  std::lock_guard lm(*cache_mutexs_[cache_index]);
+  if (caches_[cache_index]->Exists(key)) {
+    return caches_[cache_index]->HIncrby(key, field, value, new_value);
+  }
+  return Status::NotFound("key not exist");
+}
+
 Status PikaCache::HIncrbyfloatxx(std::string& key, std::string &field, long double value) {
   int cache_index = CacheIndex(key);
   std::lock_guard lm(*cache_mutexs_[cache_index]);
@@ -682,10 +726,10 @@ Status PikaCache::SIsmember(std::string& key, std::string& member) {
   return caches_[cache_index]->SIsmember(key, member);
 }
 
-Status PikaCache::SMembers(std::string& key, std::vector<std::string> *members) {
+Status PikaCache::SMembersResp(std::string& key, std::string *resp) {
   int cache_index = CacheIndex(key);
   std::lock_guard lm(*cache_mutexs_[cache_index]);
-  return caches_[cache_index]->SMembers(key, members);
+  return caches_[cache_index]->SMembersResp(key, resp);
 }
 
 Status PikaCache::SRem(std::string& key, std::vector<std::string> &members) {
@@ -1154,35 +1198,39 @@ RangeStatus PikaCache::CheckCacheRevRange(int32_t cache_len, int32_t db_len, int
   }
 }
 
-Status PikaCache::ZRange(std::string& key, int64_t start, int64_t stop, std::vector<storage::ScoreMember> *score_members,
-                         const std::shared_ptr<DB>& db) {
+Status PikaCache::ZRangeRespInCache(std::string& key, int64_t start, int64_t stop, bool reverse, bool with_scores,
+                                    std::string *resp, const std::shared_ptr<DB>& db) {
   int cache_index = CacheIndex(key);
   std::lock_guard lm(*cache_mutexs_[cache_index]);
 
   auto cache_obj = caches_[cache_index];
   auto db_obj = db->storage();
-  Status s;
-  if (cache_obj->Exists(key)) {
-    uint64_t cache_len = 0;
-    cache_obj->ZCard(key, &cache_len);
-    int32_t db_len = 0;
-    db_obj->ZCard(key, &db_len);
-    int64_t out_start = 0;
-    int64_t out_stop = 0;
-    RangeStatus rs = CheckCacheRange(cache_len, db_len, start, stop, out_start, out_stop);
-    if (rs == RangeStatus::RangeHit) {
-      return cache_obj->ZRange(key, out_start, out_stop, score_members);
-    } else if (rs == RangeStatus::RangeMiss) {
-      ReloadCacheKeyIfNeeded(cache_obj, key, cache_len, db_len, db);
-      return Status::NotFound("key not in cache");
-    } else if (rs == RangeStatus::RangeError) {
-      return Status::NotFound("error range");
-    } else {
-      return Status::Corruption("unknown error");
-    }
-  } else {
+  if (!cache_obj->Exists(key)) {
     return Status::NotFound("key not in cache");
   }
+  uint64_t cache_len = 0;
+  cache_obj->ZCard(key, &cache_len);
+  int32_t db_len = 0;
+  db_obj->ZCard(key, &db_len);
+  int64_t out_start = 0;
+  int64_t out_stop = 0;
+  RangeStatus rs = reverse ? CheckCacheRevRange(cache_len, db_len, start, stop, out_start, out_stop)
+                           : CheckCacheRange(cache_len, db_len, start, stop, out_start, out_stop);
+  if (rs == RangeStatus::RangeHit) {
+    return cache_obj->ZRangeResp(key, out_start, out_stop, reverse, with_scores, resp);
+  } else if (rs == RangeStatus::RangeMiss) {
+    ReloadCacheKeyIfNeeded(cache_obj, key, cache_len, db_len, db);
+    return Status::NotFound("key not in cache");
+  } else if (rs == RangeStatus::RangeError) {
+    return Status::NotFound(reverse ? "error revrange" : "error range");
+  } else {
+    return Status::Corruption("unknown error");
+  }
+}
+
+Status PikaCache::ZRangeResp(std::string& key, int64_t start, int64_t stop, bool with_scores, std::string *resp,
+                             const std::shared_ptr<DB>& db) {
+  return ZRangeRespInCache(key, start, stop, false, with_scores, resp, db);
 }
 
 Status PikaCache::ZRangebyscore(std::string& key, std::string &min, std::string &max,
@@ -1311,35 +1359,9 @@ Status PikaCache::ZRemrangebyscore(std::string& key, std::string &min, std::stri
   return s;
 }
 
-Status PikaCache::ZRevrange(std::string& key, int64_t start, int64_t stop, std::vector<storage::ScoreMember> *score_members,
-                            const std::shared_ptr<DB>& db) {
-  int cache_index = CacheIndex(key);
-  std::lock_guard lm(*cache_mutexs_[cache_index]);
-
-  auto cache_obj = caches_[cache_index];
-  auto db_obj = db->storage();
-  Status s;
-  if (cache_obj->Exists(key)) {
-    uint64_t cache_len = 0;
-    cache_obj->ZCard(key, &cache_len);
-    int32_t db_len = 0;
-    db_obj->ZCard(key, &db_len);
-    int64_t out_start = 0;
-    int64_t out_stop = 0;
-    RangeStatus rs = CheckCacheRevRange(cache_len, db_len, start, stop, out_start, out_stop);
-    if (rs == RangeStatus::RangeHit) {
-      return cache_obj->ZRevrange(key, out_start, out_stop, score_members);
-    } else if (rs == RangeStatus::RangeMiss) {
-      ReloadCacheKeyIfNeeded(cache_obj, key, cache_len, db_len, db);
-      return Status::NotFound("key not in cache");
-    } else if (rs == RangeStatus::RangeError) {
-      return Status::NotFound("error revrange");
-    } else {
-      return Status::Corruption("unknown error");
-    }
-  } else {
-    return Status::NotFound("key not in cache");
-  }
+Status PikaCache::ZRevrangeResp(std::string& key, int64_t start, int64_t stop, bool with_scores, std::string *resp,
+                                const std::shared_ptr<DB>& db) {
+  return ZRangeRespInCache(key, start, stop, true, with_scores, resp, db);
 }
 
 Status PikaCache::ZRevrangebyscore(std::string& key, std::string &min, std::string &max,
@@ -1564,6 +1586,13 @@ Status PikaCache::InitWithoutLock(uint32_t cache_num, cache::CacheConfig *cache_
     caches_.push_back(cache);
     cache_mutexs_.push_back(std::make_shared<pstd::Mutex>());
   }
+  type_usages_.resize(cache_num);
+  invalidate_queues_.resize(cache_num);
+  negative_keys_.resize(cache_num);
+  for (uint32_t i = 0; i < cache_num; ++i) {
+    invalidate_mutexs_.push_back(std::make_shared<pstd::Mutex>());
+    negative_mutexs_.push_back(std::make_shared<pstd::Mutex>());
+  }
   cache_status_ = PIKA_CACHE_STATUS_OK;
   return Status::OK();
 }
@@ -1577,6 +1606,14 @@ void PikaCache::DestroyWithoutLock(void)
   }
   caches_.clear();
   cache_mutexs_.clear();
+  type_usages_.clear();
+  // the caches are gone, so are the keys waiting to be removed from them
+  invalidate_queues_.clear();
+  invalidate_mutexs_.clear();
+  invalidate_pending_keys_num_ = 0;
+  negative_keys_.clear();
+  negative_mutexs_.clear();
+  negative_keys_num_ = 0;
 }
 
 int PikaCache::CacheIndex(const std::string& key) {
@@ -1585,75 +1622,262 @@ int PikaCache::CacheIndex(const std::string& key) {
 }
 
 Status PikaCache::WriteKVToCache(std::string& key, std::string &value, int64_t ttl) {
-  if (0 >= ttl) {
-    if (PIKA_TTL_NONE == ttl) {
-      return SetnxWithoutTTL(key, value);
-    } else {
-      return Del({key});
-    }
-  } else {
-    return Setnx(key, value, ttl);
+  if (0 >= ttl && PIKA_TTL_NONE != ttl) {
+    return Del({key});
   }
-  return Status::OK();
+  if (!AdmitToCache(key, PIKA_KEY_TYPE_KV, value.size())) {
+    return Status::Incomplete("string cache budget exceeded");
+  }
+  if (PIKA_TTL_NONE == ttl) {
+    return SetnxWithoutTTL(key, value);
+  }
+  return Setnx(key, value, ttl);
 }
 
 Status PikaCache::WriteHashToCache(std::string& key, std::vector<storage::FieldValue> &fvs, int64_t ttl) {
-  if (0 >= ttl) {
-    if (PIKA_TTL_NONE == ttl) {
-      return HMSetnxWithoutTTL(key, fvs);
-    } else {
-      return Del({key});
-    }
-  } else {
-    return HMSetnx(key, fvs, ttl);
+  if (0 >= ttl && PIKA_TTL_NONE != ttl) {
+    return Del({key});
   }
-  return Status::OK();
+  uint64_t bytes = 0;
+  for (const auto& fv : fvs) {
+    bytes += fv.field.size() + fv.value.size() + CACHE_ITEM_OVERHEAD_BYTES;
+  }
+  if (!AdmitToCache(key, PIKA_KEY_TYPE_HASH, bytes)) {
+    return Status::Incomplete("hash cache budget exceeded");
+  }
+  if (PIKA_TTL_NONE == ttl) {
+    return HMSetnxWithoutTTL(key, fvs);
+  }
+  return HMSetnx(key, fvs, ttl);
 }
 
 Status PikaCache::WriteListToCache(std::string& key, std::vector<std::string> &values, int64_t ttl) {
-  if (0 >= ttl) {
-    if (PIKA_TTL_NONE == ttl) {
-      return RPushnxWithoutTTL(key, values);
-    } else {
-      return Del({key});
-    }
-  } else {
-    return RPushnx(key, values, ttl);
+  if (0 >= ttl && PIKA_TTL_NONE != ttl) {
+    return Del({key});
   }
-  return Status::OK();
+  uint64_t bytes = 0;
+  for (const auto& value : values) {
+    bytes += value.size() + CACHE_ITEM_OVERHEAD_BYTES;
+  }
+  if (!AdmitToCache(key, PIKA_KEY_TYPE_LIST, bytes)) {
+    return Status::Incomplete("list cache budget exceeded");
+  }
+  if (PIKA_TTL_NONE == ttl) {
+    return RPushnxWithoutTTL(key, values);
+  }
+  return RPushnx(key, values, ttl);
 }
 
 Status PikaCache::WriteSetToCache(std::string& key, std::vector<std::string> &members, int64_t ttl) {
-  if (0 >= ttl) {
-    if (PIKA_TTL_NONE == ttl) {
-      return SAddnxWithoutTTL(key, members);
-    } else {
-      return Del({key});
-    }
-  } else {
-    return SAddnx(key, members, ttl);
+  if (0 >= ttl && PIKA_TTL_NONE != ttl) {
+    return Del({key});
   }
-  return Status::OK();
+  uint64_t bytes = 0;
+  for (const auto& member : members) {
+    bytes += member.size() + CACHE_ITEM_OVERHEAD_BYTES;
+  }
+  if (!AdmitToCache(key, PIKA_KEY_TYPE_SET, bytes)) {
+    return Status::Incomplete("set cache budget exceeded");
+  }
+  if (PIKA_TTL_NONE == ttl) {
+    return SAddnxWithoutTTL(key, members);
+  }
+  return SAddnx(key, members, ttl);
 }
 
 Status PikaCache::WriteZSetToCache(std::string& key, std::vector<storage::ScoreMember> &score_members, int64_t ttl) {
-  if (0 >= ttl) {
-    if (PIKA_TTL_NONE == ttl) {
-      return ZAddnxWithoutTTL(key, score_members);
-    } else {
-      return Del({key});
+  if (0 >= ttl && PIKA_TTL_NONE != ttl) {
+    return Del({key});
+  }
+  uint64_t bytes = 0;
+  for (const auto& sm : score_members) {
+    bytes += sm.member.size() + sizeof(sm.score) + CACHE_ITEM_OVERHEAD_BYTES;
+  }
+  if (!AdmitToCache(key, PIKA_KEY_TYPE_ZSET, bytes)) {
+    return Status::Incomplete("zset cache budget exceeded");
+  }
+  if (PIKA_TTL_NONE == ttl) {
+    return ZAddnxWithoutTTL(key, score_members);
+  }
+  return ZAddnx(key, score_members, ttl);
+}
+
+int PikaCache::CacheTypeIndex(char key_type) {
+  for (int i = 0; i < PIKA_CACHE_TYPE_NUM; ++i) {
+    if (PIKA_CACHE_TYPES[i] == key_type) {
+      return i;
+    }
+  }
+  return 0;
+}
+
+bool PikaCache::AdmitToCache(const std::string& key, char key_type, uint64_t bytes) {
+  int type_index = CacheTypeIndex(key_type);
+  bytes += key.size() + CACHE_KEY_OVERHEAD_BYTES;
+  int cache_index = CacheIndex(key);
+  std::lock_guard lm(*cache_mutexs_[cache_index]);
+  auto& usage = type_usages_[cache_index];
+  int percent = g_pika_conf->cache_type_maxmemory_percent(type_index);
+  if (percent < 100) {
+    // keys spread evenly over shards, so is the budget
+    uint64_t budget = static_cast<uint64_t>(g_pika_conf->cache_maxmemory()) / 100 * percent / caches_.size();
+    if (usage.used_memory[type_index] + bytes > budget) {
+      ++usage.rejected_keys_num[type_index];
+      return false;
+    }
+  }
+  ++usage.keys_num[type_index];
+  usage.used_memory[type_index] += bytes;
+  return true;
+}
+
+void PikaCache::ReconcileTypeUsage(void) {
+  // keys leave the cache by eviction, expiration and deletes that do not know the key type,
+  // so scale the estimation of a shard down to the number of keys it really holds
+  for (uint32_t i = 0; i < caches_.size(); ++i) {
+    std::lock_guard lm(*cache_mutexs_[i]);
+    auto& usage = type_usages_[i];
+    uint64_t tracked_keys_num = 0;
+    for (int t = 0; t < PIKA_CACHE_TYPE_NUM; ++t) {
+      tracked_keys_num += usage.keys_num[t];
+    }
+    auto keys_num = static_cast<uint64_t>(caches_[i]->DbSize());
+    if (tracked_keys_num <= keys_num) {
+      continue;
+    }
+    double ratio = static_cast<double>(keys_num) / static_cast<double>(tracked_keys_num);
+    for (int t = 0; t < PIKA_CACHE_TYPE_NUM; ++t) {
+      usage.keys_num[t] = static_cast<uint64_t>(static_cast<double>(usage.keys_num[t]) * ratio);
+      usage.used_memory[t] = static_cast<uint64_t>(static_cast<double>(usage.used_memory[t]) * ratio);
     }
-  } else {
-    return ZAddnx(key, score_members, ttl);
   }
-  return Status::OK();
 }
 
 void PikaCache::PushKeyToAsyncLoadQueue(const char key_type, std::string& key, const std::shared_ptr<DB>& db) {
   cache_load_thread_->Push(key_type, key, db);
 }
 
+void PikaCache::PushKeysToInvalidateQueue(const std::vector<std::string>& keys) {
+  bool need_wakeup = false;
+  for (const auto& key : keys) {
+    int cache_index = CacheIndex(key);
+    std::lock_guard lm(*invalidate_mutexs_[cache_index]);
+    if (invalidate_queues_[cache_index].insert(key).second && 0 == invalidate_pending_keys_num_++) {
+      need_wakeup = true;
+    }
+  }
+  // only the first key after the queues went empty wakes the drain thread
+  if (need_wakeup) {
+    cache_invalidate_thread_->Wakeup();
+  }
+}
+
+void PikaCache::DrainInvalidateQueue(void) {
+  std::shared_lock l(rwlock_);
+  for (uint32_t i = 0; i < invalidate_queues_.size(); ++i) {
+    std::unordered_set<std::string> keys;
+    {
+      std::lock_guard lm(*invalidate_mutexs_[i]);
+      keys.swap(invalidate_queues_[i]);
+    }
+    if (keys.empty()) {
+      continue;
+    }
+    invalidate_pending_keys_num_ -= keys.size();
+
+    // release the shard between batches so that reads are not stalled by a big drain
+    auto iter = keys.begin();
+    while (iter != keys.end()) {
+      std::lock_guard lm(*cache_mutexs_[i]);
+      for (int n = 0; n < CACHE_INVALIDATE_NUM_ONE_TIME && iter != keys.end(); ++n, ++iter) {
+        caches_[i]->Del(*iter);
+      }
+    }
+    invalidated_keys_num_ += keys.size();
+  }
+}
+
+bool PikaCache::IsNegativeKeys(const std::vector<std::string>& keys) {
+  if (0 == negative_keys_num_ || keys.empty()) {
+    ++negative_misses_;
+    return false;
+  }
+  uint64_t now_us = pstd::NowMicros();
+  for (const auto& key : keys) {
+    int cache_index = CacheIndex(key);
+    std::lock_guard lm(*negative_mutexs_[cache_index]);
+    auto iter = negative_keys_[cache_index].find(key);
+    if (iter == negative_keys_[cache_index].end() || iter->second <= now_us) {
+      ++negative_misses_;
+      return false;
+    }
+  }
+  ++negative_hits_;
+  return true;
+}
+
+void PikaCache::AddNegativeKeys(const std::vector<std::string>& keys, int64_t ttl_ms) {
+  if (0 >= ttl_ms) {
+    return;
+  }
+  uint64_t expire_us = pstd::NowMicros() + ttl_ms * 1000;
+  for (const auto& key : keys) {
+    int cache_index = CacheIndex(key);
+    std::lock_guard lm(*negative_mutexs_[cache_index]);
+    auto& negative_keys = negative_keys_[cache_index];
+    if (CACHE_NEGATIVE_MAX_KEYS_PER_SHARD <= negative_keys.size()) {
+      // expired keys are purged by the cron task, until then stop growing
+      continue;
+    }
+    if (negative_keys.insert_or_assign(key, expire_us).second) {
+      ++negative_keys_num_;
+    }
+  }
+}
+
+void PikaCache::DelNegativeKeys(const std::vector<std::string>& keys) {
+  if (0 == negative_keys_num_) {
+    return;
+  }
+  for (const auto& key : keys) {
+    int cache_index = CacheIndex(key);
+    std::lock_guard lm(*negative_mutexs_[cache_index]);
+    if (negative_keys_[cache_index].erase(key) != 0) {
+      --negative_keys_num_;
+    }
+  }
+}
+
+void PikaCache::ClearNegativeKeys(void) {
+  for (uint32_t i = 0; i < negative_keys_.size(); ++i) {
+    std::lock_guard lm(*negative_mutexs_[i]);
+    negative_keys_num_ -= negative_keys_[i].size();
+    negative_keys_[i].clear();
+  }
+}
+
+void PikaCache::PurgeExpiredNegativeKeys(void) {
+  if (0 == negative_keys_num_) {
+    return;
+  }
+  uint64_t now_us = pstd::NowMicros();
+  for (uint32_t i = 0; i < negative_keys_.size(); ++i) {
+    std::lock_guard lm(*negative_mutexs_[i]);
+    auto& negative_keys = negative_keys_[i];
+    for (auto iter = negative_keys.begin(); iter != negative_keys.end();) {
+      if (iter->second <= now_us) {
+        iter = negative_keys.erase(iter);
+        --negative_keys_num_;
+      } else {
+        ++iter;
+      }
+    }
+  }
+}
+
 void PikaCache::ClearHitRatio(void) {
   std::unique_lock l(rwlock_);
   cache::RedisCache::ResetHitAndMissNum();
+  negative_hits_ = 0;
+  negative_misses_ = 0;
 }
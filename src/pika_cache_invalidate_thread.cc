@@ -0,0 +1,52 @@
+// Copyright (c) 2023-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+#include <glog/logging.h>
+
+#include "include/pika_cache_invalidate_thread.h"
+#include "include/pika_cache.h"
+
+PikaCacheInvalidateThread::PikaCacheInvalidateThread(PikaCache* cache)
+    : should_exit_(false)
+      , invalidate_cond_()
+      , cache_(cache)
+{
+  set_thread_name("PikaCacheInvalidateThread");
+}
+
+PikaCacheInvalidateThread::~PikaCacheInvalidateThread() {
+  {
+    std::lock_guard lq(invalidate_mutex_);
+    should_exit_ = true;
+    invalidate_cond_.notify_all();
+  }
+
+  StopThread();
+}
+
+void PikaCacheInvalidateThread::Wakeup() {
+  std::lock_guard lq(invalidate_mutex_);
+  invalidate_cond_.notify_one();
+}
+
+void *PikaCacheInvalidateThread::ThreadMain() {
+  LOG(INFO) << "PikaCacheInvalidateThread::ThreadMain Start";
+
+  while (!should_exit_) {
+    {
+      std::unique_lock lq(invalidate_mutex_);
+      // the timeout only guards against a lost wakeup, keys are normally
+      // drained as soon as the first one of a batch is queued
+      invalidate_cond_.wait_for(lq, std::chrono::milliseconds(CACHE_INVALIDATE_INTERVAL_MS), [this] {
+        return should_exit_ || cache_->InvalidatePendingKeysNum() > 0;
+      });
+      if (should_exit_) {
+        return nullptr;
+      }
+    }
+    cache_->DrainInvalidateQueue();
+  }
+
+  return nullptr;
+}
@@ -0,0 +1,215 @@
+// Copyright (c) 2023-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+#include <glog/logging.h>
+
+#include "include/pika_cache_write_behind_thread.h"
+#include "include/pika_cache.h"
+#include "include/pika_cmd_table_manager.h"
+#include "include/pika_rm.h"
+#include "include/pika_server.h"
+#include "pstd/include/scope_record_lock.h"
+
+extern PikaServer* g_pika_server;
+extern std::unique_ptr<PikaReplicaManager> g_pika_rm;
+extern std::unique_ptr<PikaCmdTableManager> g_pika_cmd_table_manager;
+
+PikaCacheWriteBehindThread::PikaCacheWriteBehindThread(std::string db_name)
+    : db_name_(std::move(db_name))
+      , should_exit_(false)
+      , write_behind_cond_()
+{
+  pending_deltas_.resize(CACHE_WRITE_BEHIND_STRIPE_NUM);
+  for (int i = 0; i < CACHE_WRITE_BEHIND_STRIPE_NUM; ++i) {
+    pending_mutexs_.push_back(std::make_shared<pstd::Mutex>());
+  }
+  set_thread_name("PikaCacheWriteBehindThread");
+}
+
+PikaCacheWriteBehindThread::~PikaCacheWriteBehindThread() {
+  {
+    std::lock_guard lq(write_behind_mutex_);
+    should_exit_ = true;
+    write_behind_cond_.notify_all();
+  }
+
+  StopThread();
+}
+
+void PikaCacheWriteBehindThread::AddDelta(const std::string& key, int64_t delta) {
+  int index = StripeIndex(key);
+  {
+    std::lock_guard lm(*pending_mutexs_[index]);
+    auto [iter, inserted] = pending_deltas_[index].try_emplace(key);
+    int64_t sum = 0;
+    if (!__builtin_add_overflow(iter->second.delta, delta, &sum)) {
+      inserted ? ++pending_keys_num_ : ++coalesced_incrs_num_;
+      iter->second.has_delta = true;
+      iter->second.delta = sum;
+      return;
+    }
+  }
+  // the coalesced delta would overflow, write the pending one first
+  Flush({key});
+  AddDelta(key, delta);
+}
+
+void PikaCacheWriteBehindThread::AddFieldDelta(const std::string& key, const std::string& field, int64_t delta) {
+  int index = StripeIndex(key);
+  {
+    std::lock_guard lm(*pending_mutexs_[index]);
+    auto [iter, inserted] = pending_deltas_[index].try_emplace(key);
+    auto [field_iter, field_inserted] = iter->second.field_deltas.try_emplace(field, 0);
+    int64_t sum = 0;
+    if (!__builtin_add_overflow(field_iter->second, delta, &sum)) {
+      inserted ? ++pending_keys_num_ : ++coalesced_incrs_num_;
+      field_iter->second = sum;
+      return;
+    }
+  }
+  Flush({key});
+  AddFieldDelta(key, field, delta);
+}
+
+void PikaCacheWriteBehindThread::Flush(const std::vector<std::string>& keys) {
+  if (0 == pending_keys_num_) {
+    return;
+  }
+  std::shared_ptr<DB> db = g_pika_server->GetDB(db_name_);
+  if (!db) {
+    return;
+  }
+  for (const auto& key : keys) {
+    CounterDeltas deltas;
+    if (TakeDeltas(key, &deltas)) {
+      ApplyDeltas(db, key, deltas);
+    }
+  }
+}
+
+void PikaCacheWriteBehindThread::Clear() {
+  for (int i = 0; i < CACHE_WRITE_BEHIND_STRIPE_NUM; ++i) {
+    std::lock_guard lm(*pending_mutexs_[i]);
+    pending_keys_num_ -= pending_deltas_[i].size();
+    pending_deltas_[i].clear();
+  }
+}
+
+void *PikaCacheWriteBehindThread::ThreadMain() {
+  LOG(INFO) << "PikaCacheWriteBehindThread::ThreadMain Start";
+
+  while (!should_exit_) {
+    {
+      int64_t interval_ms = g_pika_conf->cache_counter_write_behind_ms();
+      if (0 >= interval_ms) {
+        // disabled, only drain what was buffered before
+        interval_ms = CACHE_WRITE_BEHIND_IDLE_INTERVAL_MS;
+      }
+      std::unique_lock lq(write_behind_mutex_);
+      write_behind_cond_.wait_for(lq, std::chrono::milliseconds(interval_ms), [this] {
+        return should_exit_.load();
+      });
+      if (should_exit_) {
+        return nullptr;
+      }
+    }
+    FlushAll();
+  }
+
+  return nullptr;
+}
+
+void PikaCacheWriteBehindThread::FlushAll() {
+  if (0 == pending_keys_num_) {
+    return;
+  }
+  std::shared_ptr<DB> db = g_pika_server->GetDB(db_name_);
+  if (!db) {
+    return;
+  }
+  for (int i = 0; i < CACHE_WRITE_BEHIND_STRIPE_NUM; ++i) {
+    std::vector<std::string> keys;
+    {
+      std::lock_guard lm(*pending_mutexs_[i]);
+      keys.reserve(pending_deltas_[i].size());
+      for (const auto& item : pending_deltas_[i]) {
+        keys.push_back(item.first);
+      }
+    }
+    for (const auto& key : keys) {
+      // same lock order as a client write: record lock, then db lock
+      pstd::lock::ScopeRecordLock record_lock(db->LockMgr(), key);
+      db->DBLockShared();
+      CounterDeltas deltas;
+      if (TakeDeltas(key, &deltas)) {
+        ApplyDeltas(db, key, deltas);
+      }
+      db->DBUnlockShared();
+    }
+  }
+}
+
+int PikaCacheWriteBehindThread::StripeIndex(const std::string& key) {
+  return static_cast<int>(std::hash<std::string>{}(key) % pending_deltas_.size());
+}
+
+bool PikaCacheWriteBehindThread::TakeDeltas(const std::string& key, CounterDeltas* deltas) {
+  int index = StripeIndex(key);
+  std::lock_guard lm(*pending_mutexs_[index]);
+  auto iter = pending_deltas_[index].find(key);
+  if (iter == pending_deltas_[index].end()) {
+    return false;
+  }
+  *deltas = std::move(iter->second);
+  pending_deltas_[index].erase(iter);
+  --pending_keys_num_;
+  return true;
+}
+
+void PikaCacheWriteBehindThread::ApplyDeltas(const std::shared_ptr<DB>& db, const std::string& key,
+                                             const CounterDeltas& deltas) {
+  bool ok = true;
+  if ((g_pika_server->role() & PIKA_ROLE_SLAVE) != 0) {
+    // became a slave, the data of the key now comes from the master
+    LOG(WARNING) << db_name_ << " drop write-behind counter deltas of key " << key << " after becoming slave";
+    ok = false;
+  } else {
+    if (deltas.has_delta) {
+      ok = ApplyCommand(kCmdNameIncrby, {kCmdNameIncrby, key, std::to_string(deltas.delta)}) && ok;
+    }
+    for (const auto& [field, delta] : deltas.field_deltas) {
+      ok = ApplyCommand(kCmdNameHIncrby, {kCmdNameHIncrby, key, field, std::to_string(delta)}) && ok;
+    }
+  }
+  if (!ok) {
+    // the cached value is ahead of db, let the next read reload it
+    db->cache()->Del({key});
+  }
+  ++flushed_keys_num_;
+}
+
+bool PikaCacheWriteBehindThread::ApplyCommand(const std::string& name, const std::vector<std::string>& argv) {
+  std::shared_ptr<Cmd> cmd_ptr = g_pika_cmd_table_manager->GetCmd(name);
+  cmd_ptr->Initial(argv, db_name_);
+  if (cmd_ptr->res().ok()) {
+    cmd_ptr->Do();
+  }
+  if (!cmd_ptr->res().ok()) {
+    LOG(WARNING) << db_name_ << " write-behind " << name << " failed, key: " << argv[1]
+                 << ", error: " << cmd_ptr->res().message();
+    return false;
+  }
+  if (g_pika_conf->write_binlog()) {
+    std::shared_ptr<SyncMasterDB> sync_db = g_pika_rm->GetSyncMasterDBByName(DBInfo(db_name_));
+    if (!sync_db) {
+      return false;
+    }
+    pstd::Status s = sync_db->ConsensusProposeLog(cmd_ptr);
+    if (!s.ok()) {
+      LOG(ERROR) << db_name_ << " write-behind " << name << " to binlog failed, key: " << argv[1];
+      return false;
+    }
+  }
+  return true;
+}
@@ -268,6 +268,36 @@ bool PikaClientConn::IsInterceptedByRTC(std::string& opt) {
   return false;
 }
 
+// the thread pool ScheduleClientPool picks for argv, as a PikaAdmissionController::Pool
+// or kPoolNum for the admin pool
+static int CmdPool(const net::RedisCmdArgsType& argv) {
+  if (argv.empty()) {
+    return PikaAdmissionController::kFastPool;
+  }
+  std::string opt = argv[0];
+  pstd::StringToLower(opt);
+  if (g_pika_conf->is_slow_cmd(opt) && g_pika_conf->slow_cmd_pool()) {
+    return PikaAdmissionController::kSlowPool;
+  }
+  return g_pika_conf->is_admin_cmd(opt) ? PikaAdmissionController::kPoolNum : PikaAdmissionController::kFastPool;
+}
+
+size_t PikaClientConn::PipelineSegmentEnd(const std::vector<net::RedisCmdArgsType>& argvs, size_t begin,
+                                          bool* is_slow_cmd, bool* is_admin_cmd) {
+  int pool = CmdPool(argvs[begin]);
+  if (is_slow_cmd) {
+    *is_slow_cmd = pool == PikaAdmissionController::kSlowPool;
+  }
+  if (is_admin_cmd) {
+    *is_admin_cmd = pool == PikaAdmissionController::kPoolNum;
+  }
+  size_t end = begin + 1;
+  while (end < argvs.size() && CmdPool(argvs[end]) == pool) {
+    ++end;
+  }
+  return end;
+}
+
 void PikaClientConn::ProcessRedisCmds(const std::vector<net::RedisCmdArgsType>& argvs, bool async,
                                       std::string* response) {
   time_stat_->Reset();
@@ -278,15 +308,24 @@ void PikaClientConn::ProcessRedisCmds(const std::vector<net::RedisCmdArgsType>&
     time_stat_->enqueue_ts_ = time_stat_->before_queue_ts_ = pstd::NowMicros();
     arg->conn_ptr = std::dynamic_pointer_cast<PikaClientConn>(shared_from_this());
     /**
-     * If using the pipeline method to transmit batch commands to Pika, it is unable to
-     * correctly distinguish between fast and slow commands.
-     * However, if using the pipeline method for Codis, it can correctly distinguish between
+     * A pipeline mixing fast, slow and admin commands is split where the pool
+     * changes, the next part is scheduled when the one before is done.
+     * If using the pipeline method for Codis, it can correctly distinguish between
      * fast and slow commands, but it cannot guarantee sequential execution.
      */
     std::string opt = argvs[0][0];
     pstd::StringToLower(opt);
-    bool is_slow_cmd = g_pika_conf->is_slow_cmd(opt);
-    bool is_admin_cmd = g_pika_conf->is_admin_cmd(opt);
+    bool is_slow_cmd = false;
+    bool is_admin_cmd = false;
+    size_t segment_end = PipelineSegmentEnd(argvs, 0, &is_slow_cmd, &is_admin_cmd);
+    if (segment_end < argvs.size() && g_pika_conf->split_pipeline()) {
+      uint64_t segments = 1;
+      for (size_t end = segment_end; end < argvs.size(); ++segments) {
+        end = PipelineSegmentEnd(argvs, end, nullptr, nullptr);
+      }
+      g_pika_server->incr_split_pipelines(segments);
+      arg->segment_end = segment_end;
+    }
 
     // we don't intercept pipeline batch (argvs.size() > 1)
     if (g_pika_conf->rtc_cache_read_enabled() && argvs.size() == 1 && IsInterceptedByRTC(opt) &&
@@ -300,7 +339,24 @@ void PikaClientConn::ProcessRedisCmds(const std::vector<net::RedisCmdArgsType>&
       time_stat_->before_queue_ts_ = pstd::NowMicros();
     }
 
-    g_pika_server->ScheduleClientPool(&DoBackgroundTask, arg, is_slow_cmd, is_admin_cmd);
+    arg->cmd_pool = CmdPool(argvs[0]);
+    auto queue_target_us = static_cast<uint64_t>(g_pika_conf->admission_queue_target_us());
+    if (is_admin_cmd || IsInTxn() || queue_target_us == 0) {
+      g_pika_server->ScheduleClientPool(&DoBackgroundTask, arg, is_slow_cmd, is_admin_cmd);
+      return;
+    }
+    PikaAdmissionController* admission_controller = g_pika_server->admission_controller();
+    // the later parts of a split pipeline are admitted when they are scheduled
+    size_t cmd_num = arg->segment_end != 0 ? arg->segment_end : argvs.size();
+    bool admitted = admission_controller->Admit(arg->cmd_pool, cmd_num, queue_target_us, &admission_state_);
+    if (admitted && g_pika_server->TryScheduleClientPool(&DoBackgroundTask, arg, is_slow_cmd, is_admin_cmd)) {
+      return;
+    }
+    // a full queue is rejected too, waiting for room would block the worker
+    // thread and every conn of it
+    admission_controller->Reject(admitted ? argvs.size() : argvs.size() - cmd_num);
+    delete arg;
+    ReplyBusy(argvs.size());
     return;
   }
   BatchExecRedisCmd(argvs, false);
@@ -310,20 +366,80 @@ void PikaClientConn::DoBackgroundTask(void* arg) {
   std::unique_ptr<BgTaskArg> bg_arg(static_cast<BgTaskArg*>(arg));
   std::shared_ptr<PikaClientConn> conn_ptr = bg_arg->conn_ptr;
   conn_ptr->time_stat_->dequeue_ts_ = pstd::NowMicros();
+  if (bg_arg->segment_begin == 0) {
+    g_pika_server->admission_controller()->Observe(
+        bg_arg->cmd_pool, conn_ptr->time_stat_->queue_time(),
+        static_cast<uint64_t>(g_pika_conf->admission_queue_target_us()));
+  }
   if (bg_arg->redis_cmds.empty()) {
     conn_ptr->NotifyEpoll(false);
     return;
   }
-  for (const auto& argv : bg_arg->redis_cmds) {
-    if (argv.empty()) {
-      conn_ptr->NotifyEpoll(false);
-      return;
+  // the later parts of a split pipeline were checked with the first one
+  if (bg_arg->segment_begin == 0) {
+    for (const auto& argv : bg_arg->redis_cmds) {
+      if (argv.empty()) {
+        conn_ptr->NotifyEpoll(false);
+        return;
+      }
     }
   }
 
+  if (bg_arg->segment_end != 0) {
+    conn_ptr->ExecPipelineSegment(std::move(bg_arg));
+    return;
+  }
   conn_ptr->BatchExecRedisCmd(bg_arg->redis_cmds, bg_arg->cache_miss_in_rtc_);
 }
 
+void PikaClientConn::ExecPipelineSegment(std::unique_ptr<BgTaskArg> bg_arg) {
+  const std::vector<net::RedisCmdArgsType>& argvs = bg_arg->redis_cmds;
+  if (bg_arg->segment_begin == 0) {
+    resp_num.store(static_cast<int32_t>(argvs.size()));
+  }
+  while (true) {
+    for (size_t i = bg_arg->segment_begin; i < bg_arg->segment_end; ++i) {
+      std::shared_ptr<std::string> resp_ptr = std::make_shared<std::string>();
+      resp_array.push_back(resp_ptr);
+      ExecRedisCmd(argvs[i], resp_ptr, false);
+    }
+    if (bg_arg->segment_end == argvs.size()) {
+      time_stat_->process_done_ts_ = pstd::NowMicros();
+      TryWriteResp();
+      return;
+    }
+    // the conn reads nothing more before the reply, so this is the only task of
+    // the pipeline in flight and the next part sees what this one wrote
+    bool is_slow_cmd = false;
+    bool is_admin_cmd = false;
+    bg_arg->segment_begin = bg_arg->segment_end;
+    bg_arg->segment_end = PipelineSegmentEnd(argvs, bg_arg->segment_begin, &is_slow_cmd, &is_admin_cmd);
+    bg_arg->cmd_pool = CmdPool(argvs[bg_arg->segment_begin]);
+    auto queue_target_us = static_cast<uint64_t>(g_pika_conf->admission_queue_target_us());
+    bool rejectable = !is_admin_cmd && !IsInTxn() && queue_target_us != 0;
+    PikaAdmissionController* admission_controller = g_pika_server->admission_controller();
+    size_t rest_cmd_num = argvs.size() - bg_arg->segment_begin;
+    if (rejectable && !admission_controller->Admit(bg_arg->cmd_pool, bg_arg->segment_end - bg_arg->segment_begin,
+                                                   queue_target_us, &admission_state_)) {
+      admission_controller->Reject(argvs.size() - bg_arg->segment_end);
+      ReplyBusy(rest_cmd_num);
+      return;
+    }
+    // a pool thread never waits for room in a pool, pools full of such waits
+    // would wait on each other for good. The next part gets -BUSY like a
+    // first one would, or runs here if it can not be rejected.
+    if (g_pika_server->TryScheduleClientPool(&DoBackgroundTask, bg_arg.get(), is_slow_cmd, is_admin_cmd)) {
+      bg_arg.release();
+      return;
+    }
+    if (rejectable) {
+      admission_controller->Reject(rest_cmd_num);
+      ReplyBusy(rest_cmd_num);
+      return;
+    }
+  }
+}
+
 void PikaClientConn::BatchExecRedisCmd(const std::vector<net::RedisCmdArgsType>& argvs, bool cache_miss_in_rtc) {
   resp_num.store(static_cast<int32_t>(argvs.size()));
   for (const auto& argv : argvs) {
@@ -379,6 +495,18 @@ bool PikaClientConn::ReadCmdInCache(const net::RedisCmdArgsType& argv, const std
   return read_status;
 }
 
+void PikaClientConn::ReplyBusy(size_t cmd_num) {
+  resp_num.store(0);
+  for (size_t i = 0; i < cmd_num; ++i) {
+    resp_array.emplace_back(std::make_shared<std::string>("-BUSY server is overloaded, try again later\r\n"));
+  }
+  TryWriteResp();
+}
+
+net::OutputBufferLimit PikaClientConn::output_buffer_limit() {
+  return g_pika_conf->client_output_buffer_limit(IsPubSub() ? kOutputBufferPubSub : kOutputBufferNormal);
+}
+
 void PikaClientConn::TryWriteResp() {
   int expected = 0;
   if (resp_num.compare_exchange_strong(expected, -1)) {
@@ -390,7 +518,7 @@ void PikaClientConn::TryWriteResp() {
       write_completed_cb_ = nullptr;
     }
     resp_array.clear();
-    NotifyEpoll(true);
+    NotifyEpoll(true, g_pika_conf->reply_direct_write());
   }
 }
 
@@ -29,6 +29,8 @@ void PikaClientProcessor::Stop() {
 
 void PikaClientProcessor::SchedulePool(net::TaskFunc func, void* arg) { pool_->Schedule(func, arg); }
 
+bool PikaClientProcessor::TrySchedulePool(net::TaskFunc func, void* arg) { return pool_->TrySchedule(func, arg); }
+
 size_t PikaClientProcessor::ThreadPoolCurQueueSize() {
   size_t cur_size = 0;
   if (pool_) {
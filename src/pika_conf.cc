@@ -13,6 +13,7 @@
 #include "include/pika_cmd_table_manager.h"
 #include "include/pika_conf.h"
 #include "include/pika_define.h"
+#include "include/pika_repl_compression.h"
 
 using pstd::Status;
 extern std::unique_ptr<PikaCmdTableManager> g_pika_cmd_table_manager;
@@ -20,6 +21,19 @@ extern std::unique_ptr<PikaCmdTableManager> g_pika_cmd_table_manager;
 PikaConf::PikaConf(const std::string& path)
     : pstd::BaseConf(path), conf_path_(path) {}
 
+static std::string OutputBufferLimitsString(
+    const std::array<net::OutputBufferLimit, kOutputBufferClassNum>& limits) {
+  std::string value;
+  for (int i = 0; i < kOutputBufferClassNum; ++i) {
+    if (!value.empty()) {
+      value.append(" ");
+    }
+    value.append(ClientOutputBufferClassName[i] + " " + std::to_string(limits[i].hard_bytes) + " "
+                 + std::to_string(limits[i].soft_bytes) + " " + std::to_string(limits[i].soft_seconds));
+  }
+  return value;
+}
+
 int PikaConf::Load() {
   int ret = LoadConf();
   if (ret) {
@@ -70,6 +84,9 @@ int PikaConf::Load() {
   std::string slowcmdpool;
   GetConfStr("slow-cmd-pool", &slowcmdpool);
   slow_cmd_pool_.store(slowcmdpool == "yes" ? true : false);
+  std::string split_pipeline;
+  GetConfStr("split-pipeline", &split_pipeline);
+  split_pipeline_.store(split_pipeline != "no");
 
   int binlog_writer_num = 1;
   GetConfInt("binlog-writer-num", &binlog_writer_num);
@@ -83,6 +100,10 @@ int PikaConf::Load() {
   GetConfInt("slowlog-log-slower-than", &tmp_slowlog_log_slower_than);
   slowlog_log_slower_than_.store(tmp_slowlog_log_slower_than);
 
+  int admission_queue_target_us = 0;
+  GetConfInt("admission-queue-target-us", &admission_queue_target_us);
+  admission_queue_target_us_.store(std::max(admission_queue_target_us, 0));
+
   GetConfInt("slowlog-max-len", &slowlog_max_len_);
   if (slowlog_max_len_ == 0) {
     slowlog_max_len_ = 128;
@@ -118,6 +139,9 @@ int PikaConf::Load() {
   // set slave read only true as default
   slave_read_only_ = true;
   GetConfInt("slave-priority", &slave_priority_);
+  std::string slave_serve_slaves;
+  GetConfStr("slave-serve-slaves", &slave_serve_slaves);
+  slave_serve_slaves_ = slave_serve_slaves == "yes";
 
   //
   // Immutable Sections
@@ -161,6 +185,13 @@ int PikaConf::Load() {
   if (thread_num_ <= 0) {
     thread_num_ = 12;
   }
+  std::string reuse_port;
+  GetConfStr("reuse-port", &reuse_port);
+  reuse_port_ = reuse_port == "yes";
+  std::string reuse_port_cpu_steering;
+  GetConfStr("reuse-port-cpu-steering", &reuse_port_cpu_steering);
+  reuse_port_cpu_steering_ = reuse_port_cpu_steering == "yes";
+  GetConfStr("thread-placement", &thread_placement_);
 
   GetConfInt("thread-pool-size", &thread_pool_size_);
   if (thread_pool_size_ <= 0) {
@@ -186,6 +217,14 @@ int PikaConf::Load() {
     admin_thread_pool_size_ = 4;
   }
 
+  GetConfInt("pubsub-thread-num", &pubsub_thread_num_);
+  if (pubsub_thread_num_ <= 0) {
+    pubsub_thread_num_ = 1;
+  }
+  if (pubsub_thread_num_ > 24) {
+    pubsub_thread_num_ = 24;
+  }
+
   std::string slow_cmd_list;
   GetConfStr("slow-cmd-list", &slow_cmd_list);
   SetSlowCmd(slow_cmd_list);
@@ -705,6 +744,28 @@ int PikaConf::Load() {
   int cache_lfu_decay_time = 1;
   GetConfInt("cache-lfu-decay-time", &cache_lfu_decay_time);
   cache_lfu_decay_time_ = (0 > cache_lfu_decay_time) ? 1 : cache_lfu_decay_time;
+
+  // replicated writes only invalidate cached keys, the cache is refilled lazily by reads
+  std::string slave_cache_invalidate;
+  GetConfStr("slave-cache-invalidate", &slave_cache_invalidate);
+  slave_cache_invalidate_ = slave_cache_invalidate == "yes";
+
+  // per data type memory budget, e.g. "zset:30,hash:40", types not listed are unlimited
+  std::string cache_type_maxmemory_percent;
+  GetConfStr("cache-type-maxmemory-percent", &cache_type_maxmemory_percent);
+  if (!ParseCacheTypeMaxmemoryPercent(cache_type_maxmemory_percent, cache_type_maxmemory_percent_)) {
+    LOG(ERROR) << "invalid cache-type-maxmemory-percent: " << cache_type_maxmemory_percent << ", ignored";
+  }
+
+  // counters in cache are written to db once per window, 0 means disabled
+  int64_t cache_counter_write_behind_ms = 0;
+  GetConfInt64("cache-counter-write-behind-ms", &cache_counter_write_behind_ms);
+  cache_counter_write_behind_ms_ = (0 > cache_counter_write_behind_ms) ? 0 : cache_counter_write_behind_ms;
+
+  // remember keys missing in db for a while, 0 means disabled
+  int64_t cache_negative_ttl_ms = 0;
+  GetConfInt64("cache-negative-ttl-ms", &cache_negative_ttl_ms);
+  cache_negative_ttl_ms_ = (0 > cache_negative_ttl_ms) ? 0 : cache_negative_ttl_ms;
   // sync window size
   int tmp_sync_window_size = kBinlogReadWinDefaultSize;
   GetConfInt("sync-window-size", &tmp_sync_window_size);
@@ -716,6 +777,44 @@ int PikaConf::Load() {
     sync_window_size_.store(tmp_sync_window_size);
   }
 
+  // binlog tail cache size
+  int64_t tmp_binlog_tail_cache_size = PIKA_BINLOG_TAIL_CACHE_SIZE;
+  GetConfInt64Human("binlog-tail-cache-size", &tmp_binlog_tail_cache_size);
+  binlog_tail_cache_size_.store(tmp_binlog_tail_cache_size < 0 ? 0 : tmp_binlog_tail_cache_size);
+
+  // format of the binlog records written from now on
+  GetConfStr("binlog-format", &binlog_format_);
+  if (binlog_format_ != "resp" && binlog_format_ != "compact") {
+    binlog_format_ = "resp";
+  }
+  binlog_compact_format_.store(binlog_format_ == "compact");
+
+  std::string binlog_checksum;
+  GetConfStr("binlog-checksum", &binlog_checksum);
+  binlog_checksum_ = binlog_checksum == "yes";
+
+  // compression of binlog sync to slaves
+  GetConfStr("replication-compression", &replication_compression_);
+  InnerMessage::CompressionType compression;
+  if (!StringToReplCompression(replication_compression_, &compression)) {
+    replication_compression_ = "none";
+  }
+  int tmp_replication_compression_level = 1;
+  GetConfInt("replication-compression-level", &tmp_replication_compression_level);
+  if (tmp_replication_compression_level < 1 || tmp_replication_compression_level > 22) {
+    tmp_replication_compression_level = 1;
+  }
+  replication_compression_level_.store(tmp_replication_compression_level);
+
+  // group commit of the commands a slave applies while catching up
+  int tmp_replication_apply_batch_cmds = PIKA_REPL_APPLY_BATCH_CMDS;
+  GetConfInt("replication-apply-batch-cmds", &tmp_replication_apply_batch_cmds);
+  replication_apply_batch_cmds_.store(tmp_replication_apply_batch_cmds < 1 ? 1 : tmp_replication_apply_batch_cmds);
+  int64_t tmp_replication_apply_batch_bytes = PIKA_REPL_APPLY_BATCH_BYTES;
+  GetConfInt64Human("replication-apply-batch-bytes", &tmp_replication_apply_batch_bytes);
+  replication_apply_batch_bytes_.store(tmp_replication_apply_batch_bytes <= 0 ? PIKA_REPL_APPLY_BATCH_BYTES
+                                                                              : tmp_replication_apply_batch_bytes);
+
   // max conn rbuf size
   int tmp_max_conn_rbuf_size = PIKA_MAX_CONN_RBUF;
   GetConfIntHuman("max-conn-rbuf-size", &tmp_max_conn_rbuf_size);
@@ -727,6 +826,16 @@ int PikaConf::Load() {
     max_conn_rbuf_size_.store(tmp_max_conn_rbuf_size);
   }
 
+  std::string reply_direct_write;
+  GetConfStr("reply-direct-write", &reply_direct_write);
+  reply_direct_write_ = reply_direct_write == "yes";
+
+  std::string client_output_buffer_limit;
+  GetConfStr("client-output-buffer-limit", &client_output_buffer_limit);
+  if (!ParseClientOutputBufferLimit(client_output_buffer_limit, &client_output_buffer_limits_)) {
+    LOG(FATAL) << "client-output-buffer-limit " << client_output_buffer_limit << " is invalid";
+  }
+
   // rocksdb blob configure
   GetConfBool("enable-blob-files", &enable_blob_files_);
   GetConfInt64Human("min-blob-size", &min_blob_size_);
@@ -761,6 +870,17 @@ int PikaConf::Load() {
     max_rsync_parallel_num_ = kMaxRsyncParallelNum;
   }
 
+  int max_rsync_window_num = kDefaultRsyncWindowNum;
+  GetConfInt("max-rsync-window-num", &max_rsync_window_num);
+  if (max_rsync_window_num <= 0 || max_rsync_window_num > kMaxRsyncWindowNum) {
+    max_rsync_window_num = kDefaultRsyncWindowNum;
+  }
+  max_rsync_window_num_.store(max_rsync_window_num);
+
+  std::string dbsync_streaming;
+  GetConfStr("dbsync-streaming", &dbsync_streaming);
+  dbsync_streaming_ = dbsync_streaming == "yes";
+
   // rocksdb_statistics_tickers
   std::string open_tickers;
   GetConfStr("enable-db-statistics", &open_tickers);
@@ -837,9 +957,12 @@ int PikaConf::ConfigRewrite() {
   SetConfInt("root-connection-num", root_connection_num_);
   SetConfStr("slowlog-write-errorlog", slowlog_write_errorlog_.load() ? "yes" : "no");
   SetConfInt("slowlog-log-slower-than", slowlog_log_slower_than_.load());
+  SetConfInt("admission-queue-target-us", admission_queue_target_us_.load());
+  SetConfStr("thread-placement", thread_placement_);
   SetConfInt("slowlog-max-len", slowlog_max_len_);
   SetConfInt("log-retention-time", log_retention_time_);
   SetConfInt("slave-priority", slave_priority_);
+  SetConfStr("slave-serve-slaves", slave_serve_slaves_ ? "yes" : "no");
   SetConfStr("log-net-activities", log_net_activities_ ? "yes" : "no");
   SetConfStr("write-binlog", write_binlog_ ? "yes" : "no");
   SetConfStr("run-id", run_id_);
@@ -891,11 +1014,23 @@ int PikaConf::ConfigRewrite() {
   SetConfInt("throttle-bytes-per-second", throttle_bytes_per_second_);
   SetConfStr("internal-used-unfinished-full-sync", pstd::Set2String(internal_used_unfinished_full_sync_, ','));
   SetConfInt("max-rsync-parallel-num", max_rsync_parallel_num_);
+  SetConfInt("max-rsync-window-num", max_rsync_window_num_.load());
+  SetConfStr("dbsync-streaming", dbsync_streaming_ ? "yes" : "no");
   SetConfInt("sync-window-size", sync_window_size_.load());
+  SetConfInt64("binlog-tail-cache-size", binlog_tail_cache_size_.load());
+  SetConfStr("binlog-format", binlog_format_);
+  SetConfStr("binlog-checksum", binlog_checksum_ ? "yes" : "no");
+  SetConfStr("replication-compression", replication_compression_);
+  SetConfInt("replication-compression-level", replication_compression_level_.load());
+  SetConfInt("replication-apply-batch-cmds", replication_apply_batch_cmds_.load());
+  SetConfInt64("replication-apply-batch-bytes", replication_apply_batch_bytes_.load());
   SetConfInt("consensus-level", consensus_level_.load());
   SetConfInt("replication-num", replication_num_.load());
   SetConfStr("slow-cmd-list", pstd::Set2String(slow_cmd_set_, ','));
+  SetConfStr("split-pipeline", split_pipeline_.load() ? "yes" : "no");
   SetConfInt("max-conn-rbuf-size", max_conn_rbuf_size_.load());
+  SetConfStr("reply-direct-write", reply_direct_write_ ? "yes" : "no");
+  SetConfStr("client-output-buffer-limit", OutputBufferLimitsString(client_output_buffer_limits_));
   // options for storage engine
   SetConfInt("max-cache-files", max_cache_files_);
   SetConfInt("max-background-compactions", max_background_compactions_);
@@ -923,6 +1058,10 @@ int PikaConf::ConfigRewrite() {
   SetConfInt("cache-model", cache_mode_);
   SetConfInt("zset-cache-start-direction", zset_cache_start_direction_);
   SetConfInt("zset_cache_field_num_per_key", zset_cache_field_num_per_key_);
+  SetConfStr("slave-cache-invalidate", slave_cache_invalidate_ ? "yes" : "no");
+  SetConfInt64("cache-negative-ttl-ms", cache_negative_ttl_ms_);
+  SetConfInt64("cache-counter-write-behind-ms", cache_counter_write_behind_ms_);
+  SetConfStr("cache-type-maxmemory-percent", cache_type_maxmemory_percent_string());
 
   if (!diff_commands_.empty()) {
     std::vector<pstd::BaseConf::Rep::ConfItem> filtered_items;
@@ -1006,6 +1145,102 @@ rocksdb::CompressionType PikaConf::GetCompression(const std::string& value) {
   return rocksdb::CompressionType::kNoCompression;
 }
 
+bool PikaConf::ParseCacheTypeMaxmemoryPercent(const std::string& value, std::atomic_int* percents) {
+  int tmp_percents[PIKA_CACHE_TYPE_NUM] = {100, 100, 100, 100, 100};
+  std::vector<std::string> items;
+  pstd::StringSplit(value, COMMA, items);
+  for (const auto& item : items) {
+    std::vector<std::string> type_percent;
+    pstd::StringSplit(item, ':', type_percent);
+    long percent = 0;
+    if (type_percent.size() != 2
+        || !pstd::string2int(type_percent[1].data(), type_percent[1].size(), &percent)
+        || percent < 1 || percent > 100) {
+      return false;
+    }
+    std::string type = pstd::StringTrim(type_percent[0]);
+    pstd::StringToLower(type);
+    auto iter = std::find(std::begin(PIKA_CACHE_TYPE_NAMES), std::end(PIKA_CACHE_TYPE_NAMES), type);
+    if (iter == std::end(PIKA_CACHE_TYPE_NAMES)) {
+      return false;
+    }
+    tmp_percents[iter - std::begin(PIKA_CACHE_TYPE_NAMES)] = static_cast<int>(percent);
+  }
+  for (int i = 0; i < PIKA_CACHE_TYPE_NUM; ++i) {
+    percents[i] = tmp_percents[i];
+  }
+  return true;
+}
+
+std::string PikaConf::cache_type_maxmemory_percent_string() {
+  std::vector<std::string> items;
+  for (int i = 0; i < PIKA_CACHE_TYPE_NUM; ++i) {
+    if (cache_type_maxmemory_percent_[i] < 100) {
+      items.push_back(std::string(PIKA_CACHE_TYPE_NAMES[i]) + ":" + std::to_string(cache_type_maxmemory_percent_[i]));
+    }
+  }
+  return pstd::StringConcat(items, COMMA);
+}
+
+bool PikaConf::SetCacheTypeMaxmemoryPercent(const std::string& value) {
+  if (!ParseCacheTypeMaxmemoryPercent(value, cache_type_maxmemory_percent_)) {
+    return false;
+  }
+  TryPushDiffCommands("cache-type-maxmemory-percent", cache_type_maxmemory_percent_string());
+  return true;
+}
+
+bool PikaConf::ParseClientOutputBufferLimit(const std::string& value,
+                                            std::array<net::OutputBufferLimit, kOutputBufferClassNum>* limits) {
+  auto tmp_limits = *limits;
+  std::vector<std::string> items;
+  pstd::StringSplit(value, ' ', items);
+  if (items.size() % 4 != 0) {
+    return false;
+  }
+  for (size_t i = 0; i < items.size(); i += 4) {
+    std::string client_class = items[i];
+    pstd::StringToLower(client_class);
+    // slave is what redis called the replicas before 5.0
+    if (client_class == "slave") {
+      client_class = "replica";
+    }
+    auto iter = std::find(std::begin(ClientOutputBufferClassName), std::end(ClientOutputBufferClassName), client_class);
+    if (iter == std::end(ClientOutputBufferClassName)) {
+      return false;
+    }
+    int hard_err = 0;
+    int soft_err = 0;
+    long long hard_bytes = pstd::memtoll(items[i + 1].c_str(), &hard_err);
+    long long soft_bytes = pstd::memtoll(items[i + 2].c_str(), &soft_err);
+    long soft_seconds = 0;
+    if (hard_err != 0 || soft_err != 0 || hard_bytes < 0 || soft_bytes < 0
+        || !pstd::string2int(items[i + 3].data(), items[i + 3].size(), &soft_seconds) || soft_seconds < 0) {
+      return false;
+    }
+    net::OutputBufferLimit& limit = tmp_limits[iter - std::begin(ClientOutputBufferClassName)];
+    limit.hard_bytes = static_cast<uint64_t>(hard_bytes);
+    limit.soft_bytes = static_cast<uint64_t>(soft_bytes);
+    limit.soft_seconds = static_cast<int>(soft_seconds);
+  }
+  *limits = tmp_limits;
+  return true;
+}
+
+std::string PikaConf::client_output_buffer_limit_string() {
+  std::shared_lock l(rwlock_);
+  return OutputBufferLimitsString(client_output_buffer_limits_);
+}
+
+bool PikaConf::SetClientOutputBufferLimit(const std::string& value) {
+  std::lock_guard l(rwlock_);
+  if (!ParseClientOutputBufferLimit(value, &client_output_buffer_limits_)) {
+    return false;
+  }
+  TryPushDiffCommands("client-output-buffer-limit", OutputBufferLimitsString(client_output_buffer_limits_));
+  return true;
+}
+
 std::vector<rocksdb::CompressionType> PikaConf::compression_per_level() {
   std::shared_lock l(rwlock_);
   std::vector<rocksdb::CompressionType> types;
@@ -337,6 +337,11 @@ Status ConsensusCoordinator::InternalAppendLog(const std::shared_ptr<Cmd>& cmd_p
   return InternalAppendBinlog(cmd_ptr);
 }
 
+Status ConsensusCoordinator::InternalAppendLeaderLog(const std::shared_ptr<Cmd>& cmd_ptr,
+                                                     const BinlogItem& attribute) {
+  return InternalAppendBinlog(cmd_ptr, &attribute);
+}
+
 // precheck if prev_offset match && drop this log if this log exist
 Status ConsensusCoordinator::ProcessLeaderLog(const std::shared_ptr<Cmd>& cmd_ptr, const BinlogItem& attribute) {
   LogOffset last_index = mem_logger_->last_offset();
@@ -349,7 +354,7 @@ Status ConsensusCoordinator::ProcessLeaderLog(const std::shared_ptr<Cmd>& cmd_pt
   auto opt = cmd_ptr->argv()[0];
   if (pstd::StringToLower(opt) != kCmdNameFlushdb) {
     // apply binlog in sync way
-    Status s = InternalAppendLog(cmd_ptr);
+    Status s = InternalAppendLeaderLog(cmd_ptr, attribute);
     // apply db in async way
     InternalApplyFollower(cmd_ptr);
   } else {
@@ -362,10 +367,12 @@ Status ConsensusCoordinator::ProcessLeaderLog(const std::shared_ptr<Cmd>& cmd_pt
       wait_ms = wait_ms < 3000 ? wait_ms : 3000;
     }
     // apply flushdb-binlog in sync way
-    Status s = InternalAppendLog(cmd_ptr);
+    Status s = InternalAppendLeaderLog(cmd_ptr, attribute);
     // applyDB in sync way
     PikaReplBgWorker::WriteDBInSyncWay(cmd_ptr);
   }
+  // the slaves of this slave, if any, get the log right away
+  g_pika_server->SignalAuxiliary();
   return Status::OK();
 }
 
@@ -380,9 +387,22 @@ Status ConsensusCoordinator::UpdateSlave(const std::string& ip, int port, const
   return Status::OK();
 }
 
-Status ConsensusCoordinator::InternalAppendBinlog(const std::shared_ptr<Cmd>& cmd_ptr) {
+Status ConsensusCoordinator::InternalAppendBinlog(const std::shared_ptr<Cmd>& cmd_ptr, const BinlogItem* attribute) {
   std::string content = cmd_ptr->ToRedisProtocol();
-  Status s = stable_logger_->Logger()->Put(content);
+  BinlogType type = TypeFirst;
+  // a leader log keeps the format of the leader whatever binlog-format says
+  // here, or the offsets of this binlog would drift away from the leader ones
+  bool compact = attribute ? attribute->type() == TypeCompact : g_pika_conf->binlog_compact_format();
+  if (compact) {
+    std::string compact_content;
+    // padding and other records not in plain redis protocol stay as they are
+    if (PikaBinlogTransverter::RedisProtocolToCompactContent(content, &compact_content)) {
+      content.swap(compact_content);
+      type = TypeCompact;
+    }
+  }
+  Status s = attribute ? stable_logger_->Logger()->PutReplicated(content, type, *attribute)
+                       : stable_logger_->Logger()->Put(content, type);
   if (!s.ok()) {
     std::string db_name = cmd_ptr->db_name().empty() ? g_pika_conf->default_db() : cmd_ptr->db_name();
     std::shared_ptr<DB> db = g_pika_server->GetDB(db_name);
@@ -3,7 +3,10 @@
 // LICENSE file in the root directory of this source tree. An additional grant
 // of patent rights can be found in the PATENTS file in the same directory.
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <thread>
 #include <utility>
 
 #include "include/pika_db.h"
@@ -12,6 +15,7 @@
 #include "include/pika_rm.h"
 #include "include/pika_server.h"
 #include "mutex_impl.h"
+#include "pstd/include/pstd_defer.h"
 
 using pstd::Status;
 extern PikaServer* g_pika_server;
@@ -52,6 +56,7 @@ DB::DB(std::string db_name, const std::string& db_path,
 
 DB::~DB() {
   StopKeyScan();
+  cache_write_behind_.reset();
 }
 
 bool DB::WashData() {
@@ -83,7 +88,7 @@ bool DB::WashData() {
 
 std::string DB::GetDBName() { return db_name_; }
 
-void DB::BgSaveDB() {
+void DB::BgSaveDB(bool for_sync) {
   std::shared_lock l(dbs_rw_);
   std::lock_guard ml(bgsave_protector_);
   if (bgsave_info_.bgsaving) {
@@ -92,6 +97,7 @@ void DB::BgSaveDB() {
   bgsave_info_.bgsaving = true;
   auto bg_task_arg = new BgTaskArg();
   bg_task_arg->db = shared_from_this();
+  bg_task_arg->streaming = for_sync && g_pika_conf->dbsync_streaming();
   g_pika_server->BGSaveTaskSchedule(&DoBgSave, static_cast<void*>(bg_task_arg));
 }
 
@@ -233,6 +239,7 @@ bool DB::FlushDBWithoutLock() {
   }
 
   LOG(INFO) << db_name_ << " Delete old db...";
+  ReleaseStreamingBgSaveWithoutLock();
   storage_.reset();
 
   std::string dbpath = db_path_;
@@ -255,6 +262,8 @@ bool DB::FlushDBWithoutLock() {
     return false;
   }
   LOG(INFO) << db_name_ << " Open new db success";
+  // the counters buffered for the flushed keys are gone with them
+  cache_write_behind_->Clear();
 
   g_pika_server->PurgeDir(dbpath);
   return true;
@@ -264,7 +273,7 @@ void DB::DoBgSave(void* arg) {
   std::unique_ptr<BgTaskArg> bg_task_arg(static_cast<BgTaskArg*>(arg));
 
   // Do BgSave
-  bool success = bg_task_arg->db->RunBgsaveEngine();
+  bool success = bg_task_arg->db->RunBgsaveEngine(bg_task_arg->streaming);
 
   // Some output
   BgSaveInfo info = bg_task_arg->db->bgsave_info();
@@ -288,7 +297,7 @@ void DB::DoBgSave(void* arg) {
   bg_task_arg->db->FinishBgsave();
 }
 
-bool DB::RunBgsaveEngine() {
+bool DB::RunBgsaveEngine(bool streaming) {
   // Prepare for Bgsaving
   if (!InitBgsaveEnv() || !InitBgsaveEngine()) {
     ClearBgsave();
@@ -300,6 +309,29 @@ bool DB::RunBgsaveEngine() {
   LOG(INFO) << db_name_ << " bgsave_info: path=" << info.path << ",  filenum=" << info.offset.b_offset.filenum
             << ", offset=" << info.offset.b_offset.offset;
 
+  if (streaming) {
+    // only the small files are written to the bgsave dir, the sst files are
+    // served from the db dir, where they stay until the bgsave is released
+    std::map<int, std::vector<std::string>> table_files;
+    rocksdb::Status s = bgsave_engine_->CreateNewStreamingBackup(info.path, &table_files);
+    if (!s.ok()) {
+      LOG(WARNING) << db_name_ << " create new streaming backup failed :" << s.ToString();
+      return false;
+    }
+    std::map<std::string, std::string> stream_files;
+    for (const auto& [index, files] : table_files) {
+      for (const auto& file : files) {
+        stream_files[std::to_string(index) + file.substr(file.rfind('/'))] = file;
+      }
+    }
+    LOG(INFO) << db_name_ << " create new streaming backup finished, " << stream_files.size()
+              << " sst files are read from the db dir";
+    std::lock_guard l(bgsave_protector_);
+    bgsave_stream_files_ = std::move(stream_files);
+    bgsave_info_.streaming = true;
+    return true;
+  }
+
   // Backup to tmp dir
   rocksdb::Status s = bgsave_engine_->CreateNewBackup(info.path);
 
@@ -312,6 +344,51 @@ bool DB::RunBgsaveEngine() {
   return true;
 }
 
+std::string DB::BgSaveFilePath(const std::string& filename) {
+  std::lock_guard l(bgsave_protector_);
+  auto iter = bgsave_stream_files_.find(filename);
+  if (iter != bgsave_stream_files_.end()) {
+    return iter->second;
+  }
+  return bgsave_info_.path + "/" + filename;
+}
+
+// bgsave_protector_ is held
+void DB::ReleaseStreamingBgSaveWithoutLock() {
+  if (!bgsave_info_.streaming) {
+    return;
+  }
+  LOG(INFO) << db_name_ << " release the sst files of the streaming bgsave " << bgsave_info_.path;
+  if (bgsave_engine_) {
+    bgsave_engine_->ReleaseFiles();
+  }
+  bgsave_stream_files_.clear();
+  // useless without the sst files, a later full sync makes a new one
+  pstd::DeleteDirIfExist(bgsave_info_.path);
+  bgsave_info_.path.clear();
+  bgsave_info_.offset = LogOffset();
+  bgsave_info_.streaming = false;
+  snapshot_uuid_.clear();
+}
+
+void DB::AutoReleaseStreamingBgSave() {
+  {
+    std::lock_guard l(bgsave_protector_);
+    // leave the slave which asked for it the time to start pulling
+    if (!bgsave_info_.streaming || bgsave_info_.bgsaving || time(nullptr) - bgsave_finish_time_ < 60) {
+      return;
+    }
+  }
+  std::shared_ptr<SyncMasterDB> sync_db = g_pika_rm->GetSyncMasterDBByName(DBInfo(db_name_));
+  if (sync_db && sync_db->HasDbSyncSlave()) {
+    return;
+  }
+  std::lock_guard l(bgsave_protector_);
+  if (!bgsave_info_.bgsaving) {
+    ReleaseStreamingBgSaveWithoutLock();
+  }
+}
+
 BgSaveInfo DB::bgsave_info() {
   std::lock_guard l(bgsave_protector_);
   return bgsave_info_;
@@ -320,12 +397,14 @@ BgSaveInfo DB::bgsave_info() {
 void DB::FinishBgsave() {
   std::lock_guard l(bgsave_protector_);
   bgsave_info_.bgsaving = false;
+  bgsave_finish_time_ = time(nullptr);
   g_pika_server->UpdateLastSave(time(nullptr));
 }
 
 // Prepare engine, need bgsave_protector protect
 bool DB::InitBgsaveEnv() {
   std::lock_guard l(bgsave_protector_);
+  ReleaseStreamingBgSaveWithoutLock();
   // Prepare for bgsave dir
   bgsave_info_.start_time = time(nullptr);
   char s_time[32];
@@ -362,6 +441,24 @@ bool DB::InitBgsaveEngine() {
     return false;
   }
 
+  // a slave writes the binlog of its master before applying it to db, the
+  // binlog is held and the applying drained so that a dump made on a slave
+  // for its own slaves matches the offset it is sent with
+  bool is_slave = (g_pika_server->role() & PIKA_ROLE_SLAVE) != 0;
+  if (is_slave) {
+    db->Logger()->Lock();
+    int32_t wait_ms = 10;
+    while (g_pika_rm->GetUnfinishedAsyncWriteDBTaskCount(db_name_) > 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+      wait_ms = std::min(wait_ms * 2, 100);
+    }
+  }
+  DEFER {
+    if (is_slave) {
+      db->Logger()->Unlock();
+    }
+  };
+
   {
     std::lock_guard lock(dbs_rw_);
     LogOffset bgsave_offset;
@@ -386,6 +483,8 @@ void DB::Init() {
   cache::CacheConfig cache_cfg;
   g_pika_server->CacheConfigInit(cache_cfg);
   cache_->Init(g_pika_conf->GetCacheNum(), &cache_cfg);
+  cache_write_behind_ = std::make_unique<PikaCacheWriteBehindThread>(db_name_);
+  cache_write_behind_->StartThread();
 }
 
 void DB::GetBgSaveMetaData(std::vector<std::string>* fileNames, std::string* snapshot_uuid) {
@@ -409,6 +508,12 @@ void DB::GetBgSaveMetaData(std::vector<std::string>* fileNames, std::string* sna
       fileNames -> push_back(std::to_string(index) + "/" + fileName);
     }
   }
+  {
+    std::lock_guard l(bgsave_protector_);
+    for (const auto& file : bgsave_stream_files_) {
+      fileNames->push_back(file.first);
+    }
+  }
   fileNames->push_back(kBgsaveInfoFile);
   pstd::Status s = GetBgSaveUUID(snapshot_uuid);
   if (!s.ok()) {
@@ -561,6 +666,10 @@ bool DB::ChangeDb(const std::string& new_path) {
 
   std::lock_guard l(dbs_rw_);
   LOG(INFO) << "DB: " << db_name_ << ", Prepare change db from: " << tmp_path;
+  {
+    std::lock_guard bl(bgsave_protector_);
+    ReleaseStreamingBgSaveWithoutLock();
+  }
   storage_.reset();
 
   if (0 != pstd::RenameFile(db_path_, tmp_path)) {
@@ -581,6 +690,9 @@ bool DB::ChangeDb(const std::string& new_path) {
   assert(storage_);
   assert(s.ok());
   pstd::DeleteDirIfExist(tmp_path);
+  // keys absent from the old db may exist in the new one
+  cache_->ClearNegativeKeys();
+  cache_write_behind_->Clear();
   LOG(INFO) << "DB: " << db_name_ << ", Change db success";
   return true;
 }
@@ -598,6 +710,16 @@ void DB::UpdateCacheInfo(CacheInfo& cache_info) {
   cache_info_.keys_num = cache_info.keys_num;
   cache_info_.used_memory = cache_info.used_memory;
   cache_info_.waitting_load_keys_num = cache_info.waitting_load_keys_num;
+  cache_info_.invalidate_pending_keys_num = cache_info.invalidate_pending_keys_num;
+  cache_info_.invalidated_keys_num = cache_info.invalidated_keys_num;
+  cache_info_.negative_keys_num = cache_info.negative_keys_num;
+  cache_info_.negative_hits = cache_info.negative_hits;
+  cache_info_.negative_misses = cache_info.negative_misses;
+  cache_info_.type_keys_num = cache_info.type_keys_num;
+  cache_info_.type_used_memory = cache_info.type_used_memory;
+  cache_info_.type_rejected_keys_num = cache_info.type_rejected_keys_num;
+  cache_info_.shard_keys_num = cache_info.shard_keys_num;
+  cache_info_.shard_used_memory = cache_info.shard_used_memory;
   cache_usage_ = cache_info.used_memory;
 
   uint64_t all_cmds = cache_info.hits + cache_info.misses;
@@ -636,5 +758,15 @@ void DB::ResetDisplayCacheInfo(int status) {
   cache_info_.hitratio_all = 0.0;
   cache_info_.load_keys_per_sec = 0;
   cache_info_.waitting_load_keys_num = 0;
+  cache_info_.invalidate_pending_keys_num = 0;
+  cache_info_.invalidated_keys_num = 0;
+  cache_info_.negative_keys_num = 0;
+  cache_info_.negative_hits = 0;
+  cache_info_.negative_misses = 0;
+  cache_info_.type_keys_num.clear();
+  cache_info_.type_used_memory.clear();
+  cache_info_.type_rejected_keys_num.clear();
+  cache_info_.shard_keys_num.clear();
+  cache_info_.shard_used_memory.clear();
   cache_usage_ = 0;
 }
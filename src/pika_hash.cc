@@ -183,23 +183,19 @@ void HGetallCmd::Do() {
 }
 
 void HGetallCmd::ReadCache() {
-  std::vector<storage::FieldValue> fvs;
-  auto s = db_->cache()->HGetall(key_, &fvs);
-  if (s.ok()) {
-    res_.AppendArrayLen(fvs.size() * 2);
-    for (const auto& fv : fvs) {
-      res_.AppendStringLen(fv.field.size());
-      res_.AppendContent(fv.field);
-      res_.AppendStringLen(fv.value.size());
-      res_.AppendContent(fv.value);
-    }
-  } else if (s.IsNotFound()) {
+  auto s = db_->cache()->HGetallResp(key_, res_.mutable_message());
+  if (s.IsNotFound()) {
     res_.SetRes(CmdRes::kCacheMiss);
-  } else {
+  } else if (!s.ok()) {
     res_.SetRes(CmdRes::kErrOther, s.ToString());
   }
 }
 
+void HGetallCmd::ReplyKeyNotExist() {
+  res_.AppendArrayLen(0);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void HGetallCmd::DoThroughDB() {
   res_.clear();
   Do();
@@ -295,6 +291,18 @@ void HIncrbyCmd::DoUpdateCache() {
   }
 }
 
+bool HIncrbyCmd::DoWriteBehind() {
+  int64_t new_value = 0;
+  s_ = db_->cache()->HIncrbyxx(key_, field_, by_, &new_value);
+  if (!s_.ok()) {
+    return false;
+  }
+  res_.AppendContent(":" + std::to_string(new_value));
+  db_->cache_write_behind()->AddFieldDelta(key_, field_, by_);
+  served_by_write_behind_ = true;
+  return true;
+}
+
 void HIncrbyfloatCmd::DoInitial() {
   if (!CheckArg(argv_.size())) {
     res_.SetRes(CmdRes::kWrongNum, kCmdNameHIncrbyfloat);
@@ -417,6 +425,11 @@ void HLenCmd::ReadCache() {
   }
 }
 
+void HLenCmd::ReplyKeyNotExist() {
+  res_.AppendInteger(0);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void HLenCmd::DoThroughDB() {
   res_.clear();
   Do();
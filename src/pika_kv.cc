@@ -181,6 +181,11 @@ void GetCmd::ReadCache() {
   }
 }
 
+void GetCmd::ReplyKeyNotExist() {
+  res_.AppendStringLen(-1);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void GetCmd::DoThroughDB() {
   res_.clear();
   Do();
@@ -285,6 +290,18 @@ void IncrCmd::DoUpdateCache() {
   }
 }
 
+bool IncrCmd::DoWriteBehind() {
+  // not cached or not an integer, let the db handle it and report the error
+  s_ = db_->cache()->IncrByxx(key_, 1, &new_value_);
+  if (!s_.ok()) {
+    return false;
+  }
+  res_.AppendContent(":" + std::to_string(new_value_));
+  db_->cache_write_behind()->AddDelta(key_, 1);
+  served_by_write_behind_ = true;
+  return true;
+}
+
 std::string IncrCmd::ToRedisProtocol() {
   std::string content;
   content.reserve(RAW_ARGS_LEN);
@@ -349,6 +366,17 @@ void IncrbyCmd::DoUpdateCache() {
   }
 }
 
+bool IncrbyCmd::DoWriteBehind() {
+  s_ = db_->cache()->IncrByxx(key_, by_, &new_value_);
+  if (!s_.ok()) {
+    return false;
+  }
+  res_.AppendContent(":" + std::to_string(new_value_));
+  db_->cache_write_behind()->AddDelta(key_, by_);
+  served_by_write_behind_ = true;
+  return true;
+}
+
 std::string IncrbyCmd::ToRedisProtocol() {
   std::string content;
   content.reserve(RAW_ARGS_LEN);
@@ -1239,6 +1267,11 @@ void StrlenCmd::ReadCache() {
   }
 }
 
+void StrlenCmd::ReplyKeyNotExist() {
+  res_.AppendInteger(0);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void StrlenCmd::DoThroughDB() {
   res_.clear();
   s_ = db_->storage()->GetWithTTL(key_, &value_, &ttl_millsec);
@@ -1268,6 +1301,7 @@ void ExistsCmd::Do() {
   int64_t res = db_->storage()->Exists(keys_);
   if (res != -1) {
     res_.AppendInteger(res);
+    s_ = (res == 0) ? rocksdb::Status::NotFound() : rocksdb::Status::OK();
   } else {
     res_.SetRes(CmdRes::kErrOther, "exists internal error");
   }
@@ -1297,6 +1331,11 @@ void ExistsCmd::ReadCache() {
   }
 }
 
+void ExistsCmd::ReplyKeyNotExist() {
+  res_.AppendInteger(0);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void ExistsCmd::DoThroughDB() {
   res_.clear();
   Do();
@@ -139,6 +139,11 @@ void LLenCmd::ReadCache() {
   }
 }
 
+void LLenCmd::ReplyKeyNotExist() {
+  res_.AppendInteger(0);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void LLenCmd::DoThroughDB() {
   res_.clear();
   Do();
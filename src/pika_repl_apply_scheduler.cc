@@ -0,0 +1,228 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "include/pika_repl_apply_scheduler.h"
+
+#include <glog/logging.h>
+
+#include "include/pika_conf.h"
+#include "include/pika_db.h"
+#include "storage/storage.h"
+
+extern std::unique_ptr<PikaConf> g_pika_conf;
+
+PikaReplApplyScheduler::PikaReplApplyScheduler(std::vector<std::unique_ptr<PikaReplBgWorker>>* workers,
+                                               size_t window)
+    : workers_(workers), window_(window) {}
+
+void PikaReplApplyScheduler::Schedule(const std::shared_ptr<Cmd>& cmd_ptr, const std::string& db_name,
+                                      std::function<void()> done) {
+  auto task = std::make_shared<ApplyTask>();
+  task->cmd_ptr = cmd_ptr;
+  task->db_name = db_name;
+  task->done = std::move(done);
+  for (const auto& arg : cmd_ptr->argv()) {
+    task->bytes += arg.size();
+  }
+  std::vector<std::string> keys = cmd_ptr->current_key();
+  if (keys.empty() || (keys.size() == 1 && keys[0].empty()) || cmd_ptr->IsSuspend()) {
+    // commands without keys (flushall, admin ...) touch the whole db
+    task->barrier = true;
+  } else {
+    task->keys.reserve(keys.size());
+    for (const auto& key : keys) {
+      task->keys.push_back(db_name + key);
+    }
+    // a command reading back what it wrote to a key must see its own write,
+    // which is not there before the group commits: repeated keys, the sub
+    // commands of exec, and xadd/xtrim trimming what they just added
+    std::unordered_set<std::string> distinct_keys(keys.begin(), keys.end());
+    task->groupable = distinct_keys.size() == keys.size() && cmd_ptr->name() != kCmdNameExec
+                      && !cmd_ptr->hasFlag(kCmdFlagsStream);
+  }
+
+  size_t jobs = 0;
+  {
+    std::unique_lock lm(mu_);
+    // every queued job is for a task in flight, so staying under the worker
+    // queue size keeps ScheduleJobs from ever blocking in a worker
+    window_cv_.wait(lm, [this] { return inflight_num_ < window_; });
+
+    DBApplyState& state = db_states_[db_name];
+    if (task->barrier) {
+      for (const auto& pred : state.inflight) {
+        AddDependency(pred, task);
+      }
+      state.barrier = task;
+    } else {
+      if (state.barrier) {
+        AddDependency(state.barrier, task);
+      }
+      for (const auto& key : task->keys) {
+        auto iter = last_tasks_.find(key);
+        if (iter != last_tasks_.end()) {
+          AddDependency(iter->second, task);
+          iter->second = task;
+        } else {
+          last_tasks_.emplace(key, task);
+        }
+      }
+    }
+    state.inflight.insert(task);
+    ++inflight_num_;
+    ++scheduled_num_;
+    if (task->pending_deps > 0) {
+      ++conflict_num_;
+      return;
+    }
+    jobs = AddReady({task});
+  }
+  ScheduleJobs(jobs);
+}
+
+void PikaReplApplyScheduler::AddDependency(const std::shared_ptr<ApplyTask>& pred,
+                                           const std::shared_ptr<ApplyTask>& task) {
+  // a command may share several keys with pred
+  if (!pred->successors.empty() && pred->successors.back() == task) {
+    return;
+  }
+  pred->successors.push_back(task);
+  ++task->pending_deps;
+}
+
+uint64_t PikaReplApplyScheduler::InflightNum() {
+  std::lock_guard lm(mu_);
+  return inflight_num_;
+}
+
+size_t PikaReplApplyScheduler::AddReady(const std::vector<std::shared_ptr<ApplyTask>>& tasks) {
+  ready_.insert(ready_.end(), tasks.begin(), tasks.end());
+  // a job may take several ready tasks, jobs left with nothing return at once
+  size_t jobs = ready_.size() > pending_jobs_ ? ready_.size() - pending_jobs_ : 0;
+  pending_jobs_ += jobs;
+  return jobs;
+}
+
+void PikaReplApplyScheduler::ScheduleJobs(size_t jobs) {
+  for (size_t i = 0; i < jobs; ++i) {
+    size_t index = next_worker_.fetch_add(1) % workers_->size();
+    (*workers_)[index]->Schedule(&PikaReplApplyScheduler::DoApply, static_cast<void*>(this));
+  }
+}
+
+void PikaReplApplyScheduler::DoApply(void* arg) {
+  auto scheduler = static_cast<PikaReplApplyScheduler*>(arg);
+  std::vector<std::shared_ptr<ApplyTask>> group;
+  scheduler->TakeGroup(&group);
+  if (group.empty()) {
+    return;
+  }
+  if (group.size() == 1) {
+    PikaReplBgWorker::WriteDBInSyncWay(group.front()->cmd_ptr);
+  } else {
+    scheduler->ApplyGroup(group);
+  }
+  for (const auto& task : group) {
+    scheduler->Finish(task);
+  }
+}
+
+bool PikaReplApplyScheduler::CanGroup(const std::shared_ptr<ApplyTask>& task) {
+  // the cache is updated right after each command, before the group reaches db,
+  // a read on this slave in between would load the old value back into the cache.
+  // With slotmigrate the writes also add their keys to the slot and tag sets,
+  // which are read before the group is committed and would lose members
+  return task->groupable
+         && !(task->cmd_ptr->IsNeedCacheDo() && PIKA_CACHE_NONE != g_pika_conf->cache_mode())
+         && !g_pika_conf->slotmigrate();
+}
+
+void PikaReplApplyScheduler::TakeGroup(std::vector<std::shared_ptr<ApplyTask>>* group) {
+  std::lock_guard lm(mu_);
+  --pending_jobs_;
+  if (ready_.empty()) {
+    return;
+  }
+  std::shared_ptr<ApplyTask> first = ready_.front();
+  ready_.pop_front();
+  group->push_back(first);
+  if (!CanGroup(first)) {
+    return;
+  }
+  // the ready tasks do not share keys, they are applied in any order
+  auto max_cmds = static_cast<size_t>(g_pika_conf->replication_apply_batch_cmds());
+  auto max_bytes = static_cast<uint64_t>(g_pika_conf->replication_apply_batch_bytes());
+  uint64_t bytes = first->bytes;
+  while (group->size() < max_cmds && bytes < max_bytes && !ready_.empty()) {
+    const std::shared_ptr<ApplyTask>& next = ready_.front();
+    if (next->db_name != first->db_name || !CanGroup(next)) {
+      break;
+    }
+    bytes += next->bytes;
+    group->push_back(next);
+    ready_.pop_front();
+  }
+}
+
+void PikaReplApplyScheduler::ApplyGroup(const std::vector<std::shared_ptr<ApplyTask>>& group) {
+  std::shared_ptr<DB> db = group.front()->cmd_ptr->GetDB();
+  // held until the group is written, the storage of the db must not be
+  // replaced while its writes wait in the group
+  db->DBLockShared();
+  rocksdb::Status s;
+  {
+    storage::WriteGroup write_group;
+    for (const auto& task : group) {
+      PikaReplBgWorker::WriteDBInSyncWay(task->cmd_ptr, true);
+    }
+    s = write_group.Commit();
+  }
+  // only now can a read find the keys in db, dropping the negative cache
+  // entries before would let a read in between add them back
+  for (const auto& task : group) {
+    if (task->cmd_ptr->is_write()) {
+      db->cache()->DelNegativeKeys(task->cmd_ptr->current_key());
+    }
+  }
+  db->DBUnlockShared();
+  if (!s.ok()) {
+    LOG(ERROR) << group.front()->db_name << " write a group of " << group.size()
+               << " replicated commands failed: " << s.ToString();
+  }
+  ++groups_num_;
+  grouped_cmds_num_ += group.size();
+}
+
+void PikaReplApplyScheduler::Finish(const std::shared_ptr<ApplyTask>& task) {
+  std::vector<std::shared_ptr<ApplyTask>> ready;
+  size_t jobs = 0;
+  {
+    std::lock_guard lm(mu_);
+    for (const auto& key : task->keys) {
+      auto iter = last_tasks_.find(key);
+      if (iter != last_tasks_.end() && iter->second == task) {
+        last_tasks_.erase(iter);
+      }
+    }
+    DBApplyState& state = db_states_[task->db_name];
+    if (state.barrier == task) {
+      state.barrier.reset();
+    }
+    state.inflight.erase(task);
+    for (const auto& succ : task->successors) {
+      if (--succ->pending_deps == 0) {
+        ready.push_back(succ);
+      }
+    }
+    task->successors.clear();
+    jobs = AddReady(ready);
+    --inflight_num_;
+    window_cv_.notify_all();
+  }
+  ScheduleJobs(jobs);
+  if (task->done) {
+    task->done();
+  }
+}
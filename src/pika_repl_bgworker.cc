@@ -139,6 +139,19 @@ void PikaReplBgWorker::HandleBGWorkerWriteBinlog(void* arg) {
       slave_db->SetReplState(ReplState::kTryConnect);
       return;
     }
+    if (worker->binlog_item_.type() == TypeCompact) {
+      // arguments are stored as they are, no redis protocol to parse
+      net::RedisCmdArgsType argv;
+      if (binlog_res.binlog().size() < BINLOG_ENCODE_LEN
+          || !PikaBinlogTransverter::CompactContentDecode(binlog_res.binlog().data() + BINLOG_ENCODE_LEN,
+                                                       binlog_res.binlog().size() - BINLOG_ENCODE_LEN, &argv)
+          || HandleWriteBinlog(&worker->redis_parser_, argv) != 0) {
+        LOG(WARNING) << "Compact binlog apply failed";
+        slave_db->SetReplState(ReplState::kTryConnect);
+        return;
+      }
+      continue;
+    }
     const char* redis_parser_start = binlog_res.binlog().data() + BINLOG_ENCODE_LEN;
     int redis_parser_len = static_cast<int>(binlog_res.binlog().size()) - BINLOG_ENCODE_LEN;
     int processed_len = 0;
@@ -206,13 +219,7 @@ int PikaReplBgWorker::HandleWriteBinlog(net::RedisParser* parser, const net::Red
   return 0;
 }
 
-void PikaReplBgWorker::HandleBGWorkerWriteDB(void* arg) {
-  std::unique_ptr<ReplClientWriteDBTaskArg> task_arg(static_cast<ReplClientWriteDBTaskArg*>(arg));
-  const std::shared_ptr<Cmd> c_ptr = task_arg->cmd_ptr;
-  WriteDBInSyncWay(c_ptr);
-}
-
-void PikaReplBgWorker::WriteDBInSyncWay(const std::shared_ptr<Cmd>& c_ptr) {
+void PikaReplBgWorker::WriteDBInSyncWay(const std::shared_ptr<Cmd>& c_ptr, bool in_group) {
   const PikaCmdArgsType& argv = c_ptr->argv();
 
   uint64_t start_us = 0;
@@ -222,7 +229,7 @@ void PikaReplBgWorker::WriteDBInSyncWay(const std::shared_ptr<Cmd>& c_ptr) {
   // Add read lock for no suspend command
   pstd::lock::MultiRecordLock record_lock(c_ptr->GetDB()->LockMgr());
   record_lock.Lock(c_ptr->current_key());
-  if (!c_ptr->IsSuspend()) {
+  if (!in_group && !c_ptr->IsSuspend()) {
     c_ptr->GetDB()->DBLockShared();
   }
   if (c_ptr->IsNeedCacheDo()
@@ -230,7 +237,11 @@ void PikaReplBgWorker::WriteDBInSyncWay(const std::shared_ptr<Cmd>& c_ptr) {
       && c_ptr->GetDB()->cache()->CacheStatus() == PIKA_CACHE_STATUS_OK) {
     if (c_ptr->is_write()) {
       c_ptr->DoThroughDB();
-      if (c_ptr->IsNeedUpdateCache()) {
+      if (g_pika_conf->slave_cache_invalidate() && !c_ptr->IsSuspend()) {
+        // drop the cached keys asynchronously instead of replaying the write
+        // on the cache, the next read on this slave reloads them from db
+        c_ptr->GetDB()->cache()->PushKeysToInvalidateQueue(c_ptr->current_key());
+      } else if (c_ptr->IsNeedUpdateCache()) {
         c_ptr->DoUpdateCache();
       }
     } else {
@@ -239,7 +250,11 @@ void PikaReplBgWorker::WriteDBInSyncWay(const std::shared_ptr<Cmd>& c_ptr) {
   } else {
     c_ptr->Do();
   }
-  if (!c_ptr->IsSuspend()) {
+  if (c_ptr->is_write() && !in_group) {
+    // the keys may have been created, whatever the cache type of the command is
+    c_ptr->GetDB()->cache()->DelNegativeKeys(c_ptr->current_key());
+  }
+  if (!in_group && !c_ptr->IsSuspend()) {
     c_ptr->GetDB()->DBUnlockShared();
   }
 
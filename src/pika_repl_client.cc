@@ -42,6 +42,7 @@ PikaReplClient::PikaReplClient(int cron_interval, int keepalive_timeout) {
       new_db_worker->SetThreadName(db_worker_name);
       write_db_workers_.emplace_back(std::move(new_db_worker));
   }
+  apply_scheduler_ = std::make_unique<PikaReplApplyScheduler>(&write_db_workers_, PIKA_SYNC_BUFFER_SIZE);
 }
 
 PikaReplClient::~PikaReplClient() {
@@ -119,16 +120,9 @@ void PikaReplClient::ScheduleWriteBinlogTask(const std::string& db_name,
 }
 
 void PikaReplClient::ScheduleWriteDBTask(const std::shared_ptr<Cmd>& cmd_ptr, const std::string& db_name) {
-  const PikaCmdArgsType& argv = cmd_ptr->argv();
-  std::string dispatch_key = argv.size() >= 2 ? argv[1] : argv[0];
-  size_t index = GetHashIndexByKey(dispatch_key);
-  auto task_arg = new ReplClientWriteDBTaskArg(cmd_ptr);
-
   IncrAsyncWriteDBTaskCount(db_name, 1);
   std::function<void()> task_finish_call_back = [this, db_name]() { this->DecrAsyncWriteDBTaskCount(db_name, 1); };
-
-  write_db_workers_[index]->Schedule(&PikaReplBgWorker::HandleBGWorkerWriteDB, static_cast<void*>(task_arg),
-                                     task_finish_call_back);
+  apply_scheduler_->Schedule(cmd_ptr, db_name, std::move(task_finish_call_back));
 }
 
 size_t PikaReplClient::GetBinlogWorkerIndexByDBName(const std::string &db_name) {
@@ -144,11 +138,6 @@ size_t PikaReplClient::GetBinlogWorkerIndexByDBName(const std::string &db_name)
     return db_num % write_binlog_workers_.size();
 }
 
-size_t PikaReplClient::GetHashIndexByKey(const std::string& key) {
-  size_t hash_base = write_db_workers_.size();
-  return (str_hash(key) % hash_base);
-}
-
 Status PikaReplClient::Write(const std::string& ip, const int port, const std::string& msg) {
   return client_thread_->Write(ip, port, msg);
 }
@@ -183,6 +172,9 @@ Status PikaReplClient::SendMetaSync() {
   node->set_ip(local_ip);
   node->set_port(g_pika_server->port());
 
+  meta_sync->add_binlog_compressions(InnerMessage::kLZ4Compression);
+  meta_sync->add_binlog_compressions(InnerMessage::kZstdCompression);
+
   std::string masterauth = g_pika_conf->masterauth();
   if (!masterauth.empty()) {
     meta_sync->set_auth(masterauth);
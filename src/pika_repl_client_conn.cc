@@ -72,6 +72,11 @@ int PikaReplClientConn::DealMessage() {
       break;
     }
     case InnerMessage::kBinlogSync: {
+      if (!UncompressBinlogSyncResp(response.get(), g_pika_conf->max_conn_rbuf_size(),
+                                    g_pika_rm->ReplClientCompressionStats())) {
+        g_pika_server->SyncError();
+        return -1;
+      }
       DispatchBinlogRes(response);
       break;
     }
@@ -109,6 +114,8 @@ void PikaReplClientConn::HandleMetaSyncResponse(void* arg) {
   }
 
   const InnerMessage::InnerResponse_MetaSync meta_sync = response->meta_sync();
+  LOG(INFO) << "Binlog sync compression negotiated with master: "
+            << ReplCompressionToString(meta_sync.binlog_compression());
 
   std::vector<DBStruct> master_db_structs;
   for (int idx = 0; idx < meta_sync.dbs_info_size(); ++idx) {
@@ -0,0 +1,153 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "include/pika_repl_compression.h"
+
+#include <glog/logging.h>
+#include <lz4.h>
+#include <zstd.h>
+
+#include <memory>
+
+#include "include/pika_define.h"
+#include "pstd/include/env.h"
+
+namespace {
+
+struct ZstdCCtxDeleter {
+  void operator()(ZSTD_CCtx* ctx) const { ZSTD_freeCCtx(ctx); }
+};
+
+struct ZstdDCtxDeleter {
+  void operator()(ZSTD_DCtx* ctx) const { ZSTD_freeDCtx(ctx); }
+};
+
+bool Compress(InnerMessage::CompressionType type, int level, const std::string& raw, std::string* compressed) {
+  if (type == InnerMessage::kLZ4Compression) {
+    compressed->resize(LZ4_compressBound(static_cast<int>(raw.size())));
+    // lz4 takes the level as acceleration, larger is faster and compresses less
+    int size = LZ4_compress_fast(raw.data(), compressed->data(), static_cast<int>(raw.size()),
+                                 static_cast<int>(compressed->size()), level);
+    if (size <= 0) {
+      return false;
+    }
+    compressed->resize(size);
+    return true;
+  }
+  if (type == InnerMessage::kZstdCompression) {
+    // reused by every batch sent from this thread
+    thread_local std::unique_ptr<ZSTD_CCtx, ZstdCCtxDeleter> ctx(ZSTD_createCCtx());
+    compressed->resize(ZSTD_compressBound(raw.size()));
+    size_t size = ZSTD_compressCCtx(ctx.get(), compressed->data(), compressed->size(), raw.data(), raw.size(), level);
+    if (ZSTD_isError(size) != 0U) {
+      return false;
+    }
+    compressed->resize(size);
+    return true;
+  }
+  return false;
+}
+
+bool Uncompress(InnerMessage::CompressionType type, const std::string& compressed, std::string* raw) {
+  if (type == InnerMessage::kLZ4Compression) {
+    int size = LZ4_decompress_safe(compressed.data(), raw->data(), static_cast<int>(compressed.size()),
+                                   static_cast<int>(raw->size()));
+    return size >= 0 && static_cast<size_t>(size) == raw->size();
+  }
+  if (type == InnerMessage::kZstdCompression) {
+    thread_local std::unique_ptr<ZSTD_DCtx, ZstdDCtxDeleter> ctx(ZSTD_createDCtx());
+    size_t size = ZSTD_decompressDCtx(ctx.get(), raw->data(), raw->size(), compressed.data(), compressed.size());
+    return ZSTD_isError(size) == 0U && size == raw->size();
+  }
+  return false;
+}
+
+}  // namespace
+
+std::string ReplCompressionToString(InnerMessage::CompressionType type) {
+  switch (type) {
+    case InnerMessage::kLZ4Compression:
+      return "lz4";
+    case InnerMessage::kZstdCompression:
+      return "zstd";
+    default:
+      return "none";
+  }
+}
+
+bool StringToReplCompression(const std::string& value, InnerMessage::CompressionType* type) {
+  if (value == "none") {
+    *type = InnerMessage::kNoCompression;
+  } else if (value == "lz4") {
+    *type = InnerMessage::kLZ4Compression;
+  } else if (value == "zstd") {
+    *type = InnerMessage::kZstdCompression;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void CompressBinlogSyncResp(InnerMessage::CompressionType type, int level, InnerMessage::InnerResponse* response,
+                            ReplCompressionStats* stats) {
+  if (type == InnerMessage::kNoCompression || response->binlog_sync_size() == 0) {
+    return;
+  }
+  InnerMessage::InnerResponse::BinlogSyncBatch batch;
+  batch.mutable_binlog_sync()->Swap(response->mutable_binlog_sync());
+  std::string raw;
+  if (batch.ByteSizeLong() < PIKA_REPL_COMPRESS_MIN_SIZE || !batch.SerializeToString(&raw)) {
+    response->mutable_binlog_sync()->Swap(batch.mutable_binlog_sync());
+    return;
+  }
+
+  uint64_t start_us = pstd::NowMicros();
+  std::string compressed;
+  bool ok = Compress(type, level, raw, &compressed);
+  stats->cpu_us += pstd::NowMicros() - start_us;
+  if (!ok || compressed.size() >= raw.size()) {
+    response->mutable_binlog_sync()->Swap(batch.mutable_binlog_sync());
+    stats->raw_bytes += raw.size();
+    stats->wire_bytes += raw.size();
+    return;
+  }
+  stats->raw_bytes += raw.size();
+  stats->wire_bytes += compressed.size();
+  response->set_compression(type);
+  response->set_uncompressed_size(static_cast<uint32_t>(raw.size()));
+  response->set_compressed_binlog_sync(std::move(compressed));
+}
+
+bool UncompressBinlogSyncResp(InnerMessage::InnerResponse* response, size_t max_size, ReplCompressionStats* stats) {
+  if (!response->has_compressed_binlog_sync()) {
+    return true;
+  }
+  if (response->uncompressed_size() > max_size) {
+    LOG(WARNING) << "Compressed binlog sync too large, uncompressed size: " << response->uncompressed_size();
+    return false;
+  }
+
+  uint64_t start_us = pstd::NowMicros();
+  std::string raw(response->uncompressed_size(), '\0');
+  bool ok = Uncompress(response->compression(), response->compressed_binlog_sync(), &raw);
+  stats->cpu_us += pstd::NowMicros() - start_us;
+  if (!ok) {
+    LOG(WARNING) << "Uncompress " << ReplCompressionToString(response->compression()) << " binlog sync failed";
+    return false;
+  }
+  stats->raw_bytes += raw.size();
+  stats->wire_bytes += response->compressed_binlog_sync().size();
+
+  InnerMessage::InnerResponse::BinlogSyncBatch batch;
+  if (!batch.ParseFromString(raw)) {
+    LOG(WARNING) << "Parse uncompressed binlog sync failed";
+    return false;
+  }
+  response->mutable_binlog_sync()->Swap(batch.mutable_binlog_sync());
+  response->clear_compression();
+  response->clear_compressed_binlog_sync();
+  response->clear_uncompressed_size();
+  return true;
+}
@@ -53,20 +53,20 @@ int PikaReplServer::Stop() {
 
 pstd::Status PikaReplServer::SendSlaveBinlogChips(const std::string& ip, int port,
                                                   const std::vector<WriteTask>& tasks) {
+  InnerMessage::CompressionType compression = ClientCompression(pstd::IpPortString(ip, port));
+  int level = g_pika_conf->replication_compression_level();
   InnerMessage::InnerResponse response;
   BuildBinlogSyncResp(tasks, &response);
 
   std::string binlog_chip_pb;
-  if (!response.SerializeToString(&binlog_chip_pb)) {
-    return Status::Corruption("Serialized Failed");
-  }
-
-  if (binlog_chip_pb.size() > static_cast<size_t>(g_pika_conf->max_conn_rbuf_size())) {
+  // check the uncompressed size, it is what the slave has to hold after uncompressing
+  if (response.ByteSizeLong() > static_cast<size_t>(g_pika_conf->max_conn_rbuf_size())) {
     for (const auto& task : tasks) {
       InnerMessage::InnerResponse response;
       std::vector<WriteTask> tmp_tasks;
       tmp_tasks.push_back(task);
       BuildBinlogSyncResp(tmp_tasks, &response);
+      CompressBinlogSyncResp(compression, level, &response, &compression_stats_);
       if (!response.SerializeToString(&binlog_chip_pb)) {
         return Status::Corruption("Serialized Failed");
       }
@@ -77,6 +77,10 @@ pstd::Status PikaReplServer::SendSlaveBinlogChips(const std::string& ip, int por
     }
     return pstd::Status::OK();
   }
+  CompressBinlogSyncResp(compression, level, &response, &compression_stats_);
+  if (!response.SerializeToString(&binlog_chip_pb)) {
+    return Status::Corruption("Serialized Failed");
+  }
   return Write(ip, port, binlog_chip_pb);
 }
 
@@ -103,7 +107,7 @@ void PikaReplServer::BuildBinlogSyncResp(const std::vector<WriteTask>& tasks, In
     db->set_slot_id(0);
     InnerMessage::BinlogOffset* boffset = binlog_sync->mutable_binlog_offset();
     BuildBinlogOffset(task.binlog_chip_.offset_, boffset);
-    binlog_sync->set_binlog(task.binlog_chip_.binlog_);
+    binlog_sync->set_binlog(*task.binlog_chip_.binlog_);
   }
 }
 
@@ -134,11 +138,23 @@ void PikaReplServer::UpdateClientConnMap(const std::string& ip_port, int fd) {
   client_conn_map_[ip_port] = fd;
 }
 
+void PikaReplServer::UpdateClientCompression(const std::string& ip_port, InnerMessage::CompressionType type) {
+  std::lock_guard l(client_conn_rwlock_);
+  client_compression_[ip_port] = type;
+}
+
+InnerMessage::CompressionType PikaReplServer::ClientCompression(const std::string& ip_port) {
+  std::shared_lock l(client_conn_rwlock_);
+  auto iter = client_compression_.find(ip_port);
+  return iter == client_compression_.end() ? InnerMessage::kNoCompression : iter->second;
+}
+
 void PikaReplServer::RemoveClientConn(int fd) {
   std::lock_guard l(client_conn_rwlock_);
   auto iter = client_conn_map_.begin();
   while (iter != client_conn_map_.end()) {
     if (iter->second == fd) {
+      client_compression_.erase(iter->first);
       iter = client_conn_map_.erase(iter);
       break;
     }
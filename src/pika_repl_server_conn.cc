@@ -7,6 +7,8 @@
 
 #include <glog/logging.h>
 
+#include <algorithm>
+
 #include "include/pika_rm.h"
 #include "include/pika_server.h"
 
@@ -55,6 +57,15 @@ void PikaReplServerConn::HandleMetaSyncRequest(void* arg) {
       meta_sync->set_classic_mode(g_pika_conf->classic_mode());
       meta_sync->set_run_id(g_pika_conf->run_id());
       meta_sync->set_replication_id(g_pika_conf->replication_id());
+      // compress binlog sync only with what the slave is able to uncompress
+      InnerMessage::CompressionType compression = InnerMessage::kNoCompression;
+      StringToReplCompression(g_pika_conf->replication_compression(), &compression);
+      const auto& accepted = meta_sync_request.binlog_compressions();
+      if (std::find(accepted.begin(), accepted.end(), compression) == accepted.end()) {
+        compression = InnerMessage::kNoCompression;
+      }
+      g_pika_rm->ReplServerUpdateClientCompression(ip_port, compression);
+      meta_sync->set_binlog_compression(compression);
       for (const auto& db_struct : db_structs) {
         InnerMessage::InnerResponse_MetaSync_DBInfo* db_info = meta_sync->add_dbs_info();
         db_info->set_db_name(db_struct.db_name);
@@ -146,36 +146,65 @@ Status SyncMasterDB::ReadBinlogFileToWq(const std::shared_ptr<SlaveNode>& slave_
   if (!reader) {
     return Status::OK();
   }
+  std::shared_ptr<BinlogTail> tail = Logger()->tail();
   std::vector<WriteTask> tasks;
   for (int i = 0; i < cnt; ++i) {
-    std::string msg;
-    uint32_t filenum;
-    uint64_t offset;
     if (slave_ptr->sync_win.GetTotalBinlogSize() > PIKA_MAX_CONN_RBUF_HB * 2) {
       LOG(INFO) << slave_ptr->ToString()
                 << " total binlog size in sync window is :" << slave_ptr->sync_win.GetTotalBinlogSize();
       break;
     }
-    Status s = reader->Get(&msg, &filenum, &offset);
-    if (s.IsEndFile()) {
-      break;
-    } else if (s.IsCorruption() || s.IsIOError()) {
-      LOG(WARNING) << SyncDBInfo().ToString() << " Read Binlog error : " << s.ToString();
-      return s;
-    }
-    BinlogItem item;
-    if (!PikaBinlogTransverter::BinlogItemWithoutContentDecode(TypeFirst, msg, &item)) {
-      LOG(WARNING) << "Binlog item decode failed";
-      return Status::Corruption("Binlog item decode failed");
+    LogOffset sent_offset;
+    std::shared_ptr<const std::string> binlog;
+    BinlogTail::Item tail_item;
+    if (tail->Get(slave_ptr->sent_offset.b_offset, &tail_item)) {
+      // already framed and decoded by Binlog::Put, shared with the other slaves
+      sent_offset = tail_item.offset;
+      binlog = std::move(tail_item.binlog);
+      slave_ptr->b_state = kReadFromCache;
+    } else {
+      BinlogOffset producer_offset;
+      Logger()->GetProducerStatus(&producer_offset.filenum, &producer_offset.offset);
+      if (slave_ptr->sent_offset.b_offset >= producer_offset) {
+        break;
+      }
+      uint32_t reader_filenum = 0;
+      uint64_t reader_offset = 0;
+      reader->GetReaderStatus(&reader_filenum, &reader_offset);
+      if (BinlogOffset(reader_filenum, reader_offset) != slave_ptr->sent_offset.b_offset) {
+        // the records in between were sent from the tail, catch the reader up
+        Status s = slave_ptr->InitBinlogFileReader(Logger(), slave_ptr->sent_offset.b_offset);
+        if (!s.ok()) {
+          return s;
+        }
+        reader = slave_ptr->binlog_reader;
+      }
+      std::string msg;
+      uint32_t filenum;
+      uint64_t offset;
+      Status s = reader->Get(&msg, &filenum, &offset);
+      if (s.IsEndFile()) {
+        break;
+      } else if (s.IsCorruption() || s.IsIOError()) {
+        LOG(WARNING) << SyncDBInfo().ToString() << " Read Binlog error : " << s.ToString();
+        return s;
+      }
+      BinlogItem item;
+      if (!PikaBinlogTransverter::BinlogItemWithoutContentDecode(TypeFirst, msg, &item)) {
+        LOG(WARNING) << "Binlog item decode failed";
+        return Status::Corruption("Binlog item decode failed");
+      }
+      BinlogOffset sent_b_offset = BinlogOffset(filenum, offset);
+      LogicOffset sent_l_offset = LogicOffset(item.term_id(), item.logic_id());
+      sent_offset = LogOffset(sent_b_offset, sent_l_offset);
+      binlog = std::make_shared<const std::string>(std::move(msg));
+      slave_ptr->b_state = kReadFromFile;
     }
-    BinlogOffset sent_b_offset = BinlogOffset(filenum, offset);
-    LogicOffset sent_l_offset = LogicOffset(item.term_id(), item.logic_id());
-    LogOffset sent_offset(sent_b_offset, sent_l_offset);
 
-    slave_ptr->sync_win.Push(SyncWinItem(sent_offset, msg.size()));
+    slave_ptr->sync_win.Push(SyncWinItem(sent_offset, binlog->size()));
     slave_ptr->SetLastSendTime(pstd::NowMicros());
     RmNode rm_node(slave_ptr->Ip(), slave_ptr->Port(), slave_ptr->DBName(), slave_ptr->SessionId());
-    WriteTask task(rm_node, BinlogChip(sent_offset, msg), slave_ptr->sent_offset);
+    WriteTask task(rm_node, BinlogChip(sent_offset, std::move(binlog)), slave_ptr->sent_offset);
     tasks.push_back(task);
     slave_ptr->sent_offset = sent_offset;
   }
@@ -284,6 +313,18 @@ Status SyncMasterDB::GetSafetyPurgeBinlog(std::string* safety_purge) {
   return Status::OK();
 }
 
+bool SyncMasterDB::HasDbSyncSlave() {
+  std::unordered_map<std::string, std::shared_ptr<SlaveNode>> slaves = GetAllSlaveNodes();
+  for (const auto& slave_iter : slaves) {
+    std::shared_ptr<SlaveNode> slave_ptr = slave_iter.second;
+    std::lock_guard l(slave_ptr->slave_mu);
+    if (slave_ptr->slave_state == SlaveState::kSlaveDbSync) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool SyncMasterDB::BinlogCloudPurge(uint32_t index) {
   BinlogOffset boffset;
   Status s = Logger()->GetProducerStatus(&(boffset.filenum), &(boffset.offset));
@@ -607,7 +648,7 @@ int PikaReplicaManager::ConsumeWriteQueue() {
           size_t batch_size = 0;
           for (size_t i = 0; i < batch_index; ++i) {
             WriteTask& task = queue.front();
-            batch_size += task.binlog_chip_.binlog_.size();
+            batch_size += task.binlog_chip_.binlog_->size();
             // make sure SerializeToString will not over 2G
             if (batch_size > PIKA_MAX_CONN_RBUF_HB) {
               break;
@@ -693,6 +734,23 @@ void PikaReplicaManager::ReplServerUpdateClientConnMap(const std::string& ip_por
   pika_repl_server_->UpdateClientConnMap(ip_port, fd);
 }
 
+void PikaReplicaManager::ReplServerUpdateClientCompression(const std::string& ip_port,
+                                                           InnerMessage::CompressionType type) {
+  pika_repl_server_->UpdateClientCompression(ip_port, type);
+}
+
+ReplCompressionStats* PikaReplicaManager::ReplServerCompressionStats() {
+  return pika_repl_server_->compression_stats();
+}
+
+ReplCompressionStats* PikaReplicaManager::ReplClientCompressionStats() {
+  return pika_repl_client_->compression_stats();
+}
+
+PikaReplApplyScheduler* PikaReplicaManager::ReplClientApplyScheduler() {
+  return pika_repl_client_->apply_scheduler();
+}
+
 Status PikaReplicaManager::UpdateSyncBinlogStatus(const RmNode& slave, const LogOffset& offset_start,
                                                   const LogOffset& offset_end) {
   std::shared_lock l(dbs_rw_);
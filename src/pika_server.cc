@@ -41,6 +41,13 @@ void DoPurgeDir(void* arg) {
   LOG(INFO) << "Delete dir: " << *path << " done";
 }
 
+static void PinStartedThread(pthread_t id, const std::string& name) {
+  // threads started before g_pika_server is set are left to the cron sweep
+  if (g_pika_server) {
+    g_pika_server->thread_placement()->PinThread(id, name);
+  }
+}
+
 
 PikaServer::PikaServer()
     : exit_(false),
@@ -56,6 +63,12 @@ PikaServer::PikaServer()
 
   InitStorageOptions();
 
+  std::string placement_err;
+  if (!thread_placement_.Reset(g_pika_conf->thread_placement(), &placement_err)) {
+    LOG(FATAL) << "invalid thread-placement: " << placement_err;
+  }
+  net::SetThreadStartHook(&PinStartedThread);
+
   // Create thread
   worker_num_ = std::min(g_pika_conf->thread_num(), PIKA_MAX_WORKER_THREAD_NUM);
 
@@ -72,18 +85,23 @@ PikaServer::PikaServer()
   for_each(ips.begin(), ips.end(), [](auto& ip) { LOG(WARNING) << ip; });
   pika_dispatch_thread_ = std::make_unique<PikaDispatchThread>(ips, port_, worker_num_, 3000, worker_queue_limit,
                                                                g_pika_conf->max_conn_rbuf_size());
+  if (g_pika_conf->reuse_port()) {
+    pika_dispatch_thread_->EnableReusePort(g_pika_conf->reuse_port_cpu_steering());
+  }
   pika_rsync_service_ =
       std::make_unique<PikaRsyncService>(g_pika_conf->db_sync_path(), g_pika_conf->port() + kPortShiftRSync);
   // TODO: remove pika_rsync_service_，reuse pika_rsync_service_ port
   rsync_server_ = std::make_unique<rsync::RsyncServer>(ips, port_ + kPortShiftRsync2);
-  pika_pubsub_thread_ = std::make_unique<net::PubSubThread>();
+  pika_pubsub_thread_ = std::make_unique<net::PubSubThread>(g_pika_conf->pubsub_thread_num());
   pika_auxiliary_thread_ = std::make_unique<PikaAuxiliaryThread>();
   pika_migrate_ = std::make_unique<PikaMigrate>();
   pika_migrate_thread_ = std::make_unique<PikaMigrateThread>();
 
   pika_client_processor_ = std::make_unique<PikaClientProcessor>(g_pika_conf->thread_pool_size(), 100000);
-  pika_slow_cmd_thread_pool_ = std::make_unique<net::ThreadPool>(g_pika_conf->slow_cmd_thread_pool_size(), 100000);
-  pika_admin_cmd_thread_pool_ = std::make_unique<net::ThreadPool>(g_pika_conf->admin_thread_pool_size(), 100000);
+  pika_slow_cmd_thread_pool_ = std::make_unique<net::ThreadPool>(g_pika_conf->slow_cmd_thread_pool_size(), 100000,
+                                                                 "SlowCmdPool");
+  pika_admin_cmd_thread_pool_ = std::make_unique<net::ThreadPool>(g_pika_conf->admin_thread_pool_size(), 100000,
+                                                                  "AdminCmdPool");
   instant_ = std::make_unique<Instant>();
   exit_mutex_.lock();
   int64_t lastsave = GetLastSaveTime(g_pika_conf->bgsave_path());
@@ -221,6 +239,10 @@ void PikaServer::Start() {
       exit_mutex_.unlock();
     }
   }
+  // write the counter increments still buffered for the caches
+  for (const auto& db_item : dbs_) {
+    db_item.second->cache_write_behind()->FlushAll();
+  }
   LOG(INFO) << "Goodbye...";
 }
 
@@ -758,6 +780,16 @@ void PikaServer::ScheduleClientPool(net::TaskFunc func, void* arg, bool is_slow_
   pika_client_processor_->SchedulePool(func, arg);
 }
 
+bool PikaServer::TryScheduleClientPool(net::TaskFunc func, void* arg, bool is_slow_cmd, bool is_admin_cmd) {
+  if (is_slow_cmd && g_pika_conf->slow_cmd_pool()) {
+    return pika_slow_cmd_thread_pool_->TrySchedule(func, arg);
+  }
+  if (is_admin_cmd) {
+    return pika_admin_cmd_thread_pool_->TrySchedule(func, arg);
+  }
+  return pika_client_processor_->TrySchedulePool(func, arg);
+}
+
 size_t PikaServer::ClientProcessorThreadPoolCurQueueSize() {
   if (!pika_client_processor_) {
     return 0;
@@ -851,7 +883,7 @@ void PikaServer::TryDBSync(const std::string& ip, int port, const std::string& d
       static_cast<int64_t>(top) - static_cast<int64_t>(bgsave_info.offset.b_offset.filenum) >
           static_cast<int64_t>(kDBSyncMaxGap)) {
     // Need Bgsave first
-    db->BgSaveDB();
+    db->BgSaveDB(true);
   }
 }
 
@@ -1004,10 +1036,16 @@ uint64_t PikaServer::accumulative_connections() { return statistic_.server_stat.
 
 long long PikaServer::ServerKeyspaceHits() { return statistic_.server_stat.keyspace_hits.load(); } 
 long long PikaServer::ServerKeyspaceMisses() { return statistic_.server_stat.keyspace_misses.load(); }
+uint64_t PikaServer::SplitPipelines() { return statistic_.server_stat.split_pipelines.load(); }
+uint64_t PikaServer::SplitPipelineSegments() { return statistic_.server_stat.split_pipeline_segments.load(); }
 
 void PikaServer::incr_accumulative_connections() { ++(statistic_.server_stat.accumulative_connections); }
 void PikaServer::incr_server_keyspace_hits() { ++(statistic_.server_stat.keyspace_hits); }
 void PikaServer::incr_server_keyspace_misses() { ++(statistic_.server_stat.keyspace_misses); }
+void PikaServer::incr_split_pipelines(uint64_t segments) {
+  ++(statistic_.server_stat.split_pipelines);
+  statistic_.server_stat.split_pipeline_segments += segments;
+}
 
 // only one thread invoke this right now
 void PikaServer::ResetLastSecQuerynum() {
@@ -1030,6 +1068,10 @@ size_t PikaServer::NetReplInputBytes() { return g_network_statistic->NetReplInpu
 
 size_t PikaServer::NetReplOutputBytes() { return g_network_statistic->NetReplOutputBytes(); }
 
+size_t PikaServer::OutputBufferLimitCloses() { return g_network_statistic->OutputBufferLimitCloses(); }
+
+size_t PikaServer::ClientReadPauses() { return g_network_statistic->ReadPauses(); }
+
 float PikaServer::InstantaneousInputKbps() {
   return static_cast<float>(g_pika_server->instant_->getInstantaneousMetric(STATS_METRIC_NET_INPUT)) / 1024.0f;
 }
@@ -1114,6 +1156,8 @@ void PikaServer::DoTimingTask() {
   AutoBinlogPurge();
   // Delete expired dump
   AutoDeleteExpiredDump();
+  // Release the streaming dumps no slave syncs from
+  AutoReleaseStreamingDump();
   // Cheek Rsync Status
   // TODO: temporarily disable rsync
   // AutoKeepAliveRSync();
@@ -1126,6 +1170,8 @@ void PikaServer::DoTimingTask() {
   // Print the queue status periodically
   PrintThreadPoolQueueStatus();
   StatDiskUsage();
+  // Pin the threads started since, rocksdb ones in particular
+  thread_placement_.Sweep();
 }
 
 void PikaServer::StatDiskUsage() {
@@ -1320,6 +1366,13 @@ void PikaServer::AutoServerlogPurge() {
   }
 }
 
+void PikaServer::AutoReleaseStreamingDump() {
+  std::shared_lock l(dbs_rw_);
+  for (const auto& db_item : dbs_) {
+    db_item.second->AutoReleaseStreamingBgSave();
+  }
+}
+
 void PikaServer::AutoDeleteExpiredDump() {
   std::string db_sync_prefix = g_pika_conf->bgsave_prefix();
   std::string db_sync_path = g_pika_conf->bgsave_path();
@@ -148,6 +148,11 @@ void SCardCmd::ReadCache() {
   }
 }
 
+void SCardCmd::ReplyKeyNotExist() {
+  res_.AppendInteger(0);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void SCardCmd::DoThroughDB() {
   res_.clear();
   Do();
@@ -187,21 +192,19 @@ void SMembersCmd::Do() {
 }
 
 void SMembersCmd::ReadCache() {
-  std::vector<std::string> members;
-  auto s = db_->cache()->SMembers(key_, &members);
-  if (s.ok()) {
-    res_.AppendArrayLen(members.size());
-    for (const auto& member : members) {
-      res_.AppendStringLen(member.size());
-      res_.AppendContent(member);
-    }
-  } else if (s.IsNotFound()) {
+  auto s = db_->cache()->SMembersResp(key_, res_.mutable_message());
+  if (s.IsNotFound()) {
     res_.SetRes(CmdRes::kCacheMiss);
-  } else {
+  } else if (!s.ok()) {
     res_.SetRes(CmdRes::kErrOther, s.ToString());
   }
 }
 
+void SMembersCmd::ReplyKeyNotExist() {
+  res_.AppendArrayLen(0);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void SMembersCmd::DoThroughDB() {
   res_.clear();
   Do();
@@ -0,0 +1,291 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "include/pika_thread_placement.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#include <glog/logging.h>
+
+#include "include/pika_conf.h"
+#include "include/pika_define.h"
+#include "pstd/include/env.h"
+#include "pstd/include/pstd_string.h"
+
+extern std::unique_ptr<PikaConf> g_pika_conf;
+
+namespace {
+
+struct ThreadGroup {
+  const char* name;
+  // prefixes of the thread names, short enough to match the names the
+  // kernel truncates to 15 chars
+  std::vector<std::string> prefixes;
+};
+
+const std::vector<ThreadGroup> kThreadGroups = {
+    {"net-worker", {"WorkerThread", "Dispatcher"}},
+    {"client-pool", {"CliProcessorPoo"}},
+    {"slow-pool", {"SlowCmdPool"}},
+    {"admin-pool", {"AdminCmdPool"}},
+    {"repl-worker", {"ReplBinlogWork", "ReplWriteDBWork"}},
+    {"rocksdb", {"rocksdb:"}},
+    {"cache-load", {"PikaCacheLoadTh"}},
+};
+
+const std::string kWorkerThreadName = "WorkerThread";
+
+bool ReadFirstLine(const std::string& path, std::string* line) {
+  std::ifstream in(path);
+  return in && std::getline(in, *line);
+}
+
+// the tids of the live threads of the process
+std::vector<pid_t> Tasks() {
+  std::vector<std::string> children;
+  std::vector<pid_t> tids;
+  if (pstd::GetChildren("/proc/self/task", children) != 0) {
+    return tids;
+  }
+  for (const auto& child : children) {
+    long tid = 0;
+    if (pstd::string2int(child.data(), child.size(), &tid) != 0) {
+      tids.push_back(static_cast<pid_t>(tid));
+    }
+  }
+  return tids;
+}
+
+}  // namespace
+
+PikaThreadPlacement::PikaThreadPlacement() {
+  CPU_ZERO(&all_cpus_);
+  if (sched_getaffinity(0, sizeof(all_cpus_), &all_cpus_) != 0) {
+    for (long cpu = 0; cpu < sysconf(_SC_NPROCESSORS_CONF) && cpu < CPU_SETSIZE; ++cpu) {
+      CPU_SET(cpu, &all_cpus_);
+    }
+  }
+}
+
+bool PikaThreadPlacement::ParseCpus(const std::string& desc, cpu_set_t* cpus) {
+  std::string list = desc;
+  // a numa node stands for the cpus the kernel lists for it
+  if (list.compare(0, 4, "node") == 0) {
+    long node = 0;
+    if (pstd::string2int(list.data() + 4, list.size() - 4, &node) == 0 || node < 0
+        || !ReadFirstLine("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist", &list)) {
+      return false;
+    }
+  }
+
+  CPU_ZERO(cpus);
+  std::vector<std::string> ranges;
+  pstd::StringSplit(list, ',', ranges);
+  for (const auto& range : ranges) {
+    size_t dash = range.find('-');
+    long first = 0;
+    long last = 0;
+    if (pstd::string2int(range.data(), dash == std::string::npos ? range.size() : dash, &first) == 0) {
+      return false;
+    }
+    last = first;
+    if (dash != std::string::npos
+        && pstd::string2int(range.data() + dash + 1, range.size() - dash - 1, &last) == 0) {
+      return false;
+    }
+    if (first < 0 || first > last || last >= CPU_SETSIZE) {
+      return false;
+    }
+    for (long cpu = first; cpu <= last; ++cpu) {
+      CPU_SET(cpu, cpus);
+    }
+  }
+  return CPU_COUNT(cpus) > 0;
+}
+
+bool PikaThreadPlacement::Parse(const std::string& spec, std::map<std::string, Placement>* placement,
+                                std::string* err) {
+  placement->clear();
+  std::vector<std::string> entries;
+  pstd::StringSplit(spec, ';', entries);
+  for (const auto& raw_entry : entries) {
+    std::string entry = pstd::StringTrim(raw_entry);
+    if (entry.empty()) {
+      continue;
+    }
+    size_t eq = entry.find('=');
+    if (eq == std::string::npos) {
+      *err = "no '=' in " + entry;
+      return false;
+    }
+    std::string group = pstd::StringTrim(entry.substr(0, eq));
+    std::string desc = pstd::StringTrim(entry.substr(eq + 1));
+    auto iter = std::find_if(kThreadGroups.begin(), kThreadGroups.end(),
+                             [&group](const ThreadGroup& g) { return group == g.name; });
+    if (iter == kThreadGroups.end()) {
+      *err = "unknown thread group " + group;
+      return false;
+    }
+    Placement& p = (*placement)[group];
+    if (!ParseCpus(desc, &p.cpus)) {
+      *err = "invalid cpus " + desc + " for " + group;
+      return false;
+    }
+    p.desc = desc;
+  }
+  return true;
+}
+
+const char* PikaThreadPlacement::GroupOf(const std::string& name) {
+  for (const auto& group : kThreadGroups) {
+    for (const auto& prefix : group.prefixes) {
+      if (name.compare(0, prefix.size(), prefix) == 0) {
+        return group.name;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool PikaThreadPlacement::CpusOf(const std::string& name, cpu_set_t* cpus) {
+  const char* group = GroupOf(name);
+  if (!group) {
+    return false;
+  }
+  auto iter = placement_.find(group);
+  if (iter == placement_.end()) {
+    return false;
+  }
+  *cpus = iter->second.cpus;
+  // leave out the cpus the process may not run on, the kernel rejects a set
+  // with none of the others
+  cpu_set_t allowed;
+  CPU_AND(&allowed, cpus, &all_cpus_);
+  if (CPU_COUNT(&allowed) > 0) {
+    *cpus = allowed;
+  }
+
+  // with the conns steered to the listener of the cpu they came in on, a
+  // worker better runs on the cpus it gets the conns of
+  long index = 0;
+  if (g_pika_conf->reuse_port() && g_pika_conf->reuse_port_cpu_steering()
+      && name.compare(0, kWorkerThreadName.size(), kWorkerThreadName) == 0
+      && pstd::string2int(name.data() + kWorkerThreadName.size(), name.size() - kWorkerThreadName.size(), &index) != 0) {
+    int worker_num = std::min(g_pika_conf->thread_num(), PIKA_MAX_WORKER_THREAD_NUM);
+    cpu_set_t steered;
+    CPU_ZERO(&steered);
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, cpus) && cpu % worker_num == index) {
+        CPU_SET(cpu, &steered);
+      }
+    }
+    if (CPU_COUNT(&steered) > 0) {
+      *cpus = steered;
+    }
+  }
+  return true;
+}
+
+void PikaThreadPlacement::PinThread(pthread_t id, const std::string& name) {
+  cpu_set_t cpus;
+  std::shared_lock l(mu_);
+  if (!CpusOf(name, &cpus)) {
+    return;
+  }
+  int ret = pthread_setaffinity_np(id, sizeof(cpus), &cpus);
+  if (ret != 0) {
+    LOG(WARNING) << "pin thread " << name << " failed, error " << ret;
+  }
+}
+
+void PikaThreadPlacement::PinAll(bool reset_unplaced) {
+  for (pid_t tid : Tasks()) {
+    std::string name;
+    if (!ReadFirstLine("/proc/self/task/" + std::to_string(tid) + "/comm", &name)) {
+      // gone already
+      continue;
+    }
+    cpu_set_t cpus;
+    if (!CpusOf(name, &cpus)) {
+      if (!reset_unplaced) {
+        continue;
+      }
+      cpus = all_cpus_;
+    }
+    if (sched_setaffinity(tid, sizeof(cpus), &cpus) != 0 && errno != ESRCH) {
+      LOG(WARNING) << "pin thread " << name << " (" << tid << ") failed, errno " << errno;
+    }
+  }
+}
+
+bool PikaThreadPlacement::Reset(const std::string& spec, std::string* err) {
+  std::map<std::string, Placement> placement;
+  if (!Parse(spec, &placement, err)) {
+    return false;
+  }
+  std::lock_guard l(mu_);
+  placement_.swap(placement);
+  PinAll(true);
+  return true;
+}
+
+void PikaThreadPlacement::Sweep() {
+  std::shared_lock l(mu_);
+  if (placement_.empty()) {
+    return;
+  }
+  PinAll(false);
+}
+
+std::vector<PikaThreadPlacement::GroupUsage> PikaThreadPlacement::Usage() {
+  std::vector<GroupUsage> usages;
+  {
+    std::shared_lock l(mu_);
+    for (const auto& group : kThreadGroups) {
+      GroupUsage usage;
+      usage.group = group.name;
+      auto iter = placement_.find(group.name);
+      usage.cpus = iter == placement_.end() ? "all" : iter->second.desc;
+      usages.push_back(usage);
+    }
+  }
+
+  static const double kClockTicks = static_cast<double>(sysconf(_SC_CLK_TCK));
+  for (pid_t tid : Tasks()) {
+    std::string stat;
+    if (!ReadFirstLine("/proc/self/task/" + std::to_string(tid) + "/stat", &stat)) {
+      continue;
+    }
+    // pid (comm) state ..., the comm may hold spaces and parentheses itself
+    size_t open = stat.find('(');
+    size_t close = stat.rfind(')');
+    if (open == std::string::npos || close == std::string::npos || close < open) {
+      continue;
+    }
+    const char* group = GroupOf(stat.substr(open + 1, close - open - 1));
+    if (!group) {
+      continue;
+    }
+    // utime and stime are the 14th and 15th fields, the 12th and 13th after comm
+    std::istringstream fields(stat.substr(close + 1));
+    std::string field;
+    uint64_t utime = 0;
+    uint64_t stime = 0;
+    for (int i = 0; i < 11 && fields >> field; ++i) {
+    }
+    if (!(fields >> utime >> stime)) {
+      continue;
+    }
+    auto iter = std::find_if(usages.begin(), usages.end(), [group](const GroupUsage& u) { return u.group == group; });
+    ++iter->threads;
+    iter->used_cpu += static_cast<double>(utime + stime) / kClockTicks;
+  }
+  return usages;
+}
@@ -66,6 +66,8 @@ void ExecCmd::Do() {
       }
       client_conn->SetTxnFailedIfKeyExists(each_cmd_info.db_->GetDBName());
     } else {
+      // the cache may be ahead of db for counters waiting to be written behind
+      db->cache_write_behind()->Flush(cmd->current_key());
       cmd->Do();
       if (cmd->res().ok() && cmd->is_write()) {
         cmd->DoBinlog();
@@ -76,6 +78,7 @@ void ExecCmd::Do() {
         if (cmd->IsNeedUpdateCache()) {
           cmd->DoUpdateCache();
         }
+        each_cmd_info.db_->cache()->DelNegativeKeys(cmd->current_key());
         client_conn->SetTxnFailedFromKeys(db_keys);
       }
     }
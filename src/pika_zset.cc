@@ -81,6 +81,11 @@ void ZCardCmd::ReadCache() {
   res_.SetRes(CmdRes::kCacheMiss);
 }
 
+void ZCardCmd::ReplyKeyNotExist() {
+  res_.AppendInteger(0);
+  res_.SetRes(CmdRes::kNoExists);
+}
+
 void ZCardCmd::DoThroughDB() {
   res_.clear();
   Do();
@@ -250,33 +255,12 @@ void ZRangeCmd::Do() {
 }
 
 void ZRangeCmd::ReadCache() {
-  std::vector<storage::ScoreMember> score_members;
-  auto s = db_->cache()->ZRange(key_, start_, stop_, &score_members, db_);
-  if (s.ok()) {
-    if (is_ws_) {
-      char buf[32];
-      int64_t len;
-      res_.AppendArrayLen(score_members.size() * 2);
-      for (const auto& sm : score_members) {
-        res_.AppendStringLen(sm.member.size());
-        res_.AppendContent(sm.member);
-        len = pstd::d2string(buf, sizeof(buf), sm.score);
-        res_.AppendStringLen(len);
-        res_.AppendContent(buf);
-      }
-    } else {
-      res_.AppendArrayLen(score_members.size());
-      for (const auto& sm : score_members) {
-        res_.AppendStringLen(sm.member.size());
-        res_.AppendContent(sm.member);
-      }
-    }
-  } else if (s.IsNotFound()) {
+  auto s = db_->cache()->ZRangeResp(key_, start_, stop_, is_ws_, res_.mutable_message(), db_);
+  if (s.IsNotFound()) {
     res_.SetRes(CmdRes::kCacheMiss);
-  } else {
+  } else if (!s.ok()) {
     res_.SetRes(CmdRes::kErrOther, s.ToString());
   }
-  return;
 }
 
 void ZRangeCmd::DoThroughDB() {
@@ -328,34 +312,12 @@ void ZRevrangeCmd::Do() {
 }
 
 void ZRevrangeCmd::ReadCache() {
-  std::vector<storage::ScoreMember> score_members;
-  auto s = db_->cache()->ZRevrange(key_, start_, stop_, &score_members, db_);
-
-  if (s.ok()) {
-    if (is_ws_) {
-      char buf[32];
-      int64_t len;
-      res_.AppendArrayLen(score_members.size() * 2);
-      for (const auto& sm : score_members) {
-        res_.AppendStringLen(sm.member.size());
-        res_.AppendContent(sm.member);
-        len = pstd::d2string(buf, sizeof(buf), sm.score);
-        res_.AppendStringLen(len);
-        res_.AppendContent(buf);
-      }
-    } else {
-      res_.AppendArrayLen(score_members.size());
-      for (const auto& sm : score_members) {
-        res_.AppendStringLen(sm.member.size());
-        res_.AppendContent(sm.member);
-      }
-    }
-  } else if (s.IsNotFound()) {
+  auto s = db_->cache()->ZRevrangeResp(key_, start_, stop_, is_ws_, res_.mutable_message(), db_);
+  if (s.IsNotFound()) {
     res_.SetRes(CmdRes::kCacheMiss);
-  } else {
-    res_.SetRes(CmdRes::kErrOther, s_.ToString());
+  } else if (!s.ok()) {
+    res_.SetRes(CmdRes::kErrOther, s.ToString());
   }
-  return;
 }
 
 void ZRevrangeCmd::DoThroughDB() {
@@ -0,0 +1,68 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include "pstd/include/pstd_crc32c.h"
+
+#include <cstring>
+
+#ifdef __SSE4_2__
+#include <nmmintrin.h>
+#endif
+
+namespace pstd::crc32c {
+
+#ifdef __SSE4_2__
+
+uint32_t Extend(uint32_t init_crc, const char* data, size_t n) {
+  uint64_t crc = init_crc ^ 0xffffffffu;
+  const char* p = data;
+  const char* end = data + n;
+  while (p + sizeof(uint64_t) <= end) {
+    uint64_t word;
+    memcpy(&word, p, sizeof(word));
+    crc = _mm_crc32_u64(crc, word);
+    p += sizeof(uint64_t);
+  }
+  auto crc32 = static_cast<uint32_t>(crc);
+  while (p < end) {
+    crc32 = _mm_crc32_u8(crc32, static_cast<uint8_t>(*p));
+    ++p;
+  }
+  return crc32 ^ 0xffffffffu;
+}
+
+#else
+
+namespace {
+
+// table of the reflected Castagnoli polynomial, one byte at a time
+struct Crc32cTable {
+  uint32_t entries[256];
+  Crc32cTable() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0x82f63b78u : crc >> 1;
+      }
+      entries[i] = crc;
+    }
+  }
+};
+
+const Crc32cTable kTable;
+
+}  // namespace
+
+uint32_t Extend(uint32_t init_crc, const char* data, size_t n) {
+  uint32_t crc = init_crc ^ 0xffffffffu;
+  for (size_t i = 0; i < n; ++i) {
+    crc = kTable.entries[(crc ^ static_cast<uint8_t>(data[i])) & 0xff] ^ (crc >> 8);
+  }
+  return crc ^ 0xffffffffu;
+}
+
+#endif
+
+}  // namespace pstd::crc32c
@@ -0,0 +1,59 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "pstd/include/pstd_crc32c.h"
+
+namespace pstd::crc32c {
+
+class CRC : public ::testing::Test {};
+
+TEST_F(CRC, StandardResults) {
+  // From rfc3720 section B.4.
+  char buf[32];
+
+  memset(buf, 0, sizeof(buf));
+  ASSERT_EQ(0x8a9136aaU, Value(buf, sizeof(buf)));
+
+  memset(buf, 0xff, sizeof(buf));
+  ASSERT_EQ(0x62a8ab43U, Value(buf, sizeof(buf)));
+
+  for (int i = 0; i < 32; i++) {
+    buf[i] = static_cast<char>(i);
+  }
+  ASSERT_EQ(0x46dd794eU, Value(buf, sizeof(buf)));
+
+  for (int i = 0; i < 32; i++) {
+    buf[i] = static_cast<char>(31 - i);
+  }
+  ASSERT_EQ(0x113fdb5cU, Value(buf, sizeof(buf)));
+
+  ASSERT_EQ(0xe3069283U, Value("123456789", 9));
+}
+
+TEST_F(CRC, Values) { ASSERT_NE(Value("a", 1), Value("foo", 3)); }
+
+TEST_F(CRC, Extend) {
+  ASSERT_EQ(Value("hello world", 11), Extend(Value("hello ", 6), "world", 5));
+  // unaligned tails
+  std::string data(1000, 'x');
+  for (size_t split = 0; split < 17; ++split) {
+    ASSERT_EQ(Value(data.data(), data.size()),
+              Extend(Value(data.data(), split), data.data() + split, data.size() - split));
+  }
+}
+
+TEST_F(CRC, Mask) {
+  uint32_t crc = Value("foo", 3);
+  ASSERT_NE(crc, Mask(crc));
+  ASSERT_NE(crc, Mask(Mask(crc)));
+  ASSERT_EQ(crc, Unmask(Mask(crc)));
+  ASSERT_EQ(crc, Unmask(Unmask(Mask(Mask(crc)))));
+}
+
+}  // namespace pstd::crc32c
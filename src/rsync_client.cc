@@ -4,12 +4,14 @@
 // of patent rights can be found in the PATENTS file in the same directory.
 
 #include <stdio.h>
+#include <algorithm>
 #include <fstream>
 
 #include "rocksdb/env.h"
 #include "pstd/include/pstd_defer.h"
 #include "include/pika_server.h"
 #include "include/rsync_client.h"
+#include "include/rsync_server.h"
 
 using namespace net;
 using namespace pstd;
@@ -35,10 +37,12 @@ RsyncClient::RsyncClient(const std::string& dir, const std::string& db_name)
 
 void RsyncClient::Copy(const std::set<std::string>& file_set, int index) {
   Status s = Status::OK();
+  // the window learnt on one file carries over to the next
+  RsyncWindow window(g_pika_conf->max_rsync_window_num());
   for (const auto& file : file_set) {
     while (state_.load() == RUNNING) {
       LOG(INFO) << "copy remote file, filename: " << file;
-      s = CopyRemoteFile(file, index);
+      s = CopyRemoteFile(file, index, &window);
       if (!s.ok()) {
         LOG(WARNING) << "copy remote file failed, msg: " << s.ToString();
         continue;
@@ -164,13 +168,28 @@ void* RsyncClient::ThreadMain() {
   return nullptr;
 }
 
-Status RsyncClient::CopyRemoteFile(const std::string& filename, int index) {
+Status RsyncClient::CopyRemoteFile(const std::string& filename, int index, RsyncWindow* window) {
     const std::string filepath = dir_ + "/" + filename;
     std::unique_ptr<RsyncWriter> writer(new RsyncWriter(filepath));
     Status s = Status::OK();
-    size_t offset = 0;
     int retries = 0;
 
+    struct Chunk {
+      size_t count;
+      uint64_t send_time_us;
+    };
+    // offset -> chunk requested and not answered yet
+    std::map<size_t, Chunk> inflight;
+    // ranges left by short responses, requested again before new ones
+    std::deque<std::pair<size_t, size_t>> gaps;
+    size_t next_offset = 0;
+    // servers not sending the file size are asked one chunk at a time
+    // until eof, as before
+    bool size_known = false;
+    size_t file_size = 0;
+    window->SetMaxSize(g_pika_conf->max_rsync_window_num());
+    WaitObject* wo = wo_mgr_->UpdateWaitObject(index, filename, kRsyncFile, 0);
+
     DEFER {
       if (writer) {
         writer->Close();
@@ -185,33 +204,53 @@ Status RsyncClient::CopyRemoteFile(const std::string& filename, int index) {
       if (state_.load() != RUNNING) {
         break;
       }
-      size_t copy_file_begin_time = pstd::NowMicros();
-      size_t count = Throttle::GetInstance().ThrottledByThroughput(kBytesPerRequest);
-      if (count == 0) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1000 / kThrottleCheckCycle));
-        continue;
+      size_t window_size = size_known ? window->Size() : 1;
+      while (inflight.size() < window_size) {
+        size_t offset = next_offset;
+        size_t want = kBytesPerRequest;
+        if (!gaps.empty()) {
+          offset = gaps.front().first;
+          want = std::min(want, gaps.front().second);
+        } else if (size_known) {
+          if (next_offset >= file_size) {
+            break;
+          }
+          want = std::min(want, file_size - next_offset);
+        }
+        size_t count = Throttle::GetInstance().ThrottledByThroughput(want);
+        if (count == 0) {
+          break;
+        }
+        if (!gaps.empty()) {
+          gaps.front().first += count;
+          gaps.front().second -= count;
+          if (gaps.front().second == 0) {
+            gaps.pop_front();
+          }
+        } else {
+          next_offset += count;
+        }
+        inflight[offset] = {count, pstd::NowMicros()};
+        wo->Expect(offset);
+        s = SendFileRequest(filename, index, offset, count);
+        if (!s.ok()) {
+          // the request is sent again when the wait times out
+          LOG(WARNING) << "send rsync request failed";
+        }
       }
-      RsyncRequest request;
-      request.set_reader_index(index);
-      request.set_type(kRsyncFile);
-      request.set_db_name(db_name_);
-      /*
-       * Since the slot field is written in protobuffer,
-       * slot_id is set to the default value 0 for compatibility
-       * with older versions, but slot_id is not used
-       */
-      request.set_slot_id(0);
-      FileRequest* file_req = request.mutable_file_req();
-      file_req->set_filename(filename);
-      file_req->set_offset(offset);
-      file_req->set_count(count);
-
-      std::string to_send;
-      request.SerializeToString(&to_send);
-      WaitObject* wo = wo_mgr_->UpdateWaitObject(index, filename, kRsyncFile, offset);
-      s = client_thread_->Write(master_ip_, master_port_, to_send);
-      if (!s.ok()) {
-        LOG(WARNING) << "send rsync request failed";
+      if (inflight.empty()) {
+        if (size_known && next_offset >= file_size && gaps.empty()) {
+          s = writer->Fsync();
+          if (!s.ok()) {
+            return s;
+          }
+          mu_.lock();
+          meta_table_[filename] = "";
+          mu_.unlock();
+          break;
+        }
+        // throttled
+        std::this_thread::sleep_for(std::chrono::milliseconds(1000 / kThrottleCheckCycle));
         continue;
       }
 
@@ -220,17 +259,21 @@ Status RsyncClient::CopyRemoteFile(const std::string& filename, int index) {
       if (s.IsTimeout() || resp == nullptr) {
         LOG(WARNING) << s.ToString();
         retries++;
+        window->OnTimeout();
+        // a response arriving late to the first request is taken and the
+        // one to the second dropped
+        for (auto& [offset, chunk] : inflight) {
+          chunk.send_time_us = pstd::NowMicros();
+          SendFileRequest(filename, index, offset, chunk.count);
+        }
         continue;
       }
 
       if (resp->code() != RsyncService::kOk) {
-        return Status::IOError("kRsyncFile request failed, master response error code");
+        s = Status::IOError("kRsyncFile request failed, master response error code");
+        return s;
       }
 
-      size_t ret_count = resp->file_resp().count();
-      size_t elaspe_time_us = pstd::NowMicros() - copy_file_begin_time;
-      Throttle::GetInstance().ReturnUnusedThroughput(count, ret_count, elaspe_time_us);
-
       if (resp->snapshot_uuid() != snapshot_uuid_) {
         LOG(WARNING) << "receive newer dump, reset state to STOP, local_snapshot_uuid:"
                      << snapshot_uuid_ << ", remote snapshot uuid: " << resp->snapshot_uuid();
@@ -239,22 +282,33 @@ Status RsyncClient::CopyRemoteFile(const std::string& filename, int index) {
         return s;
       }
 
+      size_t offset = resp->file_resp().offset();
+      auto iter = inflight.find(offset);
+      if (iter == inflight.end()) {
+        continue;
+      }
+      size_t count = iter->second.count;
+      uint64_t elaspe_time_us = pstd::NowMicros() - iter->second.send_time_us;
+      inflight.erase(iter);
+      size_t ret_count = resp->file_resp().count();
+      Throttle::GetInstance().ReturnUnusedThroughput(count, ret_count, elaspe_time_us);
+      window->OnResponse(elaspe_time_us, ret_count);
+
       s = writer->Write((uint64_t)offset, ret_count, resp->file_resp().data().c_str());
       if (!s.ok()) {
         LOG(WARNING) << "rsync client write file error";
         break;
       }
 
-      offset += resp->file_resp().count();
-      if (resp->file_resp().eof()) {
-        s = writer->Fsync();
-        if (!s.ok()) {
-            return s;
-        } 
-        mu_.lock();
-        meta_table_[filename] = "";
-        mu_.unlock();
-        break;
+      if (resp->file_resp().has_file_size()) {
+        size_known = true;
+        file_size = resp->file_resp().file_size();
+      } else if (resp->file_resp().eof()) {
+        size_known = true;
+        file_size = offset + ret_count;
+      }
+      if (ret_count < count && !resp->file_resp().eof()) {
+        gaps.emplace_back(offset + ret_count, count - ret_count);
       }
       retries = 0;
     }
@@ -262,6 +316,67 @@ Status RsyncClient::CopyRemoteFile(const std::string& filename, int index) {
   return s;
 }
 
+Status RsyncClient::SendFileRequest(const std::string& filename, int index, size_t offset, size_t count) {
+  RsyncRequest request;
+  request.set_reader_index(index);
+  request.set_type(kRsyncFile);
+  request.set_db_name(db_name_);
+  /*
+   * Since the slot field is written in protobuffer,
+   * slot_id is set to the default value 0 for compatibility
+   * with older versions, but slot_id is not used
+   */
+  request.set_slot_id(0);
+  FileRequest* file_req = request.mutable_file_req();
+  file_req->set_filename(filename);
+  file_req->set_offset(offset);
+  file_req->set_count(count);
+
+  std::string to_send;
+  request.SerializeToString(&to_send);
+  return client_thread_->Write(master_ip_, master_port_, to_send);
+}
+
+void RsyncWindow::OnResponse(uint64_t latency_us, size_t bytes) {
+  uint64_t now = pstd::NowMicros();
+  latency_us = std::max<uint64_t>(latency_us, 1);
+  min_latency_us_ = std::min(min_latency_us_, latency_us);
+  if (round_resps_ == 0) {
+    round_start_us_ = now - latency_us;
+  }
+  round_resps_++;
+  round_bytes_ += bytes;
+  if (round_resps_ < size_) {
+    return;
+  }
+
+  uint64_t round_us = std::max<uint64_t>(now - round_start_us_, 1);
+  double bytes_per_us = static_cast<double>(round_bytes_) / static_cast<double>(round_us);
+  size_t chunk_bytes = round_bytes_ / round_resps_;
+  round_resps_ = 0;
+  round_bytes_ = 0;
+  if (bytes_per_us > best_bytes_per_us_ * 1.1) {
+    // the pipe is not full yet
+    best_bytes_per_us_ = bytes_per_us;
+    size_ = std::min(size_ * 2, max_size_);
+    return;
+  }
+  best_bytes_per_us_ = std::max(best_bytes_per_us_, bytes_per_us);
+  if (chunk_bytes == 0) {
+    return;
+  }
+  double bdp_bytes = best_bytes_per_us_ * static_cast<double>(min_latency_us_);
+  auto bdp_chunks = static_cast<size_t>(bdp_bytes / static_cast<double>(chunk_bytes));
+  size_ = std::clamp<size_t>(bdp_chunks + 1, 1, max_size_);
+}
+
+void RsyncWindow::OnTimeout() {
+  size_ = std::max<size_t>(size_ / 2, 1);
+  round_resps_ = 0;
+  round_bytes_ = 0;
+  best_bytes_per_us_ = 0;
+}
+
 Status RsyncClient::Start() {
   StartThread();
   return Status::OK();
@@ -330,6 +445,7 @@ bool RsyncClient::ComparisonUpdate() {
     LOG(WARNING) << "update local meta failed";
     return false;
   }
+  LinkLocalFiles();
 
   state_.store(RUNNING);
   error_stopped_.store(false);
@@ -389,6 +505,10 @@ Status RsyncClient::PullRemoteMeta(std::string* snapshot_uuid, std::set<std::str
     for (std::string item : resp->meta_resp().filenames()) {
       file_set->insert(item);
     }
+    remote_sst_metas_.clear();
+    for (const auto& sst_meta : resp->meta_resp().sst_metas()) {
+      remote_sst_metas_[sst_meta.filename()] = sst_meta;
+    }
 
     *snapshot_uuid = resp->snapshot_uuid();
     s = Status::OK();
@@ -397,6 +517,49 @@ Status RsyncClient::PullRemoteMeta(std::string* snapshot_uuid, std::set<std::str
   return s;
 }
 
+/*
+ * The ssts of the dump which are already in the local db, typically left by
+ * an earlier full sync, are hard linked from there instead of transferred.
+ * A link keeps the file when the local db is dropped after the sync.
+ */
+void RsyncClient::LinkLocalFiles() {
+  const std::string local_path = g_pika_conf->db_path() + db_name_ + "/";
+  size_t linked_num = 0;
+  uint64_t linked_bytes = 0;
+  for (auto iter = file_set_.begin(); iter != file_set_.end();) {
+    auto meta = remote_sst_metas_.find(*iter);
+    if (meta == remote_sst_metas_.end()) {
+      ++iter;
+      continue;
+    }
+    const std::string local_file = local_path + *iter;
+    const std::string sync_file = dir_ + "/" + *iter;
+    uint64_t size = 0;
+    uint32_t checksum = 0;
+    if (!FileExists(local_file) || !SstIdentity(local_file, &size, &checksum).ok()
+        || size != meta->second.size() || checksum != meta->second.checksum()) {
+      ++iter;
+      continue;
+    }
+    DeleteFile(sync_file);
+    if (link(local_file.c_str(), sync_file.c_str()) != 0) {
+      // e.g. db-sync-path is on another file system
+      LOG(WARNING) << "link " << local_file << " to " << sync_file << " failed: " << strerror(errno);
+      ++iter;
+      continue;
+    }
+    {
+      std::lock_guard<std::mutex> guard(mu_);
+      meta_table_[*iter] = "";
+    }
+    ++linked_num;
+    linked_bytes += size;
+    iter = file_set_.erase(iter);
+  }
+  LOG(INFO) << "rsync reuses " << linked_num << " local sst files (" << linked_bytes << " bytes) of db " << db_name_
+            << ", " << file_set_.size() << " files left to copy";
+}
+
 Status RsyncClient::LoadLocalMeta(std::string* snapshot_uuid, std::map<std::string, std::string>* file_map) {
   std::string meta_file_path = GetLocalMetaFilePath();
   if (!FileExists(meta_file_path)) {
@@ -11,6 +11,7 @@
 #include "pstd_hash.h"
 #include "include/pika_server.h"
 #include "include/rsync_server.h"
+#include "pstd/include/pstd_crc32c.h"
 #include "pstd/include/pstd_defer.h"
 
 extern PikaServer* g_pika_server;
@@ -30,6 +31,42 @@ void RsyncWriteResp(RsyncService::RsyncResponse& response, std::shared_ptr<net::
   conn->NotifyWrite();
 }
 
+bool IsSstFile(const std::string& filename) {
+  const std::string suffix = ".sst";
+  return filename.size() > suffix.size()
+         && filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+Status SstIdentity(const std::string& filepath, uint64_t* size, uint32_t* checksum) {
+  int fd = open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return Status::IOError(filepath, strerror(errno));
+  }
+  DEFER {
+    close(fd);
+  };
+  struct stat buf;
+  if (fstat(fd, &buf) != 0) {
+    return Status::IOError(filepath, strerror(errno));
+  }
+  *size = buf.st_size;
+  size_t tail_size = std::min<uint64_t>(*size, kSstIdentityTailSize);
+  char tail[kSstIdentityTailSize];
+  size_t done = 0;
+  while (done < tail_size) {
+    ssize_t n = pread(fd, tail + done, tail_size - done, static_cast<off_t>(*size - tail_size + done));
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      return Status::IOError(filepath, "read sst tail failed");
+    }
+    done += n;
+  }
+  *checksum = pstd::crc32c::Value(tail, tail_size);
+  return Status::OK();
+}
+
 RsyncServer::RsyncServer(const std::set<std::string>& ips, const int port) {
   work_thread_ = std::make_unique<net::ThreadPool>(2, 100000, "RsyncServerWork");
   rsync_server_thread_ = std::make_unique<RsyncServerThread>(ips, port, 1 * 1000, this);
@@ -153,6 +190,17 @@ void RsyncServerConn::HandleMetaRsyncRequest(void* arg) {
   for (const auto& filename : filenames) {
         meta_resp->add_filenames(filename);
   }
+  for (const auto& filename : filenames) {
+    uint64_t size = 0;
+    uint32_t checksum = 0;
+    if (!IsSstFile(filename) || !SstIdentity(db->BgSaveFilePath(filename), &size, &checksum).ok()) {
+      continue;
+    }
+    RsyncService::SstMeta* sst_meta = meta_resp->add_sst_metas();
+    sst_meta->set_filename(filename);
+    sst_meta->set_size(size);
+    sst_meta->set_checksum(checksum);
+  }
   RsyncWriteResp(response, conn);
 }
 
@@ -195,14 +243,15 @@ void RsyncServerConn::HandleFileRsyncRequest(void* arg) {
    RsyncWriteResp(response, conn);
   }
 
-  const std::string filepath = db->bgsave_info().path + "/" + filename;
+  const std::string filepath = db->BgSaveFilePath(filename);
   char* buffer = new char[req->file_req().count() + 1];
   size_t bytes_read{0};
   std::string checksum = "";
   bool is_eof = false;
+  size_t file_size = 0;
   std::shared_ptr<RsyncReader> reader = conn->readers_[req->reader_index()];
   s = reader->Read(filepath, offset, count, buffer,
-                   &bytes_read, &checksum, &is_eof);
+                   &bytes_read, &checksum, &is_eof, &file_size);
   if (!s.ok()) {
     response.set_code(RsyncService::kErr);
     RsyncWriteResp(response, conn);
@@ -217,6 +266,7 @@ void RsyncServerConn::HandleFileRsyncRequest(void* arg) {
   file_resp->set_filename(filename);
   file_resp->set_count(bytes_read);
   file_resp->set_offset(offset);
+  file_resp->set_file_size(file_size);
 
   RsyncWriteResp(response, conn);
   delete []buffer;
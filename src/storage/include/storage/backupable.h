@@ -6,6 +6,7 @@
 #ifndef SRC_BACKUPABLE_H_
 #define SRC_BACKUPABLE_H_
 
+#include <set>
 #include <utility>
 
 #include "rocksdb/db.h"
@@ -53,12 +54,21 @@ class BackupEngine {
 
   Status CreateNewBackupSpecify(const std::string& dir, int index);
 
+  // Like CreateNewBackup but the sst files are not put in dir, they are read
+  // from the db dirs and kept there until ReleaseFiles. table_files is filled
+  // with index -> paths of the sst files.
+  Status CreateNewStreamingBackup(const std::string& dir, std::map<int, std::vector<std::string>>* table_files);
+
+  void ReleaseFiles();
+
  private:
   BackupEngine() = default;
 
   std::map<int, std::unique_ptr<rocksdb::DBCheckpoint>> engines_;
   std::map<int, BackupContent> backup_content_;
   std::map<int, pthread_t> backup_pthread_ts_;
+  // instances whose file deletions are disabled until ReleaseFiles
+  std::set<int> pinned_;
 
   Status NewCheckpoint(rocksdb::DB* rocksdb_db, int index);
   std::string GetSaveDirByIndex(const std::string& _dir, int index) const {
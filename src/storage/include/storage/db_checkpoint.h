@@ -36,6 +36,16 @@ class DBCheckpoint {
                                            VectorLogPtr& live_wal_files, uint64_t manifest_file_size,
                                            uint64_t sequence_number) = 0;
 
+  // Like CreateCheckpointWithFiles but the table files are not linked or
+  // copied, their paths in the db dir are returned in table_files instead.
+  // File deletions, disabled by GetCheckpointFiles, stay so until ReleaseFiles
+  // whether it succeeds or not.
+  virtual Status CreateCheckpointWithoutTables(const std::string& checkpoint_dir, std::vector<std::string>& live_files,
+                                               VectorLogPtr& live_wal_files, uint64_t manifest_file_size,
+                                               uint64_t sequence_number, std::vector<std::string>* table_files) = 0;
+
+  virtual Status ReleaseFiles() = 0;
+
   virtual ~DBCheckpoint() = default;
 };
 
@@ -21,6 +21,7 @@
 #include "rocksdb/slice.h"
 #include "rocksdb/status.h"
 #include "rocksdb/table.h"
+#include "rocksdb/write_batch.h"
 
 #include "slot_indexer.h"
 #include "pstd/include/pstd_mutex.h"
@@ -179,6 +180,35 @@ struct BGTask {
       : type(_type), operation(_opeation), argv(_argv) {}
 };
 
+/*
+ * While a WriteGroup is alive, the writes its thread makes through any Storage
+ * are collected into one WriteBatch per rocksdb instance, Commit then writes
+ * each of them at once. Writes in the group are not visible to reads before
+ * Commit, so the grouped operations must not touch the same keys.
+ */
+class WriteGroup {
+ public:
+  WriteGroup();
+  // drops what was not committed
+  ~WriteGroup();
+  WriteGroup(const WriteGroup&) = delete;
+  WriteGroup& operator=(const WriteGroup&) = delete;
+
+  Status Commit();
+  // number of operations waiting for Commit
+  uint64_t Count() const { return count_; }
+
+  // the group of the calling thread, nullptr if there is none
+  static WriteGroup* Current();
+
+ private:
+  friend class Redis;
+  rocksdb::WriteBatch* GetBatch(Redis* inst);
+
+  std::vector<std::pair<Redis*, rocksdb::WriteBatch>> batches_;
+  uint64_t count_ = 0;
+};
+
 class Storage {
  public:
   Storage(); // for unit test only
@@ -15,6 +15,7 @@ BackupEngine::~BackupEngine() {
   // Wait all children threads
   StopBackup();
   WaitBackupPthread();
+  ReleaseFiles();
 }
 
 Status BackupEngine::NewCheckpoint(rocksdb::DB* rocksdb_db, int index) {
@@ -141,6 +142,44 @@ Status BackupEngine::CreateNewBackup(const std::string& dir) {
   return s;
 }
 
+Status BackupEngine::CreateNewStreamingBackup(const std::string& dir,
+                                              std::map<int, std::vector<std::string>>* table_files) {
+  Status s;
+  // SetBackupContent disabled the file deletions of every instance
+  for (const auto& content : backup_content_) {
+    pinned_.insert(content.first);
+  }
+  for (auto& content : backup_content_) {
+    auto it_engine = engines_.find(content.first);
+    if (it_engine == engines_.end()) {
+      s = Status::Corruption("Invalid db index");
+      break;
+    }
+    std::string save_dir = GetSaveDirByIndex(dir, content.first);
+    delete_dir(save_dir.c_str());
+    s = it_engine->second->CreateCheckpointWithoutTables(
+        save_dir, content.second.live_files, content.second.live_wal_files, content.second.manifest_file_size,
+        content.second.sequence_number, &(*table_files)[content.first]);
+    if (!s.ok()) {
+      break;
+    }
+  }
+  if (!s.ok()) {
+    ReleaseFiles();
+  }
+  return s;
+}
+
+void BackupEngine::ReleaseFiles() {
+  for (int index : pinned_) {
+    auto it_engine = engines_.find(index);
+    if (it_engine != engines_.end()) {
+      it_engine->second->ReleaseFiles();
+    }
+  }
+  pinned_.clear();
+}
+
 void BackupEngine::StopBackup() {
   // DEPRECATED
 }
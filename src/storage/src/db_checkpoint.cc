@@ -48,7 +48,19 @@ class DBCheckpointImpl : public DBCheckpoint {
                                    VectorLogPtr& live_wal_files, uint64_t manifest_file_size,
                                    uint64_t sequence_number) override;
 
+  using DBCheckpoint::CreateCheckpointWithoutTables;
+  Status CreateCheckpointWithoutTables(const std::string& checkpoint_dir, std::vector<std::string>& live_files,
+                                       VectorLogPtr& live_wal_files, uint64_t manifest_file_size,
+                                       uint64_t sequence_number, std::vector<std::string>* table_files) override;
+
+  Status ReleaseFiles() override { return db_->EnableFileDeletions(false); }
+
  private:
+  // table_files is nullptr to link or copy the table files
+  Status CreateCheckpointInternal(const std::string& checkpoint_dir, std::vector<std::string>& live_files,
+                                  VectorLogPtr& live_wal_files, uint64_t manifest_file_size,
+                                  uint64_t sequence_number, std::vector<std::string>* table_files);
+
   DB* db_;
 };
 
@@ -98,6 +110,24 @@ Status DBCheckpointImpl::GetCheckpointFiles(std::vector<std::string>& live_files
 Status DBCheckpointImpl::CreateCheckpointWithFiles(const std::string& checkpoint_dir,
                                                    std::vector<std::string>& live_files, VectorLogPtr& live_wal_files,
                                                    uint64_t manifest_file_size, uint64_t sequence_number) {
+  return CreateCheckpointInternal(checkpoint_dir, live_files, live_wal_files, manifest_file_size, sequence_number,
+                                  nullptr);
+}
+
+Status DBCheckpointImpl::CreateCheckpointWithoutTables(const std::string& checkpoint_dir,
+                                                       std::vector<std::string>& live_files,
+                                                       VectorLogPtr& live_wal_files, uint64_t manifest_file_size,
+                                                       uint64_t sequence_number,
+                                                       std::vector<std::string>* table_files) {
+  table_files->clear();
+  return CreateCheckpointInternal(checkpoint_dir, live_files, live_wal_files, manifest_file_size, sequence_number,
+                                  table_files);
+}
+
+Status DBCheckpointImpl::CreateCheckpointInternal(const std::string& checkpoint_dir,
+                                                  std::vector<std::string>& live_files, VectorLogPtr& live_wal_files,
+                                                  uint64_t manifest_file_size, uint64_t sequence_number,
+                                                  std::vector<std::string>* table_files) {
   bool same_fs = true;
 
   Status s = db_->GetEnv()->FileExists(checkpoint_dir);
@@ -148,6 +178,10 @@ Status DBCheckpointImpl::CreateCheckpointWithFiles(const std::string& checkpoint
       manifest_fname = live_files[i];
     }
     std::string src_fname = live_files[i];
+    if (type == kTableFile && table_files) {
+      table_files->push_back(db_->GetName() + src_fname);
+      continue;
+    }
 
     // rules:
     // * if it's kTableFile, then it's shared
@@ -222,8 +256,11 @@ Status DBCheckpointImpl::CreateCheckpointWithFiles(const std::string& checkpoint
     }
   }
 
-  // we copied all the files, enable file deletions
-  db_->EnableFileDeletions(false);
+  // we copied all the files, enable file deletions, unless the table files
+  // are read from the db dir, then the caller does it by ReleaseFiles
+  if (!table_files) {
+    db_->EnableFileDeletions(false);
+  }
 
   if (s.ok()) {
     // move tmp private backup to real snapshot directory
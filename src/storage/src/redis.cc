@@ -3,6 +3,7 @@
 //  LICENSE file in the root directory of this source tree. An additional grant
 //  of patent rights can be found in the PATENTS file in the same directory.
 
+#include <cassert>
 #include <sstream>
 
 #include "rocksdb/env.h"
@@ -58,6 +59,131 @@ Redis::~Redis() {
   }
 }
 
+namespace {
+
+thread_local WriteGroup* current_write_group = nullptr;
+
+// replays the batch of an instance into the batch its WriteGroup holds for it
+class WriteGroupAppender : public rocksdb::WriteBatch::Handler {
+ public:
+  WriteGroupAppender(rocksdb::DB* db, const std::vector<rocksdb::ColumnFamilyHandle*>& handles,
+                     rocksdb::WriteBatch* dst)
+      : db_(db), handles_(handles), dst_(dst) {}
+
+  Status PutCF(uint32_t column_family_id, const Slice& key, const Slice& value) override {
+    rocksdb::ColumnFamilyHandle* handle = GetHandle(column_family_id);
+    return handle ? dst_->Put(handle, key, value) : Status::InvalidArgument("unknown column family");
+  }
+  Status DeleteCF(uint32_t column_family_id, const Slice& key) override {
+    rocksdb::ColumnFamilyHandle* handle = GetHandle(column_family_id);
+    return handle ? dst_->Delete(handle, key) : Status::InvalidArgument("unknown column family");
+  }
+  Status SingleDeleteCF(uint32_t column_family_id, const Slice& key) override {
+    rocksdb::ColumnFamilyHandle* handle = GetHandle(column_family_id);
+    return handle ? dst_->SingleDelete(handle, key) : Status::InvalidArgument("unknown column family");
+  }
+  Status DeleteRangeCF(uint32_t column_family_id, const Slice& begin_key, const Slice& end_key) override {
+    rocksdb::ColumnFamilyHandle* handle = GetHandle(column_family_id);
+    return handle ? dst_->DeleteRange(handle, begin_key, end_key) : Status::InvalidArgument("unknown column family");
+  }
+  Status MergeCF(uint32_t column_family_id, const Slice& key, const Slice& value) override {
+    rocksdb::ColumnFamilyHandle* handle = GetHandle(column_family_id);
+    return handle ? dst_->Merge(handle, key, value) : Status::InvalidArgument("unknown column family");
+  }
+  void LogData(const Slice& blob) override { dst_->PutLogData(blob); }
+
+ private:
+  rocksdb::ColumnFamilyHandle* GetHandle(uint32_t column_family_id) {
+    for (auto handle : handles_) {
+      if (handle->GetID() == column_family_id) {
+        return handle;
+      }
+    }
+    return column_family_id == db_->DefaultColumnFamily()->GetID() ? db_->DefaultColumnFamily() : nullptr;
+  }
+
+  rocksdb::DB* db_;
+  const std::vector<rocksdb::ColumnFamilyHandle*>& handles_;
+  rocksdb::WriteBatch* dst_;
+};
+
+}  // namespace
+
+WriteGroup::WriteGroup() {
+  // groups do not nest, an inner one would hide the writes of the outer one
+  assert(current_write_group == nullptr);
+  current_write_group = this;
+}
+
+WriteGroup::~WriteGroup() {
+  if (current_write_group == this) {
+    current_write_group = nullptr;
+  }
+}
+
+WriteGroup* WriteGroup::Current() { return current_write_group; }
+
+rocksdb::WriteBatch* WriteGroup::GetBatch(Redis* inst) {
+  for (auto& [batch_inst, batch] : batches_) {
+    if (batch_inst == inst) {
+      return &batch;
+    }
+  }
+  batches_.emplace_back(inst, rocksdb::WriteBatch());
+  return &batches_.back().second;
+}
+
+Status WriteGroup::Commit() {
+  Status s;
+  for (auto& [inst, batch] : batches_) {
+    if (batch.Count() == 0) {
+      continue;
+    }
+    Status ws = inst->GetDB()->Write(inst->GetDefaultWriteOptions(), &batch);
+    if (!ws.ok() && s.ok()) {
+      s = ws;
+    }
+  }
+  batches_.clear();
+  count_ = 0;
+  return s;
+}
+
+Status Redis::Write(rocksdb::WriteBatch* batch) {
+  WriteGroup* group = WriteGroup::Current();
+  if (group == nullptr) {
+    return db_->Write(default_write_options_, batch);
+  }
+  WriteGroupAppender appender(db_, handles_, group->GetBatch(this));
+  Status s = batch->Iterate(&appender);
+  if (s.ok()) {
+    group->count_ += batch->Count();
+  }
+  return s;
+}
+
+Status Redis::Put(rocksdb::ColumnFamilyHandle* column_family, const Slice& key, const Slice& value) {
+  WriteGroup* group = WriteGroup::Current();
+  if (group == nullptr) {
+    return db_->Put(default_write_options_, column_family, key, value);
+  }
+  ++group->count_;
+  return group->GetBatch(this)->Put(column_family, key, value);
+}
+
+Status Redis::Put(const Slice& key, const Slice& value) { return Put(db_->DefaultColumnFamily(), key, value); }
+
+Status Redis::Delete(rocksdb::ColumnFamilyHandle* column_family, const Slice& key) {
+  WriteGroup* group = WriteGroup::Current();
+  if (group == nullptr) {
+    return db_->Delete(default_write_options_, column_family, key);
+  }
+  ++group->count_;
+  return group->GetBatch(this)->Delete(column_family, key);
+}
+
+Status Redis::Delete(const Slice& key) { return Delete(db_->DefaultColumnFamily(), key); }
+
 Status Redis::Open(const StorageOptions& storage_options, const std::string& db_path) {
   statistics_store_->SetCapacity(storage_options.statistics_max_size);
   small_compaction_threshold_ = storage_options.small_compaction_threshold;
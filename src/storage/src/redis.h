@@ -508,6 +508,14 @@ public:
  inline rocksdb::WriteOptions GetDefaultWriteOptions() const { return default_write_options_; }
 
 private:
+  // all writes of the data types go through these, so that they can be
+  // collected by the WriteGroup of the calling thread
+  Status Write(rocksdb::WriteBatch* batch);
+  Status Put(rocksdb::ColumnFamilyHandle* column_family, const Slice& key, const Slice& value);
+  Status Put(const Slice& key, const Slice& value);
+  Status Delete(rocksdb::ColumnFamilyHandle* column_family, const Slice& key);
+  Status Delete(const Slice& key);
+
   int32_t index_ = 0;
   Storage* const storage_;
   std::shared_ptr<LockMgr> lock_mgr_;
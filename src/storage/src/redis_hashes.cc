@@ -127,7 +127,7 @@ Status Redis::HDel(const Slice& key, const std::vector<std::string>& fields, int
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kHashes, key.ToString(), statistic);
   return s;
 }
@@ -356,7 +356,7 @@ Status Redis::HIncrby(const Slice& key, const Slice& field, int64_t value, int64
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kHashes, key.ToString(), statistic);
   return s;
 }
@@ -448,7 +448,7 @@ Status Redis::HIncrbyfloat(const Slice& key, const Slice& field, const Slice& by
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kHashes, key.ToString(), statistic);
   return s;
 }
@@ -669,7 +669,7 @@ Status Redis::HMSet(const Slice& key, const std::vector<FieldValue>& fvs) {
       batch.Put(handles_[kHashesDataCF], hashes_data_key.Encode(), inter_value.Encode());
     }
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kHashes, key.ToString(), statistic);
   return s;
 }
@@ -744,7 +744,7 @@ Status Redis::HSet(const Slice& key, const Slice& field, const Slice& value, int
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kHashes, key.ToString(), statistic);
   return s;
 }
@@ -809,7 +809,7 @@ Status Redis::HSetnx(const Slice& key, const Slice& field, const Slice& value, i
   } else {
     return s;
   }
-  return db_->Write(default_write_options_, &batch);
+  return Write(&batch);
 }
 
 Status Redis::HVals(const Slice& key, std::vector<std::string>* values) {
@@ -1186,10 +1186,10 @@ Status Redis::HashesExpire(const Slice& key, int64_t ttl_millsec, std::string&&
 
     if (ttl_millsec > 0) {
       parsed_hashes_meta_value.SetRelativeTimestamp(ttl_millsec);
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     } else {
       parsed_hashes_meta_value.InitialMetaValue();
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     }
   }
   return s;
@@ -1225,7 +1225,7 @@ Status Redis::HashesDel(const Slice& key, std::string&& prefetch_meta) {
     } else {
       uint32_t statistic = parsed_hashes_meta_value.Count();
       parsed_hashes_meta_value.InitialMetaValue();
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       UpdateSpecificKeyStatistics(DataType::kHashes, key.ToString(), statistic);
     }
   }
@@ -1265,7 +1265,7 @@ Status Redis::HashesExpireat(const Slice& key, int64_t timestamp_millsec, std::s
       } else {
         parsed_hashes_meta_value.InitialMetaValue();
       }
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     }
   }
   return s;
@@ -1304,7 +1304,7 @@ Status Redis::HashesPersist(const Slice& key, std::string&& prefetch_meta) {
         return Status::NotFound("Not have an associated timeout");
       } else {
         parsed_hashes_meta_value.SetEtime(0);
-        s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+        s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       }
     }
   }
@@ -167,7 +167,7 @@ Status Redis::HyperloglogSet(const Slice &key, const Slice &value) {
     ScopeRecordLock l(lock_mgr_, key);
 
     BaseKey base_key(key);
-    return db_->Put(default_write_options_, base_key.Encode(), hyperloglog_value.Encode());
+    return Put(base_key.Encode(), hyperloglog_value.Encode());
 }
 
 }  // namespace storage
\ No newline at end of file
@@ -207,7 +207,7 @@ Status Redis::LInsert(const Slice& key, const BeforeOrAfter& before_or_after, co
         BaseDataValue i_val(value);
         batch.Put(handles_[kListsDataCF], lists_target_key.Encode(), i_val.Encode());
         *ret = static_cast<int32_t>(parsed_lists_meta_value.Count());
-        return db_->Write(default_write_options_, &batch);
+        return Write(&batch);
       }
     }
   } else if (s.IsNotFound()) {
@@ -300,7 +300,7 @@ Status Redis::LPop(const Slice& key, int64_t count, std::vector<std::string>* el
     }
   }
   if (batch.Count() != 0U) {
-    s = db_->Write(default_write_options_, &batch);
+    s = Write(&batch);
     if (s.ok()) {
       batch.Clear();
     }
@@ -364,7 +364,7 @@ Status Redis::LPush(const Slice& key, const std::vector<std::string>& values, ui
   } else {
     return s;
   }
-  return db_->Write(default_write_options_, &batch);
+  return Write(&batch);
 }
 
 Status Redis::LPushx(const Slice& key, const std::vector<std::string>& values, uint64_t* len) {
@@ -404,7 +404,7 @@ Status Redis::LPushx(const Slice& key, const std::vector<std::string>& values, u
       }
       batch.Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       *len = parsed_lists_meta_value.Count();
-      return db_->Write(default_write_options_, &batch);
+      return Write(&batch);
     }
   }
   return s;
@@ -665,7 +665,7 @@ Status Redis::LRem(const Slice& key, int64_t count, const Slice& value, uint64_t
           batch.Delete(handles_[kListsDataCF], lists_data_key.Encode());
         }
         *ret = target_index.size();
-        return db_->Write(default_write_options_, &batch);
+        return Write(&batch);
       }
     }
   } else if (s.IsNotFound()) {
@@ -707,7 +707,7 @@ Status Redis::LSet(const Slice& key, int64_t index, const Slice& value) {
       }
       ListsDataKey lists_data_key(key, version, target_index);
       BaseDataValue i_val(value);
-      s = db_->Put(default_write_options_, handles_[kListsDataCF], lists_data_key.Encode(), i_val.Encode());
+      s = Put(handles_[kListsDataCF], lists_data_key.Encode(), i_val.Encode());
       statistic++;
       UpdateSpecificKeyStatistics(DataType::kLists, key.ToString(), statistic);
       return s;
@@ -782,7 +782,7 @@ Status Redis::LTrim(const Slice& key, int64_t start, int64_t stop) {
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kLists, key.ToString(), statistic);
   return s;
 }
@@ -836,7 +836,7 @@ Status Redis::RPop(const Slice& key, int64_t count, std::vector<std::string>* el
     }
   }
   if (batch.Count() != 0U) {
-    s = db_->Write(default_write_options_, &batch);
+    s = Write(&batch);
     if (s.ok()) {
       batch.Clear();
     }
@@ -892,7 +892,7 @@ Status Redis::RPoplpush(const Slice& source, const Slice& destination, std::stri
             parsed_lists_meta_value.ModifyRightIndex(-1);
             parsed_lists_meta_value.ModifyLeftIndex(1);
             batch.Put(handles_[kMetaCF], base_source.Encode(), meta_value);
-            s = db_->Write(default_write_options_, &batch);
+            s = Write(&batch);
             UpdateSpecificKeyStatistics(DataType::kLists, source.ToString(), statistic);
             return s;
           }
@@ -985,7 +985,7 @@ Status Redis::RPoplpush(const Slice& source, const Slice& destination, std::stri
     return s;
   }
 
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kLists, source.ToString(), statistic);
   if (s.ok()) {
     ParsedBaseDataValue parsed_value(&target);
@@ -1049,7 +1049,7 @@ Status Redis::RPush(const Slice& key, const std::vector<std::string>& values, ui
   } else {
     return s;
   }
-  return db_->Write(default_write_options_, &batch);
+  return Write(&batch);
 }
 
 Status Redis::RPushx(const Slice& key, const std::vector<std::string>& values, uint64_t* len) {
@@ -1089,7 +1089,7 @@ Status Redis::RPushx(const Slice& key, const std::vector<std::string>& values, u
       }
       batch.Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       *len = parsed_lists_meta_value.Count();
-      return db_->Write(default_write_options_, &batch);
+      return Write(&batch);
     }
   }
   return s;
@@ -1126,10 +1126,10 @@ Status Redis::ListsExpire(const Slice& key, int64_t ttl_millsec, std::string&& p
 
     if (ttl_millsec > 0) {
       parsed_lists_meta_value.SetRelativeTimestamp(ttl_millsec);
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     } else {
       parsed_lists_meta_value.InitialMetaValue();
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     }
   }
   return s;
@@ -1165,7 +1165,7 @@ Status Redis::ListsDel(const Slice& key, std::string&& prefetch_meta) {
     } else {
       uint64_t statistic = parsed_lists_meta_value.Count();
       parsed_lists_meta_value.InitialMetaValue();
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       UpdateSpecificKeyStatistics(DataType::kLists, key.ToString(), statistic);
     }
   }
@@ -1205,7 +1205,7 @@ Status Redis::ListsExpireat(const Slice& key, int64_t timestamp_millsec, std::st
       } else {
         parsed_lists_meta_value.InitialMetaValue();
       }
-      return db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      return Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     }
   }
   return s;
@@ -1244,7 +1244,7 @@ Status Redis::ListsPersist(const Slice& key, std::string&& prefetch_meta) {
         return Status::NotFound("Not have an associated timeout");
       } else {
         parsed_lists_meta_value.SetEtime(0);
-        return db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+        return Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       }
     }
   }
@@ -145,7 +145,7 @@ rocksdb::Status Redis::SAdd(const Slice& key, const std::vector<std::string>& me
   } else {
     return s;
   }
-  return db_->Write(default_write_options_, &batch);
+  return Write(&batch);
 }
 
 rocksdb::Status Redis::SCard(const Slice& key, int32_t* ret, std::string&& meta) {
@@ -396,7 +396,7 @@ rocksdb::Status Redis::SDiffstore(const Slice& destination, const std::vector<st
     batch.Put(handles_[kSetsDataCF], sets_member_key.Encode(), iter_value.Encode());
   }
   *ret = static_cast<int32_t>(members.size());
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kSets, destination.ToString(), statistic);
   value_to_dest = std::move(members);
   return s;
@@ -640,7 +640,7 @@ rocksdb::Status Redis::SInterstore(const Slice& destination, const std::vector<s
     batch.Put(handles_[kSetsDataCF], sets_member_key.Encode(), iter_value.Encode());
   }
   *ret = static_cast<int32_t>(members.size());
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kSets, destination.ToString(), statistic);
   value_to_dest = std::move(members);
   return s;
@@ -907,7 +907,7 @@ rocksdb::Status Redis::SMove(const Slice& source, const Slice& destination, cons
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kSets, source.ToString(), 1);
   return s;
 }
@@ -1007,7 +1007,7 @@ rocksdb::Status Redis::SPop(const Slice& key, std::vector<std::string>* members,
   } else {
     return s;
   }
-  return db_->Write(default_write_options_, &batch);
+  return Write(&batch);
 }
 
 rocksdb::Status Redis::ResetSpopCount(const std::string& key) { return spop_counts_store_->Remove(key); }
@@ -1157,7 +1157,7 @@ rocksdb::Status Redis::SRem(const Slice& key, const std::vector<std::string>& me
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kSets, key.ToString(), statistic);
   return s;
 }
@@ -1315,7 +1315,7 @@ rocksdb::Status Redis::SUnionstore(const Slice& destination, const std::vector<s
     batch.Put(handles_[kSetsDataCF], sets_member_key.Encode(), i_val.Encode());
   }
   *ret = static_cast<int32_t>(members.size());
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kSets, destination.ToString(), statistic);
   value_to_dest = std::move(members);
   return s;
@@ -1434,10 +1434,10 @@ rocksdb::Status Redis::SetsExpire(const Slice& key, int64_t ttl_millsec, std::st
 
     if (ttl_millsec > 0) {
       parsed_sets_meta_value.SetRelativeTimestamp(ttl_millsec);
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     } else {
       parsed_sets_meta_value.InitialMetaValue();
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     }
   }
   return s;
@@ -1473,7 +1473,7 @@ rocksdb::Status Redis::SetsDel(const Slice& key, std::string&& prefetch_meta) {
     } else {
       uint32_t statistic = parsed_sets_meta_value.Count();
       parsed_sets_meta_value.InitialMetaValue();
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       UpdateSpecificKeyStatistics(DataType::kSets, key.ToString(), statistic);
     }
   }
@@ -1513,7 +1513,7 @@ rocksdb::Status Redis::SetsExpireat(const Slice& key, int64_t timestamp_millsec,
       } else {
         parsed_sets_meta_value.InitialMetaValue();
       }
-      return db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      return Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     }
   }
   return s;
@@ -1552,7 +1552,7 @@ rocksdb::Status Redis::SetsPersist(const Slice& key, std::string&& prefetch_meta
         return rocksdb::Status::NotFound("Not have an associated timeout");
       } else {
         parsed_sets_meta_value.SetEtime(0);
-        return db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+        return Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       }
     }
   }
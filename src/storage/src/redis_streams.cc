@@ -67,7 +67,7 @@ Status Redis::XAdd(const Slice& key, const std::string& serialized_message, Stre
 #endif
 
   StreamDataKey stream_data_key(key, stream_meta.version(), args.id.Serialize());
-  s = db_->Put(default_write_options_, handles_[kStreamsDataCF], stream_data_key.Encode(), serialized_message);
+  s = Put(handles_[kStreamsDataCF], stream_data_key.Encode(), serialized_message);
   if (!s.ok()) {
     return Status::Corruption("error from XADD, insert stream message failed 1: " + s.ToString());
   }
@@ -91,7 +91,7 @@ Status Redis::XAdd(const Slice& key, const std::string& serialized_message, Stre
 
   // 5 update stream meta
   BaseMetaKey base_meta_key(key);
-  s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), stream_meta.value());
+  s = Put(handles_[kMetaCF], base_meta_key.Encode(), stream_meta.value());
   if (!s.ok()) {
     return s;
   }
@@ -118,7 +118,7 @@ Status Redis::XTrim(const Slice& key, StreamAddTrimArgs& args, int32_t& count) {
 
   // 3 update stream meta
   BaseMetaKey base_meta_key(key);
-  s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), stream_meta.value());
+  s = Put(handles_[kMetaCF], base_meta_key.Encode(), stream_meta.value());
   if (!s.ok()) {
     return s;
   }
@@ -172,7 +172,7 @@ Status Redis::XDel(const Slice& key, const std::vector<streamID>& ids, int32_t&
     }
   }
 
-  return db_->Put(default_write_options_, handles_[kMetaCF], BaseMetaKey(key).Encode(), stream_meta.value());
+  return Put(handles_[kMetaCF], BaseMetaKey(key).Encode(), stream_meta.value());
 }
 
 Status Redis::XRange(const Slice& key, const StreamScanArgs& args, std::vector<IdMessage>& field_values, std::string&& prefetch_meta) {
@@ -385,7 +385,7 @@ Status Redis::StreamsDel(const Slice& key, std::string&& prefetch_meta) {
     } else {
       uint32_t statistic = stream_meta_value.length();
       stream_meta_value.InitMetaValue();
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), stream_meta_value.value());
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), stream_meta_value.value());
       UpdateSpecificKeyStatistics(DataType::kStreams, key.ToString(), statistic);
     }
   }
@@ -757,7 +757,7 @@ Status Redis::DeleteStreamMessages(const rocksdb::Slice& key, const StreamMetaVa
     StreamDataKey stream_data_key(key, stream_meta.version(), sid);
     batch.Delete(handles_[kStreamsDataCF], stream_data_key.Encode());
   }
-  return db_->Write(default_write_options_, &batch);
+  return Write(&batch);
 }
 
 inline Status Redis::SetFirstID(const rocksdb::Slice& key, StreamMetaValue& stream_meta,
@@ -85,7 +85,7 @@ Status Redis::Append(const Slice& key, const Slice& value, int32_t* ret, int64_t
     if (parsed_strings_value.IsStale()) {
       *ret = static_cast<int32_t>(value.size());
       StringsValue strings_value(value);
-      return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+      return Put(base_key.Encode(), strings_value.Encode());
     } else {
       uint64_t timestamp = parsed_strings_value.Etime();
       std::string old_user_value = parsed_strings_value.UserValue().ToString();
@@ -95,13 +95,13 @@ Status Redis::Append(const Slice& key, const Slice& value, int32_t* ret, int64_t
       strings_value.SetEtime(timestamp);
       *ret = static_cast<int32_t>(new_value.size());
       *expired_timestamp_millsec = timestamp;
-      return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+      return Put(base_key.Encode(), strings_value.Encode());
     }
   } else if (s.IsNotFound()) {
     *ret = static_cast<int32_t>(value.size());
     StringsValue strings_value(value);
     *expired_timestamp_millsec = 0;
-    return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+    return Put(base_key.Encode(), strings_value.Encode());
   }
   return s;
 }
@@ -271,7 +271,7 @@ Status Redis::BitOp(BitOpType op, const std::string& dest_key, const std::vector
   StringsValue strings_value(Slice(dest_value.c_str(), max_len));
   ScopeRecordLock l(lock_mgr_, dest_key);
   BaseKey base_dest_key(dest_key);
-  return db_->Put(default_write_options_, base_dest_key.Encode(), strings_value.Encode());
+  return Put(base_dest_key.Encode(), strings_value.Encode());
 }
 
 Status Redis::Decrby(const Slice& key, int64_t value, int64_t* ret) {
@@ -297,7 +297,7 @@ Status Redis::Decrby(const Slice& key, int64_t value, int64_t* ret) {
       *ret = -value;
       new_value = std::to_string(*ret);
       StringsValue strings_value(new_value);
-      return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+      return Put(base_key.Encode(), strings_value.Encode());
     } else {
       uint64_t timestamp = parsed_strings_value.Etime();
       std::string old_user_value = parsed_strings_value.UserValue().ToString();
@@ -314,13 +314,13 @@ Status Redis::Decrby(const Slice& key, int64_t value, int64_t* ret) {
       new_value = std::to_string(*ret);
       StringsValue strings_value(new_value);
       strings_value.SetEtime(timestamp);
-      return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+      return Put(base_key.Encode(), strings_value.Encode());
     }
   } else if (s.IsNotFound()) {
     *ret = -value;
     new_value = std::to_string(*ret);
     StringsValue strings_value(new_value);
-    return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+    return Put(base_key.Encode(), strings_value.Encode());
   } else {
     return s;
   }
@@ -616,7 +616,7 @@ Status Redis::GetSet(const Slice& key, const Slice& value, std::string* old_valu
     return s;
   }
   StringsValue strings_value(value);
-  return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+  return Put(base_key.Encode(), strings_value.Encode());
 }
 
 Status Redis::Incrby(const Slice& key, int64_t value, int64_t* ret, int64_t* expired_timestamp_millsec) {
@@ -641,7 +641,7 @@ Status Redis::Incrby(const Slice& key, int64_t value, int64_t* ret, int64_t* exp
       *ret = value;
       Int64ToStr(buf, 32, value);
       StringsValue strings_value(buf);
-      return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+      return Put(base_key.Encode(), strings_value.Encode());
     } else {
       uint64_t timestamp = parsed_strings_value.Etime();
       std::string old_user_value = parsed_strings_value.UserValue().ToString();
@@ -658,13 +658,13 @@ Status Redis::Incrby(const Slice& key, int64_t value, int64_t* ret, int64_t* exp
       StringsValue strings_value(new_value);
       strings_value.SetEtime(timestamp);
       *expired_timestamp_millsec = timestamp;
-      return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+      return Put(base_key.Encode(), strings_value.Encode());
     }
   } else if (s.IsNotFound()) {
     *ret = value;
     Int64ToStr(buf, 32, value);
     StringsValue strings_value(buf);
-    return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+    return Put(base_key.Encode(), strings_value.Encode());
   } else {
     return s;
   }
@@ -698,7 +698,7 @@ Status Redis::Incrbyfloat(const Slice& key, const Slice& value, std::string* ret
       LongDoubleToStr(long_double_by, &new_value);
       *ret = new_value;
       StringsValue strings_value(new_value);
-      return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+      return Put(base_key.Encode(), strings_value.Encode());
     } else {
       uint64_t timestamp = parsed_strings_value.Etime();
       std::string old_user_value = parsed_strings_value.UserValue().ToString();
@@ -715,13 +715,13 @@ Status Redis::Incrbyfloat(const Slice& key, const Slice& value, std::string* ret
       StringsValue strings_value(new_value);
       strings_value.SetEtime(timestamp);
       *expired_timestamp_sec = timestamp;
-      return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+      return Put(base_key.Encode(), strings_value.Encode());
     }
   } else if (s.IsNotFound()) {
     LongDoubleToStr(long_double_by, &new_value);
     *ret = new_value;
     StringsValue strings_value(new_value);
-    return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+    return Put(base_key.Encode(), strings_value.Encode());
   } else {
     return s;
   }
@@ -741,7 +741,7 @@ Status Redis::MSet(const std::vector<KeyValue>& kvs) {
     StringsValue strings_value(kv.value);
     batch.Put(base_key.Encode(), strings_value.Encode());
   }
-  return db_->Write(default_write_options_, &batch);
+  return Write(&batch);
 }
 
 Status Redis::MSetnx(const std::vector<KeyValue>& kvs, int32_t* ret) {
@@ -775,7 +775,7 @@ Status Redis::Set(const Slice& key, const Slice& value) {
   ScopeRecordLock l(lock_mgr_, key);
 
   BaseKey base_key(key);
-  return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+  return Put(base_key.Encode(), strings_value.Encode());
 }
 
 Status Redis::Setxx(const Slice& key, const Slice& value, int32_t* ret, int64_t ttl_millsec) {
@@ -813,7 +813,7 @@ Status Redis::Setxx(const Slice& key, const Slice& value, int32_t* ret, int64_t
     if (ttl_millsec > 0) {
       strings_value.SetRelativeTimeInMillsec(ttl_millsec);
     }
-    return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+    return Put(base_key.Encode(), strings_value.Encode());
   }
 }
 
@@ -870,7 +870,7 @@ Status Redis::SetBit(const Slice& key, int64_t offset, int32_t on, int32_t* ret)
     }
     StringsValue strings_value(data_value);
     strings_value.SetEtime(timestamp);
-    return db_->Put(rocksdb::WriteOptions(), base_key.Encode(), strings_value.Encode());
+    return Put(base_key.Encode(), strings_value.Encode());
   } else {
     return s;
   }
@@ -888,7 +888,7 @@ Status Redis::Setex(const Slice& key, const Slice& value, int64_t ttl_millsec) {
 
   BaseKey base_key(key);
   ScopeRecordLock l(lock_mgr_, key);
-  return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+  return Put(base_key.Encode(), strings_value.Encode());
 }
 
 Status Redis::Setnx(const Slice& key, const Slice& value, int32_t* ret, int64_t ttl_millsec) {
@@ -911,7 +911,7 @@ Status Redis::Setnx(const Slice& key, const Slice& value, int32_t* ret, int64_t
   if (ttl_millsec > 0) {
     strings_value.SetRelativeTimeInMillsec(ttl_millsec);
   }
-  s = db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+  s = Put(base_key.Encode(), strings_value.Encode());
   if (s.ok()) {
     *ret = 1;
   }
@@ -946,7 +946,7 @@ Status Redis::Setvx(const Slice& key, const Slice& value, const Slice& new_value
         if (ttl_millsec > 0) {
           strings_value.SetRelativeTimeInMillsec(ttl_millsec);
         }
-        s = db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+        s = Put(base_key.Encode(), strings_value.Encode());
         if (!s.ok()) {
           return s;
         }
@@ -988,7 +988,7 @@ Status Redis::Delvx(const Slice& key, const Slice& value, int32_t* ret) {
     } else {
       if (value.compare(parsed_strings_value.UserValue()) == 0) {
         *ret = 1;
-        return db_->Delete(default_write_options_, base_key.Encode());
+        return Delete(base_key.Encode());
       } else {
         *ret = -1;
       }
@@ -1044,13 +1044,13 @@ Status Redis::Setrange(const Slice& key, int64_t start_offset, const Slice& valu
     *ret = static_cast<int32_t>(new_value.length());
     StringsValue strings_value(new_value);
     strings_value.SetEtime(timestamp);
-    return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+    return Put(base_key.Encode(), strings_value.Encode());
   } else if (s.IsNotFound()) {
     std::string tmp(start_offset, '\0');
     new_value = tmp.append(value.data());
     *ret = static_cast<int32_t>(new_value.length());
     StringsValue strings_value(new_value);
-    return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+    return Put(base_key.Encode(), strings_value.Encode());
   }
   return s;
 }
@@ -1297,7 +1297,7 @@ Status Redis::PKSetexAt(const Slice& key, const Slice& value, int64_t time_stamp
   BaseKey base_key(key);
   ScopeRecordLock l(lock_mgr_, key);
   strings_value.SetEtime(uint64_t(time_stamp_millsec_));
-  return db_->Put(default_write_options_, base_key.Encode(), strings_value.Encode());
+  return Put(base_key.Encode(), strings_value.Encode());
 }
 
 Status Redis::StringsExpire(const Slice& key, int64_t ttl_millsec, std::string&& prefetch_meta) {
@@ -1328,9 +1328,9 @@ Status Redis::StringsExpire(const Slice& key, int64_t ttl_millsec, std::string&&
     }
     if (ttl_millsec > 0) {
       parsed_strings_value.SetRelativeTimestamp(ttl_millsec);
-      return db_->Put(default_write_options_, base_key.Encode(), value);
+      return Put(base_key.Encode(), value);
     } else {
-      return db_->Delete(default_write_options_, base_key.Encode());
+      return Delete(base_key.Encode());
     }
   }
   return s;
@@ -1362,7 +1362,7 @@ Status Redis::StringsDel(const Slice& key, std::string&& prefetch_meta) {
     if (parsed_strings_value.IsStale()) {
       return Status::NotFound("Stale");
     }
-    return db_->Delete(default_write_options_, base_key.Encode());
+    return Delete(base_key.Encode());
   }
   return s;
 }
@@ -1395,9 +1395,9 @@ Status Redis::StringsExpireat(const Slice& key, int64_t timestamp_millsec, std::
     } else {
       if (timestamp_millsec > 0) {
         parsed_strings_value.SetEtime(static_cast<uint64_t>(timestamp_millsec));
-        return db_->Put(default_write_options_, base_key.Encode(), value);
+        return Put(base_key.Encode(), value);
       } else {
-        return db_->Delete(default_write_options_, base_key.Encode());
+        return Delete(base_key.Encode());
       }
     }
   }
@@ -1435,7 +1435,7 @@ Status Redis::StringsPersist(const Slice& key, std::string&& prefetch_meta) {
         return Status::NotFound("Not have an associated timeout");
       } else {
         parsed_strings_value.SetEtime(0);
-        return db_->Put(default_write_options_, base_key.Encode(), value);
+        return Put(base_key.Encode(), value);
       }
     }
   }
@@ -1750,7 +1750,7 @@ rocksdb::Status Redis::PKPatternMatchDelWithRemoveKeys(const std::string& patter
     iter->Next();
   }
   if (batch.Count() != 0U) {
-    s = db_->Write(default_write_options_, &batch);
+    s = Write(&batch);
     if (s.ok()) {
       total_delete += static_cast<int64_t>(batch.Count());
       batch.Clear();
@@ -112,7 +112,7 @@ Status Redis::ZPopMax(const Slice& key, const int64_t count, std::vector<ScoreMe
       }
       parsed_zsets_meta_value.ModifyCount(-del_cnt);
       batch.Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
-      s = db_->Write(default_write_options_, &batch);
+      s = Write(&batch);
       UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
       return s;
     }
@@ -170,7 +170,7 @@ Status Redis::ZPopMin(const Slice& key, const int64_t count, std::vector<ScoreMe
       }
       parsed_zsets_meta_value.ModifyCount(-del_cnt);
       batch.Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
-      s = db_->Write(default_write_options_, &batch);
+      s = Write(&batch);
       UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
       return s;
     }
@@ -287,7 +287,7 @@ Status Redis::ZAdd(const Slice& key, const std::vector<ScoreMember>& score_membe
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
   return s;
 }
@@ -471,7 +471,7 @@ Status Redis::ZIncrby(const Slice& key, const Slice& member, double increment, d
   BaseDataValue zsets_score_i_val(Slice{});
   batch.Put(handles_[kZsetsScoreCF], zsets_score_key.Encode(), zsets_score_i_val.Encode());
   *ret = score;
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
   return s;
 }
@@ -804,7 +804,7 @@ Status Redis::ZRem(const Slice& key, const std::vector<std::string>& members, in
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
   return s;
 }
@@ -871,7 +871,7 @@ Status Redis::ZRemrangebyrank(const Slice& key, int32_t start, int32_t stop, int
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
   return s;
 }
@@ -951,7 +951,7 @@ Status Redis::ZRemrangebyscore(const Slice& key, double min, double max, bool le
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
   return s;
 }
@@ -1353,7 +1353,7 @@ Status Redis::ZUnionstore(const Slice& destination, const std::vector<std::strin
     batch.Put(handles_[kZsetsScoreCF], zsets_score_key.Encode(), score_i_val.Encode());
   }
   *ret = static_cast<int32_t>(member_score_map.size());
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kZSets, destination.ToString(), statistic);
   value_to_dest = std::move(member_score_map);
   return s;
@@ -1508,7 +1508,7 @@ Status Redis::ZInterstore(const Slice& destination, const std::vector<std::strin
     batch.Put(handles_[kZsetsScoreCF], zsets_score_key.Encode(), zsets_score_i_val.Encode());
   }
   *ret = static_cast<int32_t>(final_score_members.size());
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kZSets, destination.ToString(), statistic);
   value_to_dest = std::move(final_score_members);
   return s;
@@ -1664,7 +1664,7 @@ Status Redis::ZRemrangebylex(const Slice& key, const Slice& min, const Slice& ma
   } else {
     return s;
   }
-  s = db_->Write(default_write_options_, &batch);
+  s = Write(&batch);
   UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
   return s;
 }
@@ -1703,7 +1703,7 @@ Status Redis::ZsetsExpire(const Slice& key, int64_t ttl_millsec, std::string&& p
     } else {
       parsed_zsets_meta_value.InitialMetaValue();
     }
-    s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+    s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
   }
   return s;
 }
@@ -1738,7 +1738,7 @@ Status Redis::ZsetsDel(const Slice& key, std::string&& prefetch_meta) {
     } else {
       uint32_t statistic = parsed_zsets_meta_value.Count();
       parsed_zsets_meta_value.InitialMetaValue();
-      s = db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      s = Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       UpdateSpecificKeyStatistics(DataType::kZSets, key.ToString(), statistic);
     }
   }
@@ -1778,7 +1778,7 @@ Status Redis::ZsetsExpireat(const Slice& key, int64_t timestamp_millsec, std::st
       } else {
         parsed_zsets_meta_value.InitialMetaValue();
       }
-      return db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+      return Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
     }
   }
   return s;
@@ -1903,7 +1903,7 @@ Status Redis::ZsetsPersist(const Slice& key, std::string&& prefetch_meta) {
         return Status::NotFound("Not have an associated timeout");
       } else {
         parsed_zsets_meta_value.SetEtime(0);
-        return db_->Put(default_write_options_, handles_[kMetaCF], base_meta_key.Encode(), meta_value);
+        return Put(handles_[kMetaCF], base_meta_key.Encode(), meta_value);
       }
     }
   }
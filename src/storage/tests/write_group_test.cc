@@ -0,0 +1,156 @@
+//  Copyright (c) 2017-present, Qihoo, Inc.  All rights reserved.
+//  This source code is licensed under the BSD-style license found in the
+//  LICENSE file in the root directory of this source tree. An additional grant
+//  of patent rights can be found in the PATENTS file in the same directory.
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include <thread>
+
+#include "glog/logging.h"
+
+#include "pstd/include/env.h"
+#include "storage/storage.h"
+#include "storage/util.h"
+
+using storage::Slice;
+using storage::Status;
+
+class WriteGroupTest : public ::testing::Test {
+ public:
+  WriteGroupTest() = default;
+  ~WriteGroupTest() override = default;
+
+  void SetUp() override {
+    std::string path = "./db/write_group";
+    pstd::DeleteDirIfExist(path);
+    mkdir(path.c_str(), 0755);
+    storage_options.options.create_if_missing = true;
+    s = db.Open(storage_options, path);
+  }
+
+  void TearDown() override {
+    std::string path = "./db/write_group";
+    storage::DeleteFiles(path.c_str());
+  }
+
+  static void SetUpTestSuite() {}
+  static void TearDownTestSuite() {}
+
+  storage::StorageOptions storage_options;
+  storage::Storage db;
+  storage::Status s;
+};
+
+// Writes are invisible until Commit, then all of them show up
+TEST_F(WriteGroupTest, CommitTest) {
+  int32_t ret = 0;
+  uint64_t len = 0;
+  std::string value;
+  {
+    storage::WriteGroup group;
+    ASSERT_EQ(storage::WriteGroup::Current(), &group);
+
+    s = db.Set("WRITE_GROUP_KEY", "WRITE_GROUP_VALUE");
+    ASSERT_TRUE(s.ok());
+    s = db.HSet("WRITE_GROUP_HASH", "FIELD", "VALUE", &ret);
+    ASSERT_TRUE(s.ok());
+    s = db.SAdd("WRITE_GROUP_SET", {"MEMBER1", "MEMBER2"}, &ret);
+    ASSERT_TRUE(s.ok());
+    s = db.LPush("WRITE_GROUP_LIST", {"NODE1", "NODE2"}, &len);
+    ASSERT_TRUE(s.ok());
+    ASSERT_GT(group.Count(), 0);
+
+    s = db.Get("WRITE_GROUP_KEY", &value);
+    ASSERT_TRUE(s.IsNotFound());
+    s = db.HGet("WRITE_GROUP_HASH", "FIELD", &value);
+    ASSERT_TRUE(s.IsNotFound());
+
+    s = group.Commit();
+    ASSERT_TRUE(s.ok());
+    ASSERT_EQ(group.Count(), 0);
+  }
+  ASSERT_EQ(storage::WriteGroup::Current(), nullptr);
+
+  s = db.Get("WRITE_GROUP_KEY", &value);
+  ASSERT_TRUE(s.ok());
+  ASSERT_EQ(value, "WRITE_GROUP_VALUE");
+  s = db.HGet("WRITE_GROUP_HASH", "FIELD", &value);
+  ASSERT_TRUE(s.ok());
+  ASSERT_EQ(value, "VALUE");
+  int32_t card = 0;
+  s = db.SCard("WRITE_GROUP_SET", &card);
+  ASSERT_TRUE(s.ok());
+  ASSERT_EQ(card, 2);
+  s = db.LLen("WRITE_GROUP_LIST", &len);
+  ASSERT_TRUE(s.ok());
+  ASSERT_EQ(len, 2);
+}
+
+// Every strings write goes through the group, SetBit included
+TEST_F(WriteGroupTest, SetBitTest) {
+  int32_t ret = 0;
+  std::string value;
+  {
+    storage::WriteGroup group;
+    s = db.SetBit("WRITE_GROUP_BIT_KEY", 7, 1, &ret);
+    ASSERT_TRUE(s.ok());
+    ASSERT_EQ(group.Count(), 1);
+
+    s = db.Get("WRITE_GROUP_BIT_KEY", &value);
+    ASSERT_TRUE(s.IsNotFound());
+
+    s = group.Commit();
+    ASSERT_TRUE(s.ok());
+  }
+  s = db.GetBit("WRITE_GROUP_BIT_KEY", 7, &ret);
+  ASSERT_TRUE(s.ok());
+  ASSERT_EQ(ret, 1);
+}
+
+// A group dropped without Commit writes nothing
+TEST_F(WriteGroupTest, DropTest) {
+  std::string value;
+  {
+    storage::WriteGroup group;
+    s = db.Set("WRITE_GROUP_DROP_KEY", "VALUE");
+    ASSERT_TRUE(s.ok());
+  }
+  s = db.Get("WRITE_GROUP_DROP_KEY", &value);
+  ASSERT_TRUE(s.IsNotFound());
+
+  // without a group writes go straight to db
+  s = db.Set("WRITE_GROUP_DROP_KEY", "VALUE");
+  ASSERT_TRUE(s.ok());
+  s = db.Get("WRITE_GROUP_DROP_KEY", &value);
+  ASSERT_TRUE(s.ok());
+  ASSERT_EQ(value, "VALUE");
+}
+
+// Each thread has its own group
+TEST_F(WriteGroupTest, ThreadTest) {
+  std::string value;
+  storage::WriteGroup group;
+  std::thread writer([this] {
+    ASSERT_EQ(storage::WriteGroup::Current(), nullptr);
+    Status ws = db.Set("WRITE_GROUP_THREAD_KEY", "VALUE");
+    ASSERT_TRUE(ws.ok());
+  });
+  writer.join();
+  s = db.Get("WRITE_GROUP_THREAD_KEY", &value);
+  ASSERT_TRUE(s.ok());
+  ASSERT_EQ(value, "VALUE");
+}
+
+int main(int argc, char** argv) {
+  if (!pstd::FileExists("./log")) {
+    pstd::CreatePath("./log");
+  }
+  FLAGS_log_dir = "./log";
+  FLAGS_minloglevel = 0;
+  FLAGS_max_log_size = 1800;
+  FLAGS_logbufsecs = 0;
+  ::google::InitGoogleLogging("write_group_test");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "include/pika_admission_controller.h"
+
+namespace {
+
+constexpr uint64_t kTargetUs = 1000;
+
+// long enough for the controller to judge a new interval
+void NextInterval() { std::this_thread::sleep_for(std::chrono::milliseconds(110)); }
+
+}  // namespace
+
+TEST(AdmissionControllerTest, TargetZeroAdmitsAll) {
+  PikaAdmissionController controller;
+  PikaAdmissionController::ConnState conn;
+  controller.Observe(PikaAdmissionController::kFastPool, 1000000, 0);
+  ASSERT_FALSE(controller.Overloaded(PikaAdmissionController::kFastPool));
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(controller.Admit(PikaAdmissionController::kFastPool, 100, 0, &conn));
+    ASSERT_TRUE(controller.Admit(PikaAdmissionController::kSlowPool, 100, 0, &conn));
+  }
+  ASSERT_EQ(controller.RejectedCmds(), 0);
+}
+
+TEST(AdmissionControllerTest, OverloadedWhenShortestWaitAboveTarget) {
+  PikaAdmissionController controller;
+  controller.Observe(PikaAdmissionController::kFastPool, kTargetUs + 1, kTargetUs);
+  ASSERT_TRUE(controller.Overloaded(PikaAdmissionController::kFastPool));
+  ASSERT_FALSE(controller.Overloaded(PikaAdmissionController::kSlowPool));
+
+  // one short wait in the interval is enough to clear it
+  controller.Observe(PikaAdmissionController::kFastPool, kTargetUs * 10, kTargetUs);
+  controller.Observe(PikaAdmissionController::kFastPool, kTargetUs / 2, kTargetUs);
+  NextInterval();
+  controller.Observe(PikaAdmissionController::kFastPool, kTargetUs * 10, kTargetUs);
+  ASSERT_FALSE(controller.Overloaded(PikaAdmissionController::kFastPool));
+
+  // an interval with no short wait sets it again
+  NextInterval();
+  controller.Observe(PikaAdmissionController::kFastPool, kTargetUs * 10, kTargetUs);
+  ASSERT_TRUE(controller.Overloaded(PikaAdmissionController::kFastPool));
+  ASSERT_EQ(controller.RejectedCmds(), 0);
+}
+
+TEST(AdmissionControllerTest, OverloadedSlowPoolRejectsAll) {
+  PikaAdmissionController controller;
+  PikaAdmissionController::ConnState conn;
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kSlowPool, 1, kTargetUs, &conn));
+  controller.Observe(PikaAdmissionController::kSlowPool, kTargetUs * 2, kTargetUs);
+  ASSERT_TRUE(controller.Overloaded(PikaAdmissionController::kSlowPool));
+  ASSERT_FALSE(controller.Admit(PikaAdmissionController::kSlowPool, 3, kTargetUs, &conn));
+  ASSERT_EQ(controller.RejectedCmds(), 3);
+  // the fast pool is not affected
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kFastPool, 1, kTargetUs, &conn));
+  // nor the admin pool
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kPoolNum, 1, kTargetUs, &conn));
+}
+
+TEST(AdmissionControllerTest, OverloadedPoolRecoversWithoutObserve) {
+  PikaAdmissionController controller;
+  PikaAdmissionController::ConnState conn;
+  controller.Observe(PikaAdmissionController::kSlowPool, kTargetUs * 2, kTargetUs);
+  ASSERT_TRUE(controller.Overloaded(PikaAdmissionController::kSlowPool));
+  ASSERT_FALSE(controller.Admit(PikaAdmissionController::kSlowPool, 1, kTargetUs, &conn));
+
+  // nothing left the queue in the interval, so it was not overloaded
+  NextInterval();
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kSlowPool, 1, kTargetUs, &conn));
+  ASSERT_FALSE(controller.Overloaded(PikaAdmissionController::kSlowPool));
+  ASSERT_EQ(controller.RejectedCmds(), 1);
+}
+
+TEST(AdmissionControllerTest, OverloadedFastPoolKeepsFairShare) {
+  PikaAdmissionController controller;
+  PikaAdmissionController::ConnState busy;
+  PikaAdmissionController::ConnState quiet;
+  controller.Observe(PikaAdmissionController::kFastPool, kTargetUs * 2, kTargetUs);
+  ASSERT_TRUE(controller.Overloaded(PikaAdmissionController::kFastPool));
+
+  // the first commands of each conn in an interval get in
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kFastPool, 10, kTargetUs, &busy));
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kFastPool, 1, kTargetUs, &quiet));
+  // busy got 10 of the 11 admitted over 2 conns, above its share
+  ASSERT_FALSE(controller.Admit(PikaAdmissionController::kFastPool, 10, kTargetUs, &busy));
+  ASSERT_EQ(controller.RejectedCmds(), 10);
+  // quiet is still below it
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kFastPool, 1, kTargetUs, &quiet));
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kFastPool, 1, kTargetUs, &quiet));
+
+  // a new interval starts the counts over
+  NextInterval();
+  controller.Observe(PikaAdmissionController::kFastPool, kTargetUs * 2, kTargetUs);
+  ASSERT_TRUE(controller.Overloaded(PikaAdmissionController::kFastPool));
+  ASSERT_TRUE(controller.Admit(PikaAdmissionController::kFastPool, 10, kTargetUs, &busy));
+  ASSERT_EQ(controller.RejectedCmds(), 10);
+}
+
+TEST(AdmissionControllerTest, RejectCounts) {
+  PikaAdmissionController controller;
+  ASSERT_FALSE(controller.Reject(4));
+  ASSERT_FALSE(controller.Reject(0));
+  ASSERT_EQ(controller.RejectedCmds(), 4);
+}
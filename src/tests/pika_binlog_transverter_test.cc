@@ -0,0 +1,129 @@
+// Copyright (c) 2015-present, Qihoo, Inc.  All rights reserved.
+// This source code is licensed under the BSD-style license found in the
+// LICENSE file in the root directory of this source tree. An additional grant
+// of patent rights can be found in the PATENTS file in the same directory.
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/pika_binlog_transverter.h"
+
+namespace {
+
+std::string ToRedisProtocol(const std::vector<std::string>& argv) {
+  std::string protocol = "*" + std::to_string(argv.size()) + "\r\n";
+  for (const auto& arg : argv) {
+    protocol.append("$" + std::to_string(arg.size()) + "\r\n" + arg + "\r\n");
+  }
+  return protocol;
+}
+
+bool Decode(const std::string& content, std::vector<std::string>* argv) {
+  return PikaBinlogTransverter::CompactContentDecode(content.data(), content.size(), argv);
+}
+
+}  // namespace
+
+TEST(CompactBinlogTest, RoundTrip) {
+  const std::vector<std::vector<std::string>> commands = {
+      {"ping"},
+      {"set", "key", "value"},
+      {"set", "", ""},
+      {"hset", "hash", "field", std::string("va\0\r\nlue", 8)},
+      {"set", "big", std::string(1 << 16, 'x')},
+  };
+  for (const auto& argv : commands) {
+    std::string content;
+    ASSERT_TRUE(PikaBinlogTransverter::RedisProtocolToCompactContent(ToRedisProtocol(argv), &content));
+    ASSERT_EQ(static_cast<uint8_t>(content[0]), BINLOG_COMPACT_VERSION);
+    std::vector<std::string> decoded = {"stale"};
+    ASSERT_TRUE(Decode(content, &decoded));
+    ASSERT_EQ(decoded, argv);
+  }
+}
+
+TEST(CompactBinlogTest, RoundTripThroughBinlogItem) {
+  std::string content;
+  std::vector<std::string> argv = {"set", "key", "value"};
+  ASSERT_TRUE(PikaBinlogTransverter::RedisProtocolToCompactContent(ToRedisProtocol(argv), &content));
+  std::string binlog = PikaBinlogTransverter::BinlogEncode(TypeCompact, 10, 2, 3, 4, 5, content, {});
+
+  BinlogItem item;
+  ASSERT_TRUE(PikaBinlogTransverter::BinlogDecode(TypeFirst, binlog, &item));
+  ASSERT_EQ(item.type(), TypeCompact);
+  ASSERT_EQ(item.exec_time(), 10);
+  ASSERT_EQ(item.term_id(), 2);
+  ASSERT_EQ(item.logic_id(), 3);
+  ASSERT_EQ(item.filenum(), 4);
+  ASSERT_EQ(item.offset(), 5);
+  std::vector<std::string> decoded;
+  ASSERT_TRUE(Decode(item.content(), &decoded));
+  ASSERT_EQ(decoded, argv);
+}
+
+TEST(CompactBinlogTest, RejectsNonBulkProtocol) {
+  const std::vector<std::string> inputs = {
+      "",
+      "*0\r\n",
+      "*1\r\n",
+      "+OK\r\n",
+      "set key value\r\n",
+      "*1\r\n:1\r\n",
+      "*1\r\n$3\r\nset",
+      "*1\r\n$3\r\nsetx\r\n",
+      "*1\r\n$4\r\nset\r\n",
+      "*1\r\n$-1\r\n",
+      "*1\r\n$3\r\nset\r\n$3\r\nkey\r\n",
+      "*2\r\n$3\r\nset\r\n",
+      "*x\r\n$3\r\nset\r\n",
+  };
+  for (const auto& input : inputs) {
+    std::string content;
+    ASSERT_FALSE(PikaBinlogTransverter::RedisProtocolToCompactContent(input, &content)) << input;
+  }
+}
+
+TEST(CompactBinlogTest, RejectsTruncatedContent) {
+  std::string content;
+  ASSERT_TRUE(PikaBinlogTransverter::RedisProtocolToCompactContent(ToRedisProtocol({"set", "key", "value"}), &content));
+  std::vector<std::string> argv;
+  for (size_t len = 0; len < content.size(); ++len) {
+    ASSERT_FALSE(Decode(content.substr(0, len), &argv)) << len;
+  }
+  ASSERT_TRUE(Decode(content, &argv));
+}
+
+TEST(CompactBinlogTest, RejectsCorruptContent) {
+  std::string content;
+  ASSERT_TRUE(PikaBinlogTransverter::RedisProtocolToCompactContent(ToRedisProtocol({"set", "key", "value"}), &content));
+  std::vector<std::string> argv;
+
+  // unknown version
+  std::string corrupt = content;
+  corrupt[0] = static_cast<char>(BINLOG_COMPACT_VERSION + 1);
+  ASSERT_FALSE(Decode(corrupt, &argv));
+
+  // no arguments
+  ASSERT_FALSE(Decode(std::string{static_cast<char>(BINLOG_COMPACT_VERSION), 0}, &argv));
+
+  // argc larger than the arguments there are
+  corrupt = content;
+  corrupt[1] = 4;
+  ASSERT_FALSE(Decode(corrupt, &argv));
+
+  // argument length running past the end
+  corrupt = content;
+  corrupt[2] = 100;
+  ASSERT_FALSE(Decode(corrupt, &argv));
+
+  // unterminated varint
+  ASSERT_FALSE(Decode(std::string{static_cast<char>(BINLOG_COMPACT_VERSION), static_cast<char>(0x80)}, &argv));
+
+  // trailing bytes
+  ASSERT_FALSE(Decode(content + "x", &argv));
+
+  // the redis protocol of the command is not compact content
+  ASSERT_FALSE(Decode(ToRedisProtocol({"set", "key", "value"}), &argv));
+}
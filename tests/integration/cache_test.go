@@ -365,3 +365,136 @@ var _ = Describe("Cache test", func() {
 		Expect(MultiMget.Val()).To(Equal([]interface{}{"BAR", nil, "FOO", nil}))
 	})
 })
+
+var _ = Describe("Cache zset range test", func() {
+	ctx := context.TODO()
+	var client *redis.Client
+
+	BeforeEach(func() {
+		client = redis.NewClient(PikaOption(SINGLEADDR))
+		Expect(client.FlushDB(ctx).Err()).NotTo(HaveOccurred())
+		time.Sleep(1 * time.Second)
+	})
+
+	AfterEach(func() {
+		Expect(client.Close()).NotTo(HaveOccurred())
+	})
+
+	It("should ZRange and ZRevRange the same from db and cache", func() {
+		Expect(client.ZAdd(ctx, "zrangekey", redis.Z{Score: 1, Member: "a"}, redis.Z{Score: 2.5, Member: "b"},
+			redis.Z{Score: -3, Member: "c"}).Err()).NotTo(HaveOccurred())
+		// the first reads load the key into the cache, the later ones are served from it
+		for i := 0; i < 3; i++ {
+			Expect(client.ZRange(ctx, "zrangekey", 0, -1).Val()).To(Equal([]string{"c", "a", "b"}))
+			Expect(client.ZRangeWithScores(ctx, "zrangekey", 1, 2).Val()).To(Equal([]redis.Z{
+				{Score: 1, Member: "a"}, {Score: 2.5, Member: "b"}}))
+			Expect(client.ZRevRange(ctx, "zrangekey", 0, 1).Val()).To(Equal([]string{"b", "a"}))
+			Expect(client.ZRevRangeWithScores(ctx, "zrangekey", -1, -1).Val()).To(Equal([]redis.Z{
+				{Score: -3, Member: "c"}}))
+			time.Sleep(500 * time.Millisecond)
+		}
+	})
+})
+
+var _ = Describe("Cache negative keys test", func() {
+	ctx := context.TODO()
+	var client *redis.Client
+
+	BeforeEach(func() {
+		client = redis.NewClient(PikaOption(SINGLEADDR))
+		Expect(client.FlushDB(ctx).Err()).NotTo(HaveOccurred())
+		Expect(client.ConfigSet(ctx, "cache-negative-ttl-ms", "5000").Err()).NotTo(HaveOccurred())
+		time.Sleep(1 * time.Second)
+	})
+
+	AfterEach(func() {
+		Expect(client.ConfigSet(ctx, "cache-negative-ttl-ms", "0").Err()).NotTo(HaveOccurred())
+		Expect(client.Close()).NotTo(HaveOccurred())
+	})
+
+	It("should see a key written after it was found missing", func() {
+		Expect(client.Get(ctx, "negkey").Err()).To(Equal(redis.Nil))
+		Expect(client.Exists(ctx, "negkey").Val()).To(Equal(int64(0)))
+		Expect(client.StrLen(ctx, "negkey").Val()).To(Equal(int64(0)))
+
+		Expect(client.Set(ctx, "negkey", "a", 0).Err()).NotTo(HaveOccurred())
+		Expect(client.Get(ctx, "negkey").Val()).To(Equal("a"))
+		Expect(client.Exists(ctx, "negkey").Val()).To(Equal(int64(1)))
+	})
+
+	It("should see collections written after they were found missing", func() {
+		Expect(client.HLen(ctx, "neghash").Val()).To(Equal(int64(0)))
+		Expect(client.SCard(ctx, "negset").Val()).To(Equal(int64(0)))
+		Expect(client.LLen(ctx, "neglist").Val()).To(Equal(int64(0)))
+		Expect(client.ZCard(ctx, "negzset").Val()).To(Equal(int64(0)))
+
+		Expect(client.HSet(ctx, "neghash", "f", "v").Err()).NotTo(HaveOccurred())
+		Expect(client.SAdd(ctx, "negset", "m").Err()).NotTo(HaveOccurred())
+		Expect(client.RPush(ctx, "neglist", "e").Err()).NotTo(HaveOccurred())
+		Expect(client.ZAdd(ctx, "negzset", redis.Z{Score: 1, Member: "m"}).Err()).NotTo(HaveOccurred())
+
+		Expect(client.HGetAll(ctx, "neghash").Val()).To(Equal(map[string]string{"f": "v"}))
+		Expect(client.SMembers(ctx, "negset").Val()).To(Equal([]string{"m"}))
+		Expect(client.LLen(ctx, "neglist").Val()).To(Equal(int64(1)))
+		Expect(client.ZCard(ctx, "negzset").Val()).To(Equal(int64(1)))
+	})
+
+	It("should see a key written through a transaction", func() {
+		Expect(client.Get(ctx, "negtxn").Err()).To(Equal(redis.Nil))
+		_, err := client.TxPipelined(ctx, func(pipe redis.Pipeliner) error {
+			pipe.Set(ctx, "negtxn", "b", 0)
+			return nil
+		})
+		Expect(err).NotTo(HaveOccurred())
+		Expect(client.Get(ctx, "negtxn").Val()).To(Equal("b"))
+	})
+})
+
+var _ = Describe("Cache counter write behind test", func() {
+	ctx := context.TODO()
+	var client *redis.Client
+
+	BeforeEach(func() {
+		client = redis.NewClient(PikaOption(SINGLEADDR))
+		Expect(client.FlushDB(ctx).Err()).NotTo(HaveOccurred())
+		Expect(client.ConfigSet(ctx, "cache-counter-write-behind-ms", "200").Err()).NotTo(HaveOccurred())
+		time.Sleep(1 * time.Second)
+	})
+
+	AfterEach(func() {
+		Expect(client.ConfigSet(ctx, "cache-counter-write-behind-ms", "0").Err()).NotTo(HaveOccurred())
+		Expect(client.Close()).NotTo(HaveOccurred())
+	})
+
+	It("should read the coalesced increments at once and after the flush", func() {
+		Expect(client.Set(ctx, "counter", "10", 0).Err()).NotTo(HaveOccurred())
+		Expect(client.Get(ctx, "counter").Val()).To(Equal("10"))
+		for i := 0; i < 5; i++ {
+			Expect(client.Incr(ctx, "counter").Err()).NotTo(HaveOccurred())
+		}
+		Expect(client.IncrBy(ctx, "counter", 10).Val()).To(Equal(int64(25)))
+		Expect(client.Get(ctx, "counter").Val()).To(Equal("25"))
+
+		time.Sleep(1 * time.Second)
+		Expect(client.Get(ctx, "counter").Val()).To(Equal("25"))
+		Expect(client.StrLen(ctx, "counter").Val()).To(Equal(int64(2)))
+	})
+
+	It("should flush the pending increments before another command", func() {
+		Expect(client.HSet(ctx, "hcounter", "f", "1").Err()).NotTo(HaveOccurred())
+		Expect(client.HGetAll(ctx, "hcounter").Val()).To(Equal(map[string]string{"f": "1"}))
+		for i := 0; i < 3; i++ {
+			Expect(client.HIncrBy(ctx, "hcounter", "f", 2).Err()).NotTo(HaveOccurred())
+		}
+		Expect(client.HGet(ctx, "hcounter", "f").Val()).To(Equal("7"))
+
+		Expect(client.Set(ctx, "counter", "1", 0).Err()).NotTo(HaveOccurred())
+		Expect(client.Get(ctx, "counter").Val()).To(Equal("1"))
+		Expect(client.Incr(ctx, "counter").Val()).To(Equal(int64(2)))
+		// a del right after must not be undone by the delayed write
+		Expect(client.Del(ctx, "counter").Val()).To(Equal(int64(1)))
+		time.Sleep(1 * time.Second)
+		Expect(client.Get(ctx, "counter").Err()).To(Equal(redis.Nil))
+		Expect(client.HGet(ctx, "hcounter", "f").Val()).To(Equal("7"))
+	})
+})
@@ -813,3 +813,94 @@ var _ = Describe("should replication ", func() {
 	})
 
 })
+
+var _ = Describe("should invalidate the slave cache", func() {
+	ctx := context.TODO()
+	var clientSlave *redis.Client
+	var clientMaster *redis.Client
+
+	BeforeEach(func() {
+		clientMaster = redis.NewClient(PikaOption(MASTERADDR))
+		clientSlave = redis.NewClient(PikaOption(SLAVEADDR))
+		cleanEnv(ctx, clientMaster, clientSlave)
+		if GlobalBefore != nil {
+			GlobalBefore(ctx, clientMaster)
+			GlobalBefore(ctx, clientSlave)
+		}
+		Expect(clientSlave.ConfigSet(ctx, "slave-cache-invalidate", "yes").Err()).NotTo(HaveOccurred())
+		time.Sleep(3 * time.Second)
+	})
+	AfterEach(func() {
+		Expect(clientSlave.ConfigSet(ctx, "slave-cache-invalidate", "no").Err()).NotTo(HaveOccurred())
+		cleanEnv(ctx, clientMaster, clientSlave)
+		Expect(clientSlave.Close()).NotTo(HaveOccurred())
+		Expect(clientMaster.Close()).NotTo(HaveOccurred())
+	})
+
+	It("should read the writes of the master on the slave", func() {
+		Expect(trySlave(ctx, clientSlave, LOCALHOST, MASTERPORT)).To(BeTrue())
+
+		Expect(clientMaster.Set(ctx, "invkey", "v1", 0).Err()).NotTo(HaveOccurred())
+		Expect(clientMaster.HSet(ctx, "invhash", "f", "v1").Err()).NotTo(HaveOccurred())
+		Eventually(func() string {
+			return clientSlave.Get(ctx, "invkey").Val()
+		}, "5s", "100ms").Should(Equal("v1"))
+		Eventually(func() map[string]string {
+			return clientSlave.HGetAll(ctx, "invhash").Val()
+		}, "5s", "100ms").Should(Equal(map[string]string{"f": "v1"}))
+
+		// the values cached on the slave by the reads above go stale
+		Expect(clientMaster.Set(ctx, "invkey", "v2", 0).Err()).NotTo(HaveOccurred())
+		Expect(clientMaster.HSet(ctx, "invhash", "g", "v2").Err()).NotTo(HaveOccurred())
+		Eventually(func() string {
+			return clientSlave.Get(ctx, "invkey").Val()
+		}, "5s", "100ms").Should(Equal("v2"))
+		Eventually(func() map[string]string {
+			return clientSlave.HGetAll(ctx, "invhash").Val()
+		}, "5s", "100ms").Should(Equal(map[string]string{"f": "v1", "g": "v2"}))
+
+		Expect(clientMaster.Del(ctx, "invkey", "invhash").Err()).NotTo(HaveOccurred())
+		Eventually(func() error {
+			return clientSlave.Get(ctx, "invkey").Err()
+		}, "5s", "100ms").Should(Equal(redis.Nil))
+		Eventually(func() int64 {
+			return clientSlave.Exists(ctx, "invhash").Val()
+		}, "5s", "100ms").Should(Equal(int64(0)))
+	})
+})
+
+var _ = Describe("should drop the negative cache of the slave", func() {
+	ctx := context.TODO()
+	var clientSlave *redis.Client
+	var clientMaster *redis.Client
+
+	BeforeEach(func() {
+		clientMaster = redis.NewClient(PikaOption(MASTERADDR))
+		clientSlave = redis.NewClient(PikaOption(SLAVEADDR))
+		cleanEnv(ctx, clientMaster, clientSlave)
+		if GlobalBefore != nil {
+			GlobalBefore(ctx, clientMaster)
+			GlobalBefore(ctx, clientSlave)
+		}
+		Expect(clientSlave.ConfigSet(ctx, "cache-negative-ttl-ms", "10000").Err()).NotTo(HaveOccurred())
+		time.Sleep(3 * time.Second)
+	})
+	AfterEach(func() {
+		Expect(clientSlave.ConfigSet(ctx, "cache-negative-ttl-ms", "0").Err()).NotTo(HaveOccurred())
+		cleanEnv(ctx, clientMaster, clientSlave)
+		Expect(clientSlave.Close()).NotTo(HaveOccurred())
+		Expect(clientMaster.Close()).NotTo(HaveOccurred())
+	})
+
+	It("should see a key the master wrote with a command which is not cached", func() {
+		Expect(trySlave(ctx, clientSlave, LOCALHOST, MASTERPORT)).To(BeTrue())
+
+		Expect(clientSlave.Exists(ctx, "negpf").Val()).To(Equal(int64(0)))
+		Expect(clientMaster.PFAdd(ctx, "negpf", "a", "b").Err()).NotTo(HaveOccurred())
+		// well within the ttl of the negative entry
+		Eventually(func() int64 {
+			return clientSlave.Exists(ctx, "negpf").Val()
+		}, "5s", "100ms").Should(Equal(int64(1)))
+		Expect(clientSlave.PFCount(ctx, "negpf").Val()).To(Equal(int64(2)))
+	})
+})
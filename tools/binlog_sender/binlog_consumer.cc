@@ -5,6 +5,9 @@
 
 #include "binlog_consumer.h"
 
+#include "pstd/include/pstd_coding.h"
+#include "pstd/include/pstd_crc32c.h"
+
 BinlogConsumer::BinlogConsumer(const std::string& binlog_path, uint32_t first_filenum, uint32_t last_filenum,
                                uint64_t offset)
     : filename_(binlog_path + kBinlogPrefix),
@@ -89,7 +92,7 @@ uint64_t BinlogConsumer::get_next(bool* is_error) {
     const uint32_t a = static_cast<uint32_t>(header[0]) & 0xff;
     const uint32_t b = static_cast<uint32_t>(header[1]) & 0xff;
     const uint32_t c = static_cast<uint32_t>(header[2]) & 0xff;
-    const unsigned int type = header[7];
+    const unsigned int type = static_cast<uint8_t>(header[7]) & ~kRecordChecksumFlag;
     const uint32_t length = a | (b << 8) | (c << 16);
 
     if (type == kFullType) {
@@ -133,7 +136,9 @@ uint32_t BinlogConsumer::ReadPhysicalRecord(pstd::Slice* result) {
   const uint32_t a = static_cast<uint32_t>(header[0]) & 0xff;
   const uint32_t b = static_cast<uint32_t>(header[1]) & 0xff;
   const uint32_t c = static_cast<uint32_t>(header[2]) & 0xff;
-  const unsigned int type = header[7];
+  const uint8_t type_byte = static_cast<uint8_t>(header[7]);
+  const unsigned int type = type_byte & ~kRecordChecksumFlag;
+  const uint32_t crc = pstd::DecodeFixed32(header + 3);
   const uint32_t length = a | (b << 8) | (c << 16);
   if (type == kZeroType || length == 0) {
     buffer_.clear();
@@ -143,6 +148,12 @@ uint32_t BinlogConsumer::ReadPhysicalRecord(pstd::Slice* result) {
   buffer_.clear();
   s = queue_->Read(length, &buffer_, backing_store_);
   *result = pstd::Slice(buffer_.data(), buffer_.size());
+  if (s.ok() && (type_byte & kRecordChecksumFlag) != 0) {
+    uint32_t actual = pstd::crc32c::Value(reinterpret_cast<const char*>(&type_byte), 1);
+    if (pstd::crc32c::Unmask(crc) != pstd::crc32c::Extend(actual, buffer_.data(), buffer_.size())) {
+      return kBadRecord;
+    }
+  }
   last_record_offset_ += kHeaderSize + length;
   if (s.ok()) {
     current_offset_ += (kHeaderSize + length);
@@ -29,6 +29,9 @@ enum RecordType {
  * Header is Type(1 byte), length (3 bytes), time (4 bytes)
  */
 static const size_t kHeaderSize = 1 + 3 + 4;
+// set in the type byte of a record whose time bytes hold the masked crc32c of
+// the type byte and the content
+static const uint8_t kRecordChecksumFlag = 0x80;
 static const size_t kBlockSize = 64 * 1024;
 static const std::string kBinlogPrefix = "write2file";
 
@@ -206,6 +206,11 @@ int main(int argc, char* argv[]) {
     if (s.ok()) {
       if (PikaBinlogTransverter::BinlogDecode(TypeFirst, scratch, &binlog_item)) {
         std::string redis_cmd = binlog_item.content();
+        if (binlog_item.type() == TypeCompact &&
+            !PikaBinlogTransverter::CompactContentToRedisProtocol(binlog_item.content(), &redis_cmd)) {
+          std::cout << "Binlog compact content decode error, exit..." << std::endl;
+          exit(-1);
+        }
         if (tv_start <= binlog_item.exec_time() && binlog_item.exec_time() <= tv_end) {
           pstd::Status net_s = cli->Send(&redis_cmd);
           if (net_s.ok()) {
@@ -5,6 +5,8 @@
 
 #include "binlog_transverter.h"
 
+#include "net/include/redis_cli.h"
+
 uint32_t BinlogItem::exec_time() const { return exec_time_; }
 
 uint32_t BinlogItem::server_id() const { return server_id_; }
@@ -15,6 +17,8 @@ uint32_t BinlogItem::filenum() const { return filenum_; }
 
 uint64_t BinlogItem::offset() const { return offset_; }
 
+BinlogType BinlogItem::type() const { return type_; }
+
 std::string BinlogItem::content() const { return content_; }
 
 void BinlogItem::set_exec_time(uint32_t exec_time) { exec_time_ = exec_time; }
@@ -69,9 +73,10 @@ bool PikaBinlogTransverter::BinlogDecode(BinlogType type, const std::string& bin
   uint32_t content_length = 0;
   std::string binlog_str = binlog;
   pstd::GetFixed16(&binlog_str, &binlog_type);
-  if (binlog_type != type) {
+  if ((type != TypeFirst && type != TypeCompact) || (binlog_type != TypeFirst && binlog_type != TypeCompact)) {
     return false;
   }
+  binlog_item->type_ = static_cast<BinlogType>(binlog_type);
   pstd::GetFixed32(&binlog_str, &binlog_item->exec_time_);
   pstd::GetFixed32(&binlog_str, &binlog_item->server_id_);
   pstd::GetFixed64(&binlog_str, &binlog_item->logic_id_);
@@ -86,3 +91,29 @@ bool PikaBinlogTransverter::BinlogDecode(BinlogType type, const std::string& bin
   binlog_str.erase(0, content_length);
   return true;
 }
+
+bool PikaBinlogTransverter::CompactContentToRedisProtocol(const std::string& content, std::string* redis_protocol) {
+  pstd::Slice input(content);
+  if (input.empty() || static_cast<uint8_t>(input[0]) != BINLOG_COMPACT_VERSION) {
+    return false;
+  }
+  input.remove_prefix(1);
+  uint32_t argc = 0;
+  if (!pstd::GetVarint32(&input, &argc) || argc == 0) {
+    return false;
+  }
+  net::RedisCmdArgsType argv;
+  for (uint32_t i = 0; i < argc; ++i) {
+    pstd::Slice arg;
+    if (!pstd::GetLengthPrefixedSlice(&input, &arg)) {
+      return false;
+    }
+    argv.emplace_back(arg.data(), arg.size());
+  }
+  if (!input.empty()) {
+    return false;
+  }
+  redis_protocol->clear();
+  net::SerializeRedisCommand(argv, redis_protocol);
+  return true;
+}
@@ -18,10 +18,19 @@
  * 4 Bytes     8 Bytes         4 Bytes      content length Bytes
  *
  */
+/*
+ * Type Compact Binlog Item has the same header as Type First, its content is
+ * | <Version> | <Argc> | <Arg Length> | <Arg> | ... argc times
+ *   1 Byte     varint32   varint32
+ */
 enum BinlogType {
   TypeFirst = 1,
+  TypeCompact = 2,
 };
 
+#define BINLOG_COMPACT_VERSION 1
+
+
 class BinlogItem {
  public:
   BinlogItem() : exec_time_(0), server_id_(0), logic_id_(0), filenum_(0), offset_(0), content_("") {}
@@ -33,6 +42,7 @@ class BinlogItem {
   uint64_t logic_id() const;
   uint32_t filenum() const;
   uint64_t offset() const;
+  BinlogType type() const;
   std::string content() const;
   std::string ToString() const;
 
@@ -48,6 +58,7 @@ class BinlogItem {
   uint64_t logic_id_;
   uint32_t filenum_;
   uint64_t offset_;
+  BinlogType type_ = TypeFirst;
   std::string content_;
   std::vector<std::string> extends_;
 };
@@ -59,7 +70,11 @@ class PikaBinlogTransverter {
                                   uint32_t filenum, uint64_t offset, const std::string& content,
                                   const std::vector<std::string>& extends);
 
+  // TypeFirst and TypeCompact items are accepted for one another
   static bool BinlogDecode(BinlogType type, const std::string& binlog, BinlogItem* binlog_item);
+
+  // the redis protocol of the command in the content of a TypeCompact item
+  static bool CompactContentToRedisProtocol(const std::string& content, std::string* redis_protocol);
 };
 
 #endif
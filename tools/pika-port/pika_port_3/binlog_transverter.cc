@@ -16,6 +16,8 @@ uint32_t PortBinlogItem::filenum() const { return filenum_; }
 
 uint64_t PortBinlogItem::offset() const { return offset_; }
 
+PortBinlogType PortBinlogItem::type() const { return type_; }
+
 const std::string& PortBinlogItem::content() const { return content_; }
 
 void PortBinlogItem::set_exec_time(uint32_t exec_time) { exec_time_ = exec_time; }
@@ -72,11 +74,13 @@ bool PortBinlogTransverter::PortBinlogDecode(PortBinlogType type, const std::str
   uint32_t content_length = 0;
   std::string binlog_str = binlog;
   pstd::GetFixed16(&binlog_str, &binlog_type);
-  if (binlog_type != type) {
+  if ((type != PortTypeFirst && type != PortTypeCompact) ||
+      (binlog_type != PortTypeFirst && binlog_type != PortTypeCompact)) {
     LOG(WARNING) << "PortBinlog Item type error, expect type: " << static_cast<uint16_t>(type)
                  << " actualy type: " << binlog_type;
     return false;
   }
+  binlog_item->type_ = static_cast<PortBinlogType>(binlog_type);
   pstd::GetFixed32(&binlog_str, &binlog_item->exec_time_);
   pstd::GetFixed32(&binlog_str, &binlog_item->server_id_);
   pstd::GetFixed64(&binlog_str, &binlog_item->logic_id_);
@@ -93,3 +97,26 @@ bool PortBinlogTransverter::PortBinlogDecode(PortBinlogType type, const std::str
   binlog_str.erase(0, content_length);
   return true;
 }
+
+bool PortBinlogTransverter::PortCompactContentDecode(const std::string& content, std::vector<std::string>* argv) {
+  pstd::Slice input(content);
+  if (input.empty() || static_cast<uint8_t>(input[0]) != PORT_BINLOG_COMPACT_VERSION) {
+    LOG(WARNING) << "PortBinlog compact content version error, actualy version: "
+                 << (input.empty() ? -1 : static_cast<int>(static_cast<uint8_t>(input[0])));
+    return false;
+  }
+  input.remove_prefix(1);
+  uint32_t argc = 0;
+  if (!pstd::GetVarint32(&input, &argc) || argc == 0) {
+    return false;
+  }
+  argv->clear();
+  for (uint32_t i = 0; i < argc; ++i) {
+    pstd::Slice arg;
+    if (!pstd::GetLengthPrefixedSlice(&input, &arg)) {
+      return false;
+    }
+    argv->emplace_back(arg.data(), arg.size());
+  }
+  return input.empty();
+}
@@ -19,10 +19,19 @@
  *
  */
 
+/*
+ * Type Compact PortBinlog Item has the same header as Type First, its content is
+ * | <Version> | <Argc> | <Arg Length> | <Arg> | ... argc times
+ *   1 Byte     varint32   varint32
+ */
+
 enum PortBinlogType {
   PortTypeFirst = 1,
+  PortTypeCompact = 2,
 };
 
+#define PORT_BINLOG_COMPACT_VERSION 1
+
 class PortBinlogItem {
  public:
   PortBinlogItem() : exec_time_(0), server_id_(0), logic_id_(0), filenum_(0), offset_(0), content_("") {}
@@ -34,6 +43,7 @@ class PortBinlogItem {
   uint64_t logic_id() const;
   uint32_t filenum() const;
   uint64_t offset() const;
+  PortBinlogType type() const;
   const std::string& content() const;
   std::string ToString() const;
 
@@ -49,6 +59,7 @@ class PortBinlogItem {
   uint64_t logic_id_;
   uint32_t filenum_;
   uint64_t offset_;
+  PortBinlogType type_ = PortTypeFirst;
   std::string content_;
   std::vector<std::string> extends_;
 };
@@ -60,7 +71,10 @@ class PortBinlogTransverter {
                                       uint32_t filenum, uint64_t offset, const std::string& content,
                                       const std::vector<std::string>& extends);
 
+  // PortTypeFirst and PortTypeCompact items are accepted for one another
   static bool PortBinlogDecode(PortBinlogType type, const std::string& binlog, PortBinlogItem* binlog_item);
+
+  static bool PortCompactContentDecode(const std::string& content, std::vector<std::string>* argv);
 };
 
 #endif
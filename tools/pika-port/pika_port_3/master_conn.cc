@@ -222,7 +222,12 @@ net::ReadStatus MasterConn::GetRequest() {
       LOG(INFO) << "Binlog decode error: " << item.ToString();
       return net::kParseError;
     }
-    if ((status = ParseRedisRESPArray(item.content(), &argv)) != net::kOk) {
+    if (item.type() == PortTypeCompact) {
+      if (!PortBinlogTransverter::PortCompactContentDecode(item.content(), &argv)) {
+        LOG(INFO) << "Type Binlog compact content decode error: " << item.ToString();
+        return net::kParseError;
+      }
+    } else if ((status = ParseRedisRESPArray(item.content(), &argv)) != net::kOk) {
       LOG(INFO) << "Type Binlog ParseRedisRESPArray error: " << item.ToString();
       return status;
     }
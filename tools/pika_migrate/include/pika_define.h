@@ -376,6 +376,12 @@ enum RecordType {
   kOldRecord = 7
 };
 
+/*
+ * Set in the type byte of a physical record whose time bytes hold the masked
+ * crc32c of the type byte and the content instead
+ */
+static const uint8_t kRecordChecksumFlag = 0x80;
+
 /*
  * the block size that we read and write from write2file
  * the default size is 64KB
@@ -112,7 +112,7 @@ bool PikaBinlogReader::GetNext(uint64_t* size) {
     const uint32_t a = static_cast<uint32_t>(header[0]) & 0xff;
     const uint32_t b = static_cast<uint32_t>(header[1]) & 0xff;
     const uint32_t c = static_cast<uint32_t>(header[2]) & 0xff;
-    const unsigned int type = header[7];
+    const unsigned int type = static_cast<uint8_t>(header[7]) & ~kRecordChecksumFlag;
     const uint32_t length = a | (b << 8) | (c << 16);
 
     if (type == kFullType) {
@@ -158,7 +158,8 @@ unsigned int PikaBinlogReader::ReadPhysicalRecord(slash::Slice *result, uint32_t
   const uint32_t a = static_cast<uint32_t>(header[0]) & 0xff;
   const uint32_t b = static_cast<uint32_t>(header[1]) & 0xff;
   const uint32_t c = static_cast<uint32_t>(header[2]) & 0xff;
-  const unsigned int type = header[7];
+  // the checksum is not verified, slash has no crc32c
+  const unsigned int type = static_cast<uint8_t>(header[7]) & ~kRecordChecksumFlag;
   const uint32_t length = a | (b << 8) | (c << 16);
   if (type == kZeroType || length == 0) {
     buffer_.clear();